@@ -0,0 +1,69 @@
+// Copyright (C) 2023-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+#include "openvino/genai/llm_pipeline.hpp"
+
+namespace {
+
+double milliseconds_since(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+}  // namespace
+
+// Measures the time to load LoRA adapters from safetensors files and, optionally,
+// the time to construct LLMPipeline with these adapters registered.
+int main(int argc, char* argv[]) try {
+    if (3 > argc)
+        throw std::runtime_error(std::string{"Usage: "} + argv[0] + " <NUM_ITERATIONS> <ADAPTER_SAFETENSORS_FILE>... [--model <MODEL_DIR>]");
+
+    size_t num_iterations = std::stoul(argv[1]);
+    std::vector<std::string> adapter_paths;
+    std::string model_path;
+    for (int i = 2; i < argc; ++i) {
+        if (std::string(argv[i]) == "--model" && i + 1 < argc) {
+            model_path = argv[++i];
+        } else {
+            adapter_paths.push_back(argv[i]);
+        }
+    }
+    std::string device = "CPU";
+
+    using namespace ov::genai;
+
+    double total_load_ms = 0;
+    for (size_t iteration = 0; iteration < num_iterations; ++iteration) {
+        auto start = std::chrono::steady_clock::now();
+        // Adapters are destroyed at the end of each iteration, so each iteration reads the files from scratch
+        std::vector<Adapter> loaded;
+        for (const auto& path : adapter_paths)
+            loaded.emplace_back(path);
+        total_load_ms += milliseconds_since(start);
+    }
+    std::cout << "Adapters load time: " << total_load_ms / num_iterations << " ms (mean over " << num_iterations << " iterations)\n";
+
+    if (model_path.empty())
+        return EXIT_SUCCESS;
+
+    AdapterConfig config;
+    for (const auto& path : adapter_paths)
+        config.add(Adapter(path));
+
+    double total_init_ms = 0;
+    for (size_t iteration = 0; iteration < num_iterations; ++iteration) {
+        auto start = std::chrono::steady_clock::now();
+        LLMPipeline pipe(model_path, device, adapters(config));
+        total_init_ms += milliseconds_since(start);
+    }
+    std::cout << "Pipeline init time with adapters: " << total_init_ms / num_iterations << " ms (mean over " << num_iterations << " iterations)\n";
+} catch (const std::exception& error) {
+    std::cerr << error.what() << '\n';
+    return EXIT_FAILURE;
+} catch (...) {
+    std::cerr << "Non-exception object thrown\n";
+    return EXIT_FAILURE;
+}
@@ -62,9 +62,9 @@ enum class StopCriteria { EARLY, HEURISTIC, NEVER };
  * @param top_k the number of highest probability vocabulary tokens to keep for top-k-filtering.
  * @param do_sample whether or not to use multinomial random sampling that add up to `top_p` or higher are kept.
  * @param repetition_penalty the parameter for repetition penalty. 1.0 means no penalty.
- * @param presence_penalty reduces absolute log prob if the token was generated at least once. Ignored for non continuous batching.
- * @param frequency_penalty reduces absolute log prob as many times as the token was generated. Ignored for non continuous batching.
- * @param rng_seed initializes random generator. Ignored for non continuous batching.
+ * @param presence_penalty reduces absolute log prob if the token was generated at least once. Ignored by LLMPipeline without continuous batching.
+ * @param frequency_penalty reduces absolute log prob as many times as the token was generated. Ignored by LLMPipeline without continuous batching.
+ * @param rng_seed initializes random generator. Ignored by LLMPipeline without continuous batching.
  */
 
 class OPENVINO_GENAI_EXPORTS GenerationConfig {
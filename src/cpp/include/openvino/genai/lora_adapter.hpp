@@ -7,6 +7,8 @@
 #include <variant>
 #include <string>
 #include <optional>
+#include <future>
+#include <vector>
 
 #include "openvino/op/constant.hpp"
 #include "openvino/runtime/compiled_model.hpp"
@@ -19,14 +21,19 @@ namespace ov {
 namespace genai {
 
 class OPENVINO_GENAI_EXPORTS AdapterController;
+class OPENVINO_GENAI_EXPORTS AdapterRegistry;
 struct AdapterControllerImpl;
+struct AdapterRegistryImpl;
 
 // Inmutable LoRA Adapter that carries the adaptation matrices and serves as unique adapter identifier
+// Each Adapter(path) call loads its own copy of the adapter, use AdapterRegistry to share one loaded adapter between users
 class OPENVINO_GENAI_EXPORTS Adapter {
     class Impl;
     std::shared_ptr<Impl> m_pimpl;
     friend AdapterController;
     friend AdapterControllerImpl;
+    friend AdapterRegistry;
+    friend AdapterRegistryImpl;
     friend bool operator== (const Adapter& a, const Adapter& b);
     friend bool operator< (const Adapter& a, const Adapter& b);
 public:
@@ -38,6 +45,37 @@ public:
     }
 };
 
+// Memory used by a single adapter loaded in the process
+struct AdapterMemoryInfo {
+    std::string path;           // absolute path to the adapter file
+    size_t num_tensors = 0;     // number of LoRA tensors recognized in the file
+    size_t mapped_bytes = 0;    // size of the LoRA tensors mapped from the file, pages are shared between all users of the file
+};
+
+
+// Opt-in process-wide registry of loaded adapters. An adapter obtained from the registry is loaded once per file and shared between
+// all Adapter objects and pipelines that get it from the registry while at least one of them is alive, so they compare equal.
+// Adapters created with Adapter(path) are not registered and stay independent from the registry.
+// Only the adapter tensors mapped from the file are shared. Each pipeline still compiles its own base model and keeps its own LoRA
+// state tensors, pipelines created from the same model share compilation results only through the CACHE_DIR property.
+class OPENVINO_GENAI_EXPORTS AdapterRegistry {
+public:
+    // Returns a shared adapter for a given file, loads it if it is not loaded yet
+    static Adapter get(const std::string& path);
+
+    // Queues loading of a shared adapter to a single background thread that loads adapters one by one and reads their tensors from
+    // the file, so pipelines configured with the result later don't wait for disk. Preloading of a file that is already queued
+    // returns the same future.
+    static std::shared_future<Adapter> preload(const std::string& path);
+
+    // Returns memory information for all adapters obtained from the registry that are alive in the process
+    static std::vector<AdapterMemoryInfo> get_memory_info();
+
+    // Returns memory information for a given adapter, registered or not
+    static AdapterMemoryInfo get_memory_info(const Adapter& adapter);
+};
+
+
 // bool OPENVINO_GENAI_EXPORTS operator== (const Adapter& a, const Adapter& b);
 // bool OPENVINO_GENAI_EXPORTS operator< (const Adapter& a, const Adapter& b);
 
@@ -48,7 +86,8 @@ struct OPENVINO_GENAI_EXPORTS AdapterConfig {
         MODE_DYNAMIC,       // A, B, alpha are fully variable
         MODE_STATIC_RANK,   // A and B have static shape, alpha is variable // FIXME: WA to unlock experiments, gives a unique perf level
         MODE_STATIC,        // A, B and alpha are constants
-        MODE_FUSE           // A, B and alpha are constants, fused to main matrix W
+        MODE_FUSE,          // A, B and alpha are constants, fused to main matrix W
+        MODE_MULTI          // A and B of all adapters are stacked in variables, alpha is selected per token to apply different adapters to different requests in one batch (ContinuousBatchingPipeline only)
     };
 
     Mode get_mode() const { return mode; }
@@ -176,6 +215,16 @@ public:
     // the next call of apply will set all adapter tensors regardless of config change, use this method if full state.reset is called for the controlled model
     void force_full_apply(bool full_apply = true);
 
+    // Start preparation of adapter tensors for a given config in background to overlap it with other work, the next call of apply with the same adapters will wait for it
+    void prepare(const AdapterConfig& config);
+
+    // MODE_MULTI only: returns alphas for all adapters registered in the controller in the order of registration,
+    // adapters that are not present in a given `config` get 0. Used to build per-token alphas for requests batched together.
+    std::vector<float> get_alphas(const AdapterConfig& config) const;
+
+    // MODE_MULTI only: returns the number of adapters registered in the controller, it is the size of vectors returned by get_alphas
+    size_t get_num_adapters() const;
+
     operator bool() const {
         return bool(m_pimpl);
     }
@@ -3,12 +3,36 @@
 
 #pragma once
 
+#include "openvino/genai/generation_handle.hpp"
 #include "openvino/genai/llm_pipeline.hpp"
 #include "openvino/genai/streamer_base.hpp"
 #include "openvino/genai/tokenizer.hpp"
 #include <filesystem>
 
 namespace ov::genai {
+/// @brief Usage statistics of the image embedding cache enabled by
+/// image_embedding_cache_size.
+struct ImageEmbeddingCacheStats {
+    /// @brief The number of images whose embeddings were found.
+    size_t hits = 0;
+    /// @brief The number of images that had to be encoded.
+    size_t misses = 0;
+    /// @brief The number of entries dropped to fit the budget.
+    size_t evictions = 0;
+    /// @brief The number of images currently stored.
+    size_t entries = 0;
+    /// @brief Byte size of tensors currently stored.
+    size_t bytes = 0;
+    /// @brief The memory budget.
+    size_t capacity_bytes = 0;
+
+    /// @brief hits / (hits + misses) or 0 if nothing was looked up.
+    float get_hit_rate() const {
+        size_t lookups = hits + misses;
+        return 0 == lookups ? 0.0f : float(hits) / lookups;
+    }
+};
+
 /// @brief A Visual language modeling pipeline class used to generate a
 /// response or run a chat given a prompt and an image.
 class OPENVINO_GENAI_EXPORTS VLMPipeline {
@@ -19,7 +43,11 @@ public:
     /// @param device Inference device. A tokenizer is always compiled
     /// for CPU.
     /// @param device_config A config to pass to ov::Core.set_property()
-    /// and ov::Core::compile_model().
+    /// and ov::Core::compile_model(). May also contain
+    /// image_embedding_cache_size, image_resize_in_model and
+    /// scheduler_config. scheduler_config enables continuous batching
+    /// mode: the language model is converted to paged attention and
+    /// requests are decoded together with add_request() and step().
     /// @param core ov::Core instance to use.
     explicit VLMPipeline(
         const std::filesystem::path& model_dir,
@@ -70,6 +98,28 @@ public:
             prompt, AnyMap{std::forward<Properties>(properties)...}
         );
     }
+    /// @brief Add a request to be decoded together with other requests
+    /// by step(). The prompt and images are embedded on a background
+    /// thread, so encoding overlaps decoding of running requests.
+    /// Requires scheduler_config in the constructor's device_config.
+    /// Chat mode isn't supported.
+    /// @param request_id A unique id of the request.
+    /// @param prompt A prompt to respond to.
+    /// @param rgbs Images to be prepended to a prompt. They are copied.
+    /// @param generation_config A config to follow for text generation.
+    /// @return A handle to read generated tokens as they are produced.
+    GenerationHandle add_request(
+        uint64_t request_id,
+        const std::string& prompt,
+        const std::vector<ov::Tensor>& rgbs,
+        const GenerationConfig& generation_config
+    );
+    /// @brief Run one decoding step for all requests added by
+    /// add_request() whose prompts are embedded.
+    void step();
+    /// @brief Check if any request added by add_request() is running
+    /// or still being embedded.
+    bool has_non_finished_requests();
     /// @brief Activate chat mode. Chat preserves previous history and
     /// applies chat_template to input prompts. Calling start_chat()
     /// again or finish_chat() drops the memorized history.
@@ -98,6 +148,13 @@ public:
     /// @brief Override default values for GenerationConfig
     /// @param new_config A config to override default values with.
     void set_generation_config(const GenerationConfig& new_config);
+    /// @brief Get hit and miss counters and memory usage of the image
+    /// embedding cache.
+    /// @return All zeros except counters if the cache is disabled.
+    ImageEmbeddingCacheStats get_image_embedding_cache_stats() const;
+    /// @brief Drop all cached image embeddings. Counters are
+    /// preserved.
+    void clear_image_embedding_cache();
 private:
     class VLMPipelineImpl;
     std::unique_ptr<VLMPipelineImpl> m_pimpl;
@@ -109,4 +166,19 @@ private:
 */
 static constexpr ov::Property<ov::Tensor> image{"image"};
 static constexpr ov::Property<std::vector<ov::Tensor>> images{"images"};
+
+/// @brief A memory budget in bytes for embeddings of previously seen
+/// images. Images are identified by a hash of their bytes and the
+/// preprocessing config, so an image sent again in a chat or by another
+/// caller skips vision encoding and resampling. Least recently used
+/// images are evicted first. Pass it to VLMPipeline's device_config.
+/// 0 (default) disables the cache.
+static constexpr ov::Property<size_t> image_embedding_cache_size{"image_embedding_cache_size"};
+
+/// @brief Resize images with an OpenVINO model compiled for the
+/// pipeline's device instead of the reference CPU implementation. The
+/// model applies Pillow's bicubic filter, so embeddings differ slightly
+/// from the ones computed with the default resize. Pass it to
+/// VLMPipeline's device_config. false by default.
+static constexpr ov::Property<bool> image_resize_in_model{"image_resize_in_model"};
 }
@@ -60,6 +60,10 @@ public:
     // Can be set for multilingual models only.
     std::optional<std::string> language = std::nullopt;
 
+    // If `true` and language is not set, the language detected by the first generate call of the pipeline is reused
+    // by the following calls, so language detection runs once per pipeline, e.g. for services with fixed language.
+    bool reuse_detected_language = false;
+
     // Language token to token_id map. Initialized from the generation_config.json lang_to_id dictionary.
     std::map<std::string, int64_t> lang_to_id;
 
@@ -77,6 +81,23 @@ public:
     // Note that a segment of text refers to a sequence of one or more words, rather than individual words.
     bool return_timestamps = false;
 
+    // If `true` in long-form mode the encoder for the next 30 seconds window is started asynchronously while
+    // the current window is decoded. The next window usually starts right after the current one; if timestamps
+    // predict a different offset the speculative result is discarded and the window is encoded again.
+    bool speculative_encoding = false;
+
+    // Number of tokens proposed by a draft decoder on each step of speculative decoding.
+    // Used only if the pipeline is created with a draft decoder.
+    size_t num_assistant_tokens = 5;
+
+    // If `true` silent parts of the input are detected by log-mel energy and removed before the encoder,
+    // so long recordings with pauses need less encoder and decoder windows. Segments timestamps refer to the
+    // original audio.
+    bool skip_silence = false;
+
+    // Frames which energy is lower than the loudest frame energy by more than this value (in dB) are silence.
+    float silence_threshold_db = 35.0f;
+
     // A list containing tokens that will be supressed at the beginning of the sampling process.
     std::vector<int64_t> begin_suppress_tokens;
 
@@ -118,7 +139,12 @@ static constexpr ov::Property<int64_t> begin_timestamps_token_id{"begin_timestam
 static constexpr ov::Property<std::string> language{"language"};
 static constexpr ov::Property<std::string> task{"task"};
 static constexpr ov::Property<bool> return_timestamps{"return_timestamps"};
+static constexpr ov::Property<bool> speculative_encoding{"speculative_encoding"};
+static constexpr ov::Property<size_t> num_assistant_tokens{"num_assistant_tokens"};
+static constexpr ov::Property<bool> skip_silence{"skip_silence"};
+static constexpr ov::Property<float> silence_threshold_db{"silence_threshold_db"};
 static constexpr ov::Property<std::map<std::string, int64_t>> lang_to_id{"lang_to_id"};
+static constexpr ov::Property<bool> reuse_detected_language{"reuse_detected_language"};
 
 }  // namespace genai
 }  // namespace ov
@@ -8,6 +8,7 @@
 #include <variant>
 
 #include "openvino/core/any.hpp"
+#include "openvino/genai/generation_handle.hpp"
 #include "openvino/genai/llm_pipeline.hpp"
 #include "openvino/genai/whisper_generation_config.hpp"
 
@@ -32,6 +33,34 @@ struct WhisperDecodedResults : public DecodedResults {
     std::optional<std::vector<WhisperDecodedResultChunk>> chunks = std::nullopt;
 };
 
+/**
+ * @brief Parameters of streaming transcription that control the latency/accuracy trade-off.
+ */
+struct WhisperStreamingConfig {
+    // amount of new audio accumulated before the buffered audio is transcribed again,
+    // smaller values decrease latency and increase compute
+    float min_chunk_seconds = 1.0f;
+
+    // buffered audio is trimmed at the end of the last committed segment when it gets longer than this value,
+    // larger values give more context to the model
+    float buffer_trimming_seconds = 15.0f;
+};
+
+struct WhisperStreamingResult {
+    // text committed since the previous call, it is final and is not changed by later audio
+    std::string committed_text;
+
+    // current hypothesis for the rest of buffered audio, it may change with later audio
+    std::string partial_text;
+};
+
+/**
+ * @brief Path to a directory with openvino_decoder_model.xml and openvino_decoder_with_past_model.xml of a draft
+ * decoder (e.g. distil-whisper) that shares the encoder with the main model. If passed in plugin_config of
+ * WhisperPipeline, decoding uses speculative decoding with the draft decoder proposing num_assistant_tokens tokens.
+ */
+static constexpr ov::Property<std::string> draft_decoder_path{"draft_decoder_path"};
+
 class OPENVINO_GENAI_EXPORTS WhisperPipeline {
     class Impl;
     std::unique_ptr<Impl> m_impl;
@@ -94,6 +123,68 @@ public:
     }
     WhisperDecodedResults generate(const RawSpeechInput& raw_speech_input, const ov::AnyMap& config_map);
 
+    /**
+     * @brief Batched generate that transcribes several raw speech inputs together. Windows of all inputs are encoded
+     * and decoded in one batch, inputs that are finished earlier leave the batch. If at least one input is longer
+     * than 30 seconds, timestamps are predicted for all inputs. In continuous batching mode inputs up to 30 seconds
+     * are decoded by the continuous batching engine and longer inputs are decoded one by one by the regular pipeline.
+     *
+     * @param raw_speech_inputs raw speech inputs. Required to be normalized to near [-1, 1] range and have 16k Hz
+     * sampling rate.
+     * @param generation_config optional GenerationConfig
+     * @return std::vector<WhisperDecodedResults> decoded resulting text transcription for each input
+     */
+    std::vector<WhisperDecodedResults> generate(const std::vector<RawSpeechInput>& raw_speech_inputs,
+                                                OptionalWhisperGenerationConfig generation_config = std::nullopt);
+
+    /**
+     * @brief Adds a request to the continuous batching engine, the input is encoded immediately and its decoding
+     * is scheduled together with other requests by step(). Requires ov::genai::scheduler_config in plugin_config of
+     * the constructor. Inputs longer than 30 seconds are not supported.
+     *
+     * @param request_id unique id of the request
+     * @param raw_speech_input raw speech input. Required to be normalized to near [-1, 1] range and have 16k Hz
+     * sampling rate.
+     * @param generation_config optional GenerationConfig
+     * @return GenerationHandle to read generated tokens as they are produced
+     */
+    GenerationHandle add_request(uint64_t request_id,
+                                 const RawSpeechInput& raw_speech_input,
+                                 OptionalWhisperGenerationConfig generation_config = std::nullopt);
+
+    /**
+     * @brief Runs one decoding step for all requests added by add_request().
+     */
+    void step();
+
+    bool has_non_finished_requests();
+
+    /**
+     * @brief Starts streaming transcription session. Audio is passed with put_audio() as it arrives,
+     * text is committed when consecutive transcriptions of buffered audio agree on it.
+     *
+     * @param generation_config optional GenerationConfig
+     * @param streaming_config latency/accuracy parameters of the session
+     */
+    void start_streaming(OptionalWhisperGenerationConfig generation_config = std::nullopt,
+                         const WhisperStreamingConfig& streaming_config = {});
+
+    /**
+     * @brief Appends audio chunk to the streaming session.
+     *
+     * @param audio_chunk raw speech chunk. Required to be normalized to near [-1, 1] range and have 16k Hz
+     * sampling rate.
+     * @return WhisperStreamingResult newly committed text and current partial text
+     */
+    WhisperStreamingResult put_audio(const RawSpeechInput& audio_chunk);
+
+    /**
+     * @brief Transcribes the rest of buffered audio and finishes streaming session.
+     *
+     * @return WhisperStreamingResult with all not yet committed text
+     */
+    WhisperStreamingResult finish_streaming();
+
     ov::genai::Tokenizer get_tokenizer();
     WhisperGenerationConfig get_generation_config() const;
     void set_generation_config(const WhisperGenerationConfig& config);
@@ -4,6 +4,7 @@
 #include "text_callback_streamer.hpp"
 #include "continuous_batching_impl.hpp"
 #include "paged_attention_transformations.hpp"
+#include "lora_helper.hpp"
 #include "utils.hpp"
 
 namespace ov::genai {
@@ -22,6 +23,13 @@ ContinuousBatchingPipeline::ContinuousBatchingImpl::ContinuousBatchingImpl(
     auto [core_plugin_config, compile_plugin_config] = ov::genai::utils::split_core_complile_config(plugin_config);
     core.set_property(core_plugin_config);
 
+    AdapterConfig adapters;
+    bool use_adapters = false;
+    if (auto filtered_plugin_config = extract_adapters_from_properties(compile_plugin_config, &adapters)) {
+        compile_plugin_config = *filtered_plugin_config;
+        use_adapters = bool(adapters);
+    }
+
     // The model can be compiled for GPU as well
     std::shared_ptr<ov::Model> model = core.read_model(models_path + "/openvino_model.xml");
 
@@ -30,8 +38,22 @@ ContinuousBatchingPipeline::ContinuousBatchingImpl::ContinuousBatchingImpl(
     bool is_need_per_layer_cache_control = scheduler_config.use_cache_eviction;
     apply_paged_attention_transformations(model, device_config, is_need_per_layer_cache_control);
 
+    if (use_adapters) {
+        // All adapters are stacked in the model state, each request selects its own adapters and alphas via GenerationConfig::adapters
+        OPENVINO_ASSERT(adapters.get_mode() == AdapterConfig::MODE_AUTO || adapters.get_mode() == AdapterConfig::MODE_MULTI,
+            "ContinuousBatchingPipeline supports only AdapterConfig::MODE_AUTO and AdapterConfig::MODE_MULTI for adapters");
+        adapters.set_mode(AdapterConfig::MODE_MULTI);
+        // paged attention model has tokens enumerated in the first dimension of activations as required for per-token alphas
+        m_adapter_controller = AdapterController(model, adapters, "base_model.model.model.", device);   // TODO: Make the prefix name configurable
+        m_generation_config.adapters = adapters;
+    }
+
     ov::InferRequest infer_request = core.compile_model(model, device_config.get_device(), compile_plugin_config).create_infer_request();
 
+    if (m_adapter_controller) {
+        m_adapter_controller->apply(infer_request);
+    }
+
     // setup KV caches
     m_cache_manager = std::make_shared<CacheManager>(device_config, core);
     for (size_t decoder_layer_id = 0; decoder_layer_id < device_config.get_num_layers(); ++decoder_layer_id) {
@@ -60,6 +82,9 @@ ContinuousBatchingPipeline::ContinuousBatchingImpl::ContinuousBatchingImpl(
     } else {
         m_model_runner = std::make_shared<ModelRunner>(infer_request, updated_config, device_config.get_num_layers());
     }
+    if (m_adapter_controller) {
+        m_model_runner->set_adapter_controller(*m_adapter_controller);
+    }
     m_sampler = std::make_shared<Sampler>(m_tokenizer);
     m_sampler->set_seed(m_generation_config.rng_seed);
 
@@ -14,6 +14,7 @@ protected:
     std::shared_ptr<CacheManager> m_cache_manager;
     std::shared_ptr<ModelRunner> m_model_runner;
     std::shared_ptr<Sampler> m_sampler;
+    std::optional<AdapterController> m_adapter_controller;
 
     // current requests to process
     std::vector<SequenceGroup::Ptr> m_requests;
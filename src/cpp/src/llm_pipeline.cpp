@@ -113,6 +113,11 @@ public:
         GenerationConfig config = (generation_config.has_value()) ? *generation_config : m_generation_config;
         TokenizedInputs encoded_input;
 
+        if (m_adapter_controller) {
+            // overlap preparation of adapter tensors with tokenization, apply in the encoded generate waits for it
+            m_adapter_controller->prepare(config.adapters);
+        }
+
         if (auto input_vector = std::get_if<std::vector<std::string>>(&inputs)) {
             OPENVINO_ASSERT(!is_chat_conversation, "Can't chat with multiple prompts");
             encoded_input = m_tokenizer.encode(*input_vector);
@@ -588,12 +593,18 @@ void ov::genai::LLMPipeline::finish_chat() {
 
 void ov::genai::LLMPipeline::set_generation_config(const GenerationConfig& config) {
     int64_t default_eos_token_id = m_pimpl->m_generation_config.eos_token_id;
+    bool adapters_changed = config.adapters.get_adapters() != m_pimpl->m_generation_config.adapters.get_adapters();
     m_pimpl->m_generation_config = config;
     // if eos_token_id was not provided in config forward from default config
     if (config.eos_token_id == -1)
         m_pimpl->m_generation_config.eos_token_id = default_eos_token_id;
 
     m_pimpl->m_generation_config.validate();
+
+    if (adapters_changed && m_pimpl->m_adapter_controller) {
+        // adapter tensors for the next generate are prepared in background until it is called
+        m_pimpl->m_adapter_controller->prepare(m_pimpl->m_generation_config.adapters);
+    }
 }
 
 ov::genai::LLMPipeline::~LLMPipeline() = default;
@@ -314,7 +314,10 @@ public:
     LogitProcessor(const ov::genai::GenerationConfig& sampling_params,
                    const LogitTransformers::TokenIds& input_ids) {
         for (const auto& input_id : input_ids) {
-            m_unique_prompt_token_ids->insert(input_id);
+            // Negative ids mark prompt rows which aren't tokens, see SequenceGroup::set_prompt_embeds().
+            if (input_id >= 0) {
+                m_unique_prompt_token_ids->insert(input_id);
+            }
         }
 
         if (sampling_params.min_new_tokens > 0) {
@@ -2,15 +2,36 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <deque>
+#include <filesystem>
+#include <future>
+#include <list>
+#include <mutex>
+#include <numeric>
 #include <set>
 #include <map>
 #include <string>
+#include <thread>
 #include <vector>
-#include <fstream>
 #include <regex>
 #include <optional>
 
+#ifdef _WIN32
+#    ifndef NOMINMAX
+#        define NOMINMAX
+#    endif
+#    include <windows.h>
+#else
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#endif
+
 #include "openvino/op/add.hpp"
+#include "openvino/op/subtract.hpp"
 #include "openvino/op/multiply.hpp"
 #include "openvino/op/matmul.hpp"
 #include "openvino/op/convert.hpp"
@@ -22,14 +43,20 @@
 #include "openvino/op/read_value.hpp"
 #include "openvino/op/assign.hpp"
 #include "openvino/op/transpose.hpp"
+#include "openvino/op/gather.hpp"
+#include "openvino/op/non_zero.hpp"
+#include "openvino/op/reduce_max.hpp"
 #include "openvino/op/util/variable.hpp"
 #include "openvino/pass/pattern/matcher.hpp"
 #include "openvino/pass/pattern/op/wrap_type.hpp"
 #include "openvino/pass/graph_rewrite.hpp"
 #include "openvino/pass/manager.hpp"
 #include "openvino/runtime/core.hpp"
+#include "openvino/core/parallel.hpp"
+#include "openvino/core/rt_info.hpp"
 
 #include "openvino/genai/lora_adapter.hpp"
+#include "lora_helper.hpp"
 
 extern "C" {
     #include "safetensors.h"
@@ -58,9 +85,6 @@ using NodePtr = std::shared_ptr<ov::Node>;
 using ov::NodeVector;
 using namespace ov::op;
 
-// FIXME: Use ov::AlignedBuffer instead of std::vector. ov::AlignedBuffer is not available in public OV API
-using Buffer = std::vector<char>;
-using BufferPtr = std::shared_ptr<Buffer>;
 using ConstantVector = std::vector<std::shared_ptr<v0::Constant>>;
 
 
@@ -83,21 +107,108 @@ using LoRAPartsParser = LoRAParts<std::function<std::optional<std::string>(const
 using LoRATensors = std::map<std::string, LoRAWeight>;
 
 
-// Read binary file to memory.
+// Read-only memory mapping of a whole file.
+// The mapping is released when the object is destroyed, so the lifetime of the mapped memory is controlled by
+// the shared pointers to this object that are held by the Constants created on top of it.
+// Pages are loaded lazily by OS on first access and are shared in the page cache between all mappings of the same file,
+// so the same adapter file used by multiple pipelines in the process or by multiple processes doesn't consume extra memory.
+class MappedFile {
+public:
+    explicit MappedFile(const std::string& filename) {
+#ifdef _WIN32
+        m_file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        OPENVINO_ASSERT(m_file != INVALID_HANDLE_VALUE, "Cannot open file with LoRA weights: ", filename);
+        // the destructor isn't called if the constructor throws, release already opened handles explicitly
+        try {
+            LARGE_INTEGER filesize;
+            OPENVINO_ASSERT(GetFileSizeEx(m_file, &filesize), "Cannot get size of file with LoRA weights: ", filename);
+            m_size = static_cast<size_t>(filesize.QuadPart);
+            if(m_size > 0) {
+                m_mapping = CreateFileMappingA(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+                OPENVINO_ASSERT(m_mapping != nullptr, "Cannot create mapping for file with LoRA weights: ", filename);
+                m_data = static_cast<char*>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+                OPENVINO_ASSERT(m_data != nullptr, "Cannot map file with LoRA weights: ", filename);
+            }
+        } catch(...) {
+            release();
+            throw;
+        }
+#else
+        int fd = open(filename.c_str(), O_RDONLY);
+        OPENVINO_ASSERT(fd != -1, "Cannot open file with LoRA weights: ", filename);
+        struct stat file_stat;
+        if(fstat(fd, &file_stat) != 0) {
+            close(fd);
+            OPENVINO_THROW("Cannot get size of file with LoRA weights: ", filename);
+        }
+        m_size = static_cast<size_t>(file_stat.st_size);
+        if(m_size > 0) {
+            void* data = mmap(nullptr, m_size, PROT_READ, MAP_SHARED, fd, 0);
+            // the mapping stays valid after the descriptor is closed
+            close(fd);
+            OPENVINO_ASSERT(data != MAP_FAILED, "Cannot map file with LoRA weights: ", filename);
+            m_data = static_cast<char*>(data);
+        } else {
+            close(fd);
+        }
+#endif
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    ~MappedFile() {
+        release();
+    }
+
+    // FIXME: returns a non-constant pointer because safetensors parser and ov::Tensor don't accept a constant one,
+    // the memory is mapped as read-only and must not be modified
+    char* data() const {
+        return m_data;
+    }
+
+    size_t size() const {
+        return m_size;
+    }
+
+private:
+    void release() {
+#ifdef _WIN32
+        if(m_data) {
+            UnmapViewOfFile(m_data);
+            m_data = nullptr;
+        }
+        if(m_mapping) {
+            CloseHandle(m_mapping);
+            m_mapping = nullptr;
+        }
+        if(m_file != INVALID_HANDLE_VALUE) {
+            CloseHandle(m_file);
+            m_file = INVALID_HANDLE_VALUE;
+        }
+#else
+        if(m_data) {
+            munmap(m_data, m_size);
+            m_data = nullptr;
+        }
+#endif
+    }
+
+    char* m_data = nullptr;
+    size_t m_size = 0;
+#ifdef _WIN32
+    HANDLE m_file = INVALID_HANDLE_VALUE;
+    HANDLE m_mapping = nullptr;
+#endif
+};
+
+using Buffer = MappedFile;
+using BufferPtr = std::shared_ptr<Buffer>;
+
+
+// Map binary file to memory.
 BufferPtr read_file_helper(const std::string& filename) {
-    std::ifstream file(filename, std::ios::binary | std::ios::ate);
-    OPENVINO_ASSERT(file.is_open(), "Cannot open file with LoRA weights: ", filename);
-
-    size_t filesize = file.tellg();
-    auto buffer = std::make_shared<Buffer>(filesize);
-    file.seekg(0, std::ios::beg);
-    // TODO: Use mmapped AlignedBuffer as ov::Core::read_model can do, necessary functionality is not available in public OV API.
-    // LoRA files do not usuall have huge size in comparison to the base models, but it can vary depending on adapter,
-    // and using mmap will help to optimize memory consumption and could be critical
-    // when the application at the edge of available memory that is not really uncommon for applications dealing with LLMs.
-    file.read(&(*buffer)[0], filesize);
-
-    return buffer;
+    return std::make_shared<Buffer>(filename);
 }
 
 
@@ -130,25 +241,26 @@ struct AutoSafetensor: public safetensors_File {
 
 
 // Reads a file with a given filename expecting Safetensors file format.
-// The data is read to a solid memory block and the function returns a map of OV Constants allocated on top of that block.
+// The file is mapped to a solid memory block and the function returns a map of OV Constants allocated on top of that block.
 // The key in the map is a tensor name and the Constant uses a region of memory from the memory block.
 // Each Constant holds a shared pointer to the block in the runtime info.
-// The memory block will be deallocated when the last Constant is destroyed.
+// The memory block will be unmapped when the last Constant is destroyed.
 ConstantMap read_safetensors(const std::string& filename) {
     auto buffer = read_file_helper(filename);
     AutoSafetensor safe_tensors_file{};
 
     OPENVINO_ASSERT(
-        safetensors_file_init(&(*buffer)[0], buffer->size(), &safe_tensors_file) == nullptr,
+        safetensors_file_init(buffer->data(), buffer->size(), &safe_tensors_file) == nullptr,
         "Cannot parse ", filename, " as a Safetensors file format. Safetensors file format is supported only"
     );
 
-    ConstantMap tensors;
-    for (int i = 0; i < safe_tensors_file.num_tensors; i++) {
+    // Constants are created in parallel as they are independent, then they are collected to the map
+    std::vector<std::pair<std::string, std::shared_ptr<v0::Constant>>> named_constants(safe_tensors_file.num_tensors);
+    ov::parallel_for(named_constants.size(), [&](size_t i) {
         safetensors_TensorDescriptor tensor = safe_tensors_file.tensors[i];
         std::string name(tensor.name.ptr, tensor.name.ptr + tensor.name.len);
         ov::Shape shape(tensor.shape, tensor.shape + tensor.n_dimensions);
-        void* ptr = tensor.ptr;     // FIXME: needs a non-constant pointer because Tensor doesn't accept a constant pointer
+        void* ptr = tensor.ptr;     // FIXME: needs a non-constant pointer because Tensor doesn't accept a constant pointer, the memory is read-only
 
         OPENVINO_ASSERT(
             ov::shape_size(shape) <= tensor.end_offset_bytes - tensor.begin_offset_bytes,
@@ -158,8 +270,13 @@ ConstantMap read_safetensors(const std::string& filename) {
         auto type = safetensors_to_ov_element_type(tensor.dtype);
         auto constant =
             std::make_shared<v0::Constant>(type, shape, ptr, nullptr);      // wraps existing memory, no ownership
-        constant->get_rt_info()["__safetensors_buffer_holder"] = buffer;    // to automatically deallocate underlying memory buffer when last constant that holds it is destoyed
-        tensors[name] = constant;
+        constant->get_rt_info()["__safetensors_buffer_holder"] = buffer;    // to automatically unmap underlying memory buffer when last constant that holds it is destoyed
+        named_constants[i] = {std::move(name), constant};
+    });
+
+    ConstantMap tensors;
+    for(auto& named_constant : named_constants) {
+        tensors[std::move(named_constant.first)] = std::move(named_constant.second);
     }
     return tensors;
 }
@@ -167,6 +284,7 @@ ConstantMap read_safetensors(const std::string& filename) {
 
 // Holds a compiled regex pattern and an index to a particular capture group
 // operator() takes a string, parses it with that regex pattern and returns the capture group value
+// Can be used for custom patterns, SuffixParser should be preferred when a pattern is just a fixed suffix because it is much faster
 struct RegexParser {
     std::regex pattern;
     size_t capture_index;
@@ -181,28 +299,69 @@ struct RegexParser {
 };
 
 
+// Holds a list of alternative suffixes
+// operator() takes a string and returns it without the suffix if it ends with one of the suffixes,
+// it is equivalent to RegexParser with pattern `(.*)(suffix1|suffix2|...)` and capture index 1
+struct SuffixParser {
+    std::vector<std::string> suffixes;
+    SuffixParser (std::initializer_list<std::string> suffixes) : suffixes(suffixes) {}
+    std::optional<std::string> operator() (const std::string& name) const {
+        for(const auto& suffix : suffixes) {
+            if(name.size() >= suffix.size() && name.compare(name.size() - suffix.size(), suffix.size(), suffix) == 0) {
+                return name.substr(0, name.size() - suffix.size());
+            }
+        }
+        return std::nullopt;
+    }
+};
+
+
 // Default LoRA tensor name patterns observed in the existing LoRA adapters, captures the prefix that should correspond to a layer name in the base model
 LoRAPartsParser default_lora_patterns () {
     return LoRAPartsParser(
-        RegexParser(R"((.*)\.alpha)", 1),
-        RegexParser(R"((.*)\.(lora_(A|down)\.weight))", 1),
-        RegexParser(R"((.*)\.(lora_(B|up)\.weight))", 1)
+        SuffixParser{".alpha"},
+        SuffixParser{".lora_A.weight", ".lora_down.weight"},
+        SuffixParser{".lora_B.weight", ".lora_up.weight"}
     );
 }
 
 
 // Group tensors loaded from LoRA adapter file into triads A, B and alpha grouped by layer names.
 LoRATensors group_lora_tensors(const ConstantMap& tensors, const LoRAPartsParser& parts_parser) {
-    LoRATensors result;
+    // Names are parsed in parallel, then parsed tensors are grouped sequentially in the original order
+    enum class Part { NONE, ALPHA, A, B };
+    std::vector<const ConstantMap::value_type*> named_tensors;
+    named_tensors.reserve(tensors.size());
     for(const auto& named_tensor: tensors) {
-        if(auto parsed = parts_parser.A(named_tensor.first)) {
-            result[*parsed].A = named_tensor.second;
-        } else if(auto parsed = parts_parser.B(named_tensor.first)) {
-            result[*parsed].B = named_tensor.second;
-        } else if(auto parsed = parts_parser.alpha(named_tensor.first)) {
-            result[*parsed].alpha = named_tensor.second;
-        } else {
-            DEBUG_PRINT("Ignored LoRA tensor \"" << named_tensor.first << "\" because couldn't recognize expected name pattern." );
+        named_tensors.push_back(&named_tensor);
+    }
+    std::vector<std::pair<Part, std::string>> parsed_names(named_tensors.size(), {Part::NONE, ""});
+    ov::parallel_for(named_tensors.size(), [&](size_t i) {
+        const auto& name = named_tensors[i]->first;
+        if(auto parsed = parts_parser.A(name)) {
+            parsed_names[i] = {Part::A, *parsed};
+        } else if(auto parsed = parts_parser.B(name)) {
+            parsed_names[i] = {Part::B, *parsed};
+        } else if(auto parsed = parts_parser.alpha(name)) {
+            parsed_names[i] = {Part::ALPHA, *parsed};
+        }
+    });
+
+    LoRATensors result;
+    for(size_t i = 0; i < named_tensors.size(); ++i) {
+        const auto& constant = named_tensors[i]->second;
+        switch(parsed_names[i].first) {
+            case Part::A:
+                result[parsed_names[i].second].A = constant;
+                break;
+            case Part::B:
+                result[parsed_names[i].second].B = constant;
+                break;
+            case Part::ALPHA:
+                result[parsed_names[i].second].alpha = constant;
+                break;
+            default:
+                DEBUG_PRINT("Ignored LoRA tensor \"" << named_tensors[i]->first << "\" because couldn't recognize expected name pattern." );
         }
     }
 
@@ -244,7 +403,6 @@ struct LoRAParameters {
     ov::Dimension rank;         // accumulated LoRA rank, could be dynamic if rank is not known or DYNAMIC mode is applied
     ov::element::Type type;     // element type of a tensor that will be applied to the model, negotiated based on multple LoRA adapters
     bool fine_grained_alpha;    // use 1D tensor of the same rank for alpha instead of a scalar to blend multiple weighted LoRAs
-    // TODO: flag to have various alphas over the batch
 };
 
 using LoRAParametersGetter = std::function<std::optional<LoRAParameters>(NodePtr node)>;
@@ -254,31 +412,35 @@ using LoRAParametersGetter = std::function<std::optional<LoRAParameters>(NodePtr
 // It works for a single LoRA adapter.
 // Returns std::nullopt, if there is no LoRA adapter for a given layer name.
 struct LoRAWeightGetterDefault {
-    // TODO: Add filtering by tensor name prefix
-    const LoRATensors* lora_tensors;
+    // LoRA tensors with names that start with the prefix, paired with the names without the prefix, in the original order
+    using PrefixedTensors = std::vector<std::pair<std::string, const LoRATensors::value_type*>>;
+    std::shared_ptr<const PrefixedTensors> lora_tensors;
     const std::string prefix;
     mutable std::set<std::string> used_tensors;
 
-    LoRAWeightGetterDefault (const LoRATensors* lora_tensors, const std::string& prefix) : lora_tensors(lora_tensors), prefix(prefix) {}
+    LoRAWeightGetterDefault (const LoRATensors* all_lora_tensors, const std::string& prefix) : prefix(prefix) {
+        // Filter tensors by the prefix once instead of doing it for each requested name
+        auto filtered = std::make_shared<PrefixedTensors>();
+        for(const auto& named_tensor : *all_lora_tensors) {
+            if(named_tensor.first.compare(0, prefix.length(), prefix) == 0) {
+                filtered->emplace_back(named_tensor.first.substr(prefix.length()), &named_tensor);
+            }
+        }
+        lora_tensors = filtered;
+    }
 
     std::optional<LoRANode> operator() (const std::string& name) const {
         std::string name_with_underscores = name;
         // TODO: Investigate what is the root cause for this replacement in the name. Customize mapping or change PT FE to produce correct weight names.
         std::replace(name_with_underscores.begin(), name_with_underscores.end(), '.', '_');
-        auto it = std::find_if(lora_tensors->begin(), lora_tensors->end(), [this, name, name_with_underscores](const LoRATensors::value_type& pair){
-            std::string lora_name = pair.first;
-            // TODO: Make this filtering for prefix once in ctor as a more efficient solution
-            if(lora_name.find(prefix) == 0) {
-                lora_name = lora_name.substr(prefix.length());
-            } else {
-                return false;
-            }
+        auto it = std::find_if(lora_tensors->begin(), lora_tensors->end(), [&name, &name_with_underscores](const PrefixedTensors::value_type& pair){
+            const std::string& lora_name = pair.first;
             // TODO: Should it be an exact match instead of substring taking into account that we should provide custom mapper for names?
             return name.find(lora_name) != std::string::npos || name_with_underscores.find(lora_name) != std::string::npos;
         });
         if(it != lora_tensors->end()) {
-            used_tensors.insert(it->first);
-            return it->second;
+            used_tensors.insert(it->second->first);
+            return it->second->second;
         }
         return std::nullopt;
     }
@@ -364,14 +526,24 @@ void deduce_input_output_dims(NodePtr node, ov::Dimension& input_dim, ov::Dimens
 
 // Creates ReadValue and Assign nodes to inject LoRA tensors as variables for a given node but
 // doesn't connect them to the model returning as LoRANode instance.
+// If `per_token_alphas` is set (AdapterConfig::MODE_MULTI), the alpha variable is a selector matrix of shape [number of adapters, rank]
+// that maps per-token alphas for each adapter to the columns of the stacked A and B matrices. Only the columns of adapters listed
+// in `active_adapters` are gathered from A and B, so the cost of LoRA depends on the adapters used in the current inference
+// rather than on all registered adapters, `per_token_alphas` has a column for each active adapter.
 struct LoRAWeightStateGetter {
     LoRAParametersGetter params_getter;
     std::shared_ptr<ov::Model> model;
     std::vector<LoRAVarIDs>& variable_ids;
+    std::shared_ptr<v0::Parameter> per_token_alphas;
+    std::shared_ptr<v0::Parameter> active_adapters;
+    size_t num_adapters;
     // TODO: Use variable indices instead of variable_id for faster search for a state tensor
 
-    LoRAWeightStateGetter (const LoRAParametersGetter& params_getter, std::shared_ptr<ov::Model> model, std::vector<LoRAVarIDs>& variable_ids) :
-        params_getter(params_getter), model(model), variable_ids(variable_ids) {}
+    LoRAWeightStateGetter (const LoRAParametersGetter& params_getter, std::shared_ptr<ov::Model> model, std::vector<LoRAVarIDs>& variable_ids,
+                           std::shared_ptr<v0::Parameter> per_token_alphas = nullptr, std::shared_ptr<v0::Parameter> active_adapters = nullptr,
+                           size_t num_adapters = 0) :
+        params_getter(params_getter), model(model), variable_ids(variable_ids), per_token_alphas(per_token_alphas),
+        active_adapters(active_adapters), num_adapters(num_adapters) {}
 
     std::optional<LoRANode> operator() (NodePtr node) const {
         if(auto params = params_getter(node)) {
@@ -396,12 +568,49 @@ struct LoRAWeightStateGetter {
             result.A = add_variable(var_ids.A);
             // FIXME: No guarantees on ordering of state in InferRequest makes impossible using indices of variables later, forced to use variable_id instead
             //indices.A = model->get_variables().size();
-            var_ids.alpha = ov::op::util::VariableInfo{
-                params->fine_grained_alpha ? ov::PartialShape{1, params->rank} : ov::PartialShape{},
-                ov::element::f32,   // alpha is always f32 because it is set from host as float data type
-                variable_id_prefix + ".alpha"
-            };
-            result.alpha = add_variable(var_ids.alpha);
+            NodePtr columns;
+            if(per_token_alphas) {
+                var_ids.alpha = ov::op::util::VariableInfo{
+                    ov::PartialShape{static_cast<int64_t>(num_adapters), params->rank},
+                    ov::element::f32,
+                    variable_id_prefix + ".alpha"
+                };
+                auto axis0 = v0::Constant::create(ov::element::i64, ov::Shape{}, {0});
+                auto axis1 = v0::Constant::create(ov::element::i64, ov::Shape{}, {1});
+                // [active adapters, rank]
+                auto selector = std::make_shared<v8::Gather>(add_variable(var_ids.alpha), active_adapters, axis0);
+                // Columns occupied by the active adapters in the stacked A and B
+                auto active_columns = std::make_shared<v1::Reshape>(
+                    std::make_shared<v3::NonZero>(std::make_shared<v1::ReduceMax>(selector, axis0, false), ov::element::i64),
+                    v0::Constant::create(ov::element::i64, ov::Shape{1}, {-1}), false);
+                // Column 0 with zero alpha is always appended, it keeps A and B non-empty when the active adapters are not applicable
+                // to this node as empty tensors are not supported in MatMul by all plugins
+                auto pad_column = v0::Constant::create(ov::element::i64, ov::Shape{1}, {0});
+                columns = std::make_shared<v0::Concat>(ov::OutputVector{active_columns, pad_column}, 0);
+
+                // [tokens, active adapters] x [active adapters, rank] gives alpha for each token and each column of the stacked LoRA matrices
+                NodePtr alpha = std::make_shared<v0::MatMul>(per_token_alphas, selector);
+                auto pad_alpha = std::make_shared<v1::Multiply>(
+                    std::make_shared<v8::Gather>(alpha, pad_column, axis1),
+                    v0::Constant::create(ov::element::f32, ov::Shape{}, {0.0f}));
+                alpha = std::make_shared<v0::Concat>(
+                    ov::OutputVector{std::make_shared<v8::Gather>(alpha, active_columns, axis1), pad_alpha}, 1);
+                result.A = std::make_shared<v8::Gather>(result.A, columns, axis0);
+                // Tokens are enumerated by the first dimension of activations, broadcast alpha over the rest of dimensions except the last one
+                auto activations_rank = node->get_input_partial_shape(0).rank().get_length();
+                std::vector<int64_t> alpha_shape(activations_rank, 1);
+                alpha_shape.front() = 0;
+                alpha_shape.back() = -1;
+                result.alpha = std::make_shared<v1::Reshape>(
+                    alpha, v0::Constant::create(ov::element::i64, ov::Shape{alpha_shape.size()}, alpha_shape), true);
+            } else {
+                var_ids.alpha = ov::op::util::VariableInfo{
+                    params->fine_grained_alpha ? ov::PartialShape{1, params->rank} : ov::PartialShape{},
+                    ov::element::f32,   // alpha is always f32 because it is set from host as float data type
+                    variable_id_prefix + ".alpha"
+                };
+                result.alpha = add_variable(var_ids.alpha);
+            }
             // FIXME: No guarantees on ordering of state in InferRequest makes impossible using indices of variables later, forced to use variable_id instead
             //indices.B = model->get_variables().size();
             var_ids.B = ov::op::util::VariableInfo{
@@ -410,6 +619,9 @@ struct LoRAWeightStateGetter {
                 variable_id_prefix + ".B"
             };
             result.B = add_variable(var_ids.B);
+            if(columns) {
+                result.B = std::make_shared<v8::Gather>(result.B, columns, v0::Constant::create(ov::element::i64, ov::Shape{}, {1}));
+            }
             variable_ids.emplace_back(var_ids);
             return result;
         } else {
@@ -499,7 +711,7 @@ NodePtr tensors_multiplication(NodePtr input, const NodeVector multipliers, ov::
         if(normalized->get_output_element_type(0) != target_type) {
             normalized = std::make_shared<v0::Convert>(normalized, target_type);
         }
-        if(normalized->get_output_partial_shape(0).rank().get_length() > 2) {
+        if(i != alpha_pos && normalized->get_output_partial_shape(0).rank().get_length() > 2) {
             // FIXME: Any other shape patterns possible?
             normalized = squeeze_2d(normalized);
         }
@@ -531,76 +743,267 @@ NodePtr tensors_multiplication(NodePtr input, const NodeVector multipliers, ov::
 }
 
 
-// Taking a node detects an optional weight decompression pattern Constant -> Convert.
-// Returns a pointer to Convert node if it exists, or nullptr if there is no Convert.
+// Skips Convert nodes starting from a given output and returns a Constant if it is found at the end of the chain, or nullptr otherwise.
+std::shared_ptr<v0::Constant> constant_through_converts (const ov::Output<ov::Node>& output) {
+    auto node = output.get_node_shared_ptr();
+    while(std::dynamic_pointer_cast<v0::Convert>(node)) {
+        node = node->get_input_node_shared_ptr(0);
+    }
+    return std::dynamic_pointer_cast<v0::Constant>(node);
+}
+
+
+// Constants of a weight decompression subgraph.
+// Supported patterns (zero point and scale can be followed by Convert):
+//      Constant -> [Convert]                                                                               (f32/f16/bf16 weights)
+//      Constant -> Convert -> [Subtract(zero point)] -> Multiply(scale) -> [Reshape] -> [Convert]          (integer weights)
+struct DecompressionPattern {
+    std::shared_ptr<v0::Constant> weights;
+    std::shared_ptr<v0::Constant> zero_point;   // nullptr if there is no zero point
+    std::shared_ptr<v0::Constant> scale;        // nullptr for f32/f16/bf16 weights
+    size_t group_size = 0;                      // number of contiguous weight elements that share the same scale and zero point, 0 if weights cannot be requantized
+
+    ConstantVector constants() const {
+        ConstantVector result{weights};
+        if(zero_point) {
+            result.push_back(zero_point);
+        }
+        if(scale) {
+            result.push_back(scale);
+        }
+        return result;
+    }
+};
+
+
+// Detects weight decompression pattern for a given weight input of MatMul or Convolution.
 // If unsupported decompression pattern is used, throws an exception.
-NodePtr decompression_convert (NodePtr node) {
-    auto convert = std::dynamic_pointer_cast<v0::Convert>(node);
-    if(convert) {
-        node = convert->get_input_node_shared_ptr(0);
+DecompressionPattern detect_decompression (const ov::Output<ov::Node>& weights_input) {
+    DecompressionPattern pattern;
+    auto node = weights_input.get_node_shared_ptr();
+    while(std::dynamic_pointer_cast<v0::Convert>(node) || std::dynamic_pointer_cast<v1::Reshape>(node)) {
+        node = node->get_input_node_shared_ptr(0);
     }
+
+    if((pattern.weights = std::dynamic_pointer_cast<v0::Constant>(node))) {
+        OPENVINO_ASSERT(
+            pattern.weights->get_element_type().is_real(),
+            "Not supported decompression pattern at the weight input: integer weights without scale.");
+        pattern.group_size = ov::shape_size(pattern.weights->get_shape());
+        return pattern;
+    }
+
+    auto multiply = std::dynamic_pointer_cast<v1::Multiply>(node);
+    OPENVINO_ASSERT(multiply, "Not supported decompression pattern at the weight input. Use f32/f16/bf16 or int8/int4 compressed weights only.");
+    ov::Output<ov::Node> data;
+    for(size_t i = 0; i < 2; ++i) {
+        auto scale = constant_through_converts(multiply->input_value(i));
+        if(scale && scale->get_element_type().is_real()) {
+            pattern.scale = scale;
+            data = multiply->input_value(1 - i);
+            break;
+        }
+    }
+    OPENVINO_ASSERT(pattern.scale, "Not supported decompression pattern at the weight input: scale is not a constant.");
+
+    if(auto subtract = std::dynamic_pointer_cast<v1::Subtract>(data.get_node_shared_ptr())) {
+        pattern.zero_point = constant_through_converts(subtract->input_value(1));
+        OPENVINO_ASSERT(pattern.zero_point, "Not supported decompression pattern at the weight input: zero point is not a constant.");
+        data = subtract->input_value(0);
+    }
+    pattern.weights = constant_through_converts(data);
     OPENVINO_ASSERT(
-        std::dynamic_pointer_cast<v0::Constant>(node),
-        "Not supported decompression pattern at the weight input (presumably low-bit compression). Use f32/f16/bf16 weights only."
-    );
-    return convert;
+        pattern.weights && pattern.weights->get_element_type().is_integral(),
+        "Not supported decompression pattern at the weight input: expected integer weights constant.");
+
+    // Requantization expects that the scale has the same shape as the weights in leading dimensions and 1 in trailing dimensions,
+    // so the groups are contiguous in memory. Otherwise group_size is left 0 and compression cannot be preserved.
+    // Unsigned weights without zero point cannot represent negative values that appear after fusion, so they are not requantized either.
+    const auto& weights_shape = pattern.weights->get_shape();
+    const auto& scale_shape = pattern.scale->get_shape();
+    const bool can_be_negative = pattern.zero_point || pattern.weights->get_element_type().is_signed();
+    if(can_be_negative && scale_shape.size() == weights_shape.size() && (!pattern.zero_point || pattern.zero_point->get_shape() == scale_shape)) {
+        size_t axis = weights_shape.size();
+        while(axis > 0 && scale_shape[axis - 1] == 1) {
+            --axis;
+        }
+        if(std::equal(weights_shape.begin(), weights_shape.begin() + axis, scale_shape.begin())) {
+            pattern.group_size = std::accumulate(weights_shape.begin() + axis, weights_shape.end(), size_t(1), std::multiplies<size_t>());
+        }
+    }
+    return pattern;
+}
+
+
+// Quantizes `values` to integer type T group-wise and creates new weights, zero point and scale constants
+// with the same element types and shapes as in a given decompression pattern.
+template <typename T>
+DecompressionPattern requantize (const float* values, const DecompressionPattern& pattern, int64_t qmin, int64_t qmax) {
+    const auto& weights_shape = pattern.weights->get_shape();
+    const size_t size = ov::shape_size(weights_shape);
+    const size_t num_groups = size / pattern.group_size;
+    std::vector<T> quantized(size);
+    std::vector<float> scales(num_groups);
+    std::vector<int32_t> zero_points(pattern.zero_point ? num_groups : 0);
+
+    for(size_t group = 0; group < num_groups; ++group) {
+        const float* begin = values + group*pattern.group_size;
+        const float* end = begin + pattern.group_size;
+        float scale, zero_point = 0;
+        if(pattern.zero_point) {
+            auto min_max = std::minmax_element(begin, end);
+            scale = (*min_max.second - *min_max.first) / float(qmax - qmin);
+            scale = scale == 0 ? 1 : scale;
+            zero_point = std::clamp<float>(std::round(qmin - *min_max.first / scale), qmin, qmax);
+            zero_points[group] = static_cast<int32_t>(zero_point);
+        } else {
+            float abs_max = 0;
+            for(auto it = begin; it != end; ++it) {
+                abs_max = std::max(abs_max, std::abs(*it));
+            }
+            scale = abs_max / qmax;
+            scale = scale == 0 ? 1 : scale;
+        }
+        scales[group] = scale;
+        T* output = quantized.data() + group*pattern.group_size;
+        for(auto it = begin; it != end; ++it) {
+            *output++ = static_cast<T>(std::clamp<float>(std::round(*it / scale) + zero_point, qmin, qmax));
+        }
+    }
+
+    DecompressionPattern result = pattern;
+    result.weights = v0::Constant::create(pattern.weights->get_element_type(), weights_shape, quantized);
+    result.scale = v0::Constant::create(pattern.scale->get_element_type(), pattern.scale->get_shape(), scales);
+    if(pattern.zero_point) {
+        result.zero_point = v0::Constant::create(pattern.zero_point->get_element_type(), pattern.zero_point->get_shape(), zero_points);
+    }
+    return result;
+}
+
+
+DecompressionPattern requantize (const float* values, const DecompressionPattern& pattern) {
+    auto type = pattern.weights->get_element_type();
+    OPENVINO_ASSERT(pattern.zero_point || type.is_signed(), "Unsigned compressed weights without zero point cannot be requantized");
+    if(type == ov::element::u8) {
+        return requantize<uint8_t>(values, pattern, 0, 255);
+    } else if(type == ov::element::i8) {
+        return requantize<int8_t>(values, pattern, -128, 127);
+    } else if(type == ov::element::u4) {
+        return requantize<uint8_t>(values, pattern, 0, 15);
+    } else if(type == ov::element::i4) {
+        return requantize<int8_t>(values, pattern, -8, 7);
+    }
+    OPENVINO_THROW("Not supported element type for compressed weights in LoRA fuse mode: ", type);
 }
 
 
 // Cache of infer request for on-demand build and compiled helper models for weight modification.
-// It maps a model signature which is an arbitrary string to OpenVINO infer request.
-// Defines `evaluate` method that compute a model by a given signature and input tensors.
+// It maps a model signature which is an arbitrary string to a pool of OpenVINO infer requests created for the same compiled model.
+// Defines `evaluate` method that compute a model by a given signature and input tensors,
+// and `evaluate_async`/`wait` pair to run multiple evaluations in parallel.
 class InferRequestSignatureCache {
 public:
     using Signature = std::string;
 
-    InferRequestSignatureCache (const std::string& device) : device(device) {}
+    InferRequestSignatureCache (const std::string& device, size_t max_requests_per_signature = 1) :
+        device(device), max_requests_per_signature(std::max<size_t>(max_requests_per_signature, 1)) {}
 
     bool exist (const Signature& signature) {
         return requests.count(signature);
     }
 
     void insert (const Signature& signature, std::shared_ptr<ov::Model> model) {
-        requests[signature] = core.compile_model(model, device).create_infer_request();
+        auto& pool = requests[signature];
+        pool.compiled_model = core.compile_model(model, device);
+        pool.requests = {pool.compiled_model.create_infer_request()};
+        pool.busy = {false};
+        pool.inputs_owners = {nullptr};
+        pool.next = 0;
     }
 
-    ov::InferRequest& at(const Signature& signature) {
-        return requests.at(signature);
+    void evaluate(const Signature& signature, const ov::TensorVector& inputs, ov::TensorVector& outputs) {
+        evaluate_async(signature, inputs, outputs);
+        wait();
     }
 
-    void evaluate(const Signature& signature, const ov::TensorVector& inputs, ov::TensorVector& outputs) {
-        auto& request = at(signature);
-        auto compiled_model = request.get_compiled_model();
-        OPENVINO_ASSERT(inputs.size() == compiled_model.inputs().size());
-        OPENVINO_ASSERT(outputs.size() == compiled_model.outputs().size());
+    // Starts evaluation in one of the infer requests from the pool for a given signature.
+    // If all requests in the pool are busy and the pool reached its maximum size, waits for the oldest one.
+    // Output tensors are ready to be used only after `wait` is called.
+    // Input tensors may be non-owning views, `inputs_owner` keeps the memory behind them alive until the evaluation is finished.
+    void evaluate_async(const Signature& signature, const ov::TensorVector& inputs, ov::TensorVector& outputs, std::shared_ptr<const void> inputs_owner = nullptr) {
+        auto& pool = requests.at(signature);
+        if(pool.next == pool.requests.size()) {
+            if(pool.requests.size() < max_requests_per_signature) {
+                pool.requests.push_back(pool.compiled_model.create_infer_request());
+                pool.busy.push_back(false);
+                pool.inputs_owners.emplace_back();
+            } else {
+                pool.next = 0;
+            }
+        }
+        size_t index = pool.next++;
+        auto& request = pool.requests[index];
+        if(pool.busy[index]) {
+            request.wait();
+        }
+        pool.busy[index] = true;
+        pool.inputs_owners[index] = std::move(inputs_owner);
+
+        OPENVINO_ASSERT(inputs.size() == pool.compiled_model.inputs().size());
+        OPENVINO_ASSERT(outputs.size() == pool.compiled_model.outputs().size());
         for(size_t i = 0; i < inputs.size(); ++i) {
             request.set_input_tensor(i, inputs[i]);
         }
         for(size_t i = 0; i < outputs.size(); ++i) {
-            auto target_shape = request.get_compiled_model().output(i).get_partial_shape();
+            auto target_shape = pool.compiled_model.output(i).get_partial_shape();
             if(target_shape != outputs[i].get_shape() && target_shape.is_static()) {
                 // do it for static case only, because if target shape is dynamic, the plugin is allowed to set shape on its own
                 outputs[i].set_shape(target_shape.get_shape());
             }
             request.set_output_tensor(i, outputs[i]);
         }
-        request.infer();    // TODO: Consider using async to increase througput, requies more complicated archestration
+        request.start_async();
+    }
+
+    // Waits for all evaluations started by `evaluate_async`
+    void wait() {
+        for(auto& signature_and_pool : requests) {
+            auto& pool = signature_and_pool.second;
+            for(size_t i = 0; i < pool.busy.size(); ++i) {
+                if(pool.busy[i]) {
+                    pool.requests[i].wait();
+                    pool.busy[i] = false;
+                    pool.inputs_owners[i].reset();
+                }
+            }
+            pool.next = 0;
+        }
     }
 
 private:
 
+    struct RequestPool {
+        ov::CompiledModel compiled_model;
+        std::vector<ov::InferRequest> requests;
+        std::vector<bool> busy;
+        std::vector<std::shared_ptr<const void>> inputs_owners;    // keep inputs of the running evaluations alive
+        size_t next = 0;    // index of the request for the next evaluation, round robin over the pool
+    };
+
     ov::Core core;
-    std::unordered_map<Signature, ov::InferRequest> requests;
+    std::unordered_map<Signature, RequestPool> requests;
     std::string device;
+    size_t max_requests_per_signature;
 };
 
 
 // Transformation that modifies existing weights in the base model fusing an arbitrary number of LoRA adapters.
 // This is one-way LoRA fusion that cannot be undone.
 // By default it uses CPU plugin to modify the base model weights.
-// TODO: This transformation unpacks potentially compressed to f16/bf16 weights to f32,
-// we should pack it back into the original precsion to maintain the same wieght size.
-// But it will work well if all plugins equally support fp-compressed weights and can unpack them on-line.
+// The original compression of the weights is retained: f16/bf16 weights are stored back in the original precision,
+// int8/int4 weights are requantized with the same group size and replace original weights, zero points and scales.
+// Weights are processed one by one, so only one decompressed weight is allocated at a time,
+// and the original constants are released as soon as they are replaced in the model (if they are not used elsewhere).
 class LoRAFuseTransform : public LoRATransformBase {
 
     InferRequestSignatureCache fusers;
@@ -610,6 +1013,63 @@ class LoRAFuseTransform : public LoRATransformBase {
         signature += "(el: " + input.get_element_type().get_type_name() + ", shape: " + input.get_partial_shape().to_string() + ")";
     }
 
+    // Clones the subgraph that produces `output` replacing `constants` by new parameters in the same order, other constants are copied.
+    // Each cloned node is reflected in the signature.
+    ov::Output<ov::Node> clone_decompression(
+        const ov::Output<ov::Node>& output,
+        const ConstantVector& constants,
+        ov::ParameterVector& parameters,
+        InferRequestSignatureCache::Signature& signature
+    ) const {
+        auto node = output.get_node_shared_ptr();
+        auto it = std::find(constants.begin(), constants.end(), node);
+        if(it != constants.end()) {
+            auto& parameter = parameters[it - constants.begin()];
+            parameter = std::make_shared<v0::Parameter>(node->get_output_element_type(0), node->get_output_partial_shape(0));
+            signature += "P";
+            signature_push_back(signature, output);
+            return parameter;
+        }
+        ov::OutputVector inputs;
+        for(const auto& input : node->input_values()) {
+            inputs.push_back(clone_decompression(input, constants, parameters, signature));
+        }
+        signature += node->get_type_name();
+        if(auto constant = std::dynamic_pointer_cast<v0::Constant>(node)) {
+            // values of constants that are not parameterized define the model, e.g. target shape for Reshape
+            for(const auto& value : constant->get_value_strings()) {
+                signature += value + ",";
+            }
+        }
+        signature_push_back(signature, output);
+        return node->clone_with_new_inputs(inputs)->output(output.get_index());
+    }
+
+    // Clones the subgraph that produces `output` replacing `constants` by `replacements` in the same order, other constants are shared.
+    // Used to substitute weights for a single MatMul/Convolution without touching other consumers of the original constants.
+    static ov::Output<ov::Node> replace_decompression_constants(
+        const ov::Output<ov::Node>& output,
+        const ConstantVector& constants,
+        const ConstantVector& replacements
+    ) {
+        auto node = output.get_node_shared_ptr();
+        auto it = std::find(constants.begin(), constants.end(), node);
+        if(it != constants.end()) {
+            return replacements[it - constants.begin()]->output(0);
+        }
+        if(std::dynamic_pointer_cast<v0::Constant>(node)) {
+            return output;
+        }
+        ov::OutputVector inputs;
+        for(const auto& input : node->input_values()) {
+            inputs.push_back(replace_decompression_constants(input, constants, replacements));
+        }
+        auto clone = node->clone_with_new_inputs(inputs);
+        // keep decompression markers that plugins rely on to recognize compressed weights
+        ov::copy_runtime_info(node, clone);
+        return clone->output(output.get_index());
+    }
+
 public:
 
     OPENVINO_RTTI("LoRAFuseTransform");
@@ -621,57 +1081,72 @@ public:
 
     bool apply (NodePtr node, const LoRANode& lora_weight) override {
         auto weights_input = node->input_value(1);
-        auto weights_input_type = weights_input.get_element_type();
-        auto weights_convert = decompression_convert(weights_input.get_node_shared_ptr());
-        auto weights_constant = weights_convert ? weights_convert->input_value(0) : weights_input;
+        auto decompression = detect_decompression(weights_input);
+        auto decompression_constants = decompression.constants();
+        bool compressed = bool(decompression.scale);
+        bool keep_compression = decompression.group_size > 0;
         ConstantVector adapter = {
             std::dynamic_pointer_cast<v0::Constant>(lora_weight.alpha),
             std::dynamic_pointer_cast<v0::Constant>(lora_weight.B),
             std::dynamic_pointer_cast<v0::Constant>(lora_weight.A)};
+
+        // Build a small model for weight and LoRA fusion, and stash it into `fusers` cache.
+        // Decompression subgraph is cloned to the model because the signature depends on it.
+        ov::ParameterVector parameters(decompression_constants.size());
         InferRequestSignatureCache::Signature signature;
-        signature_push_back(signature, weights_input);
+        auto target = clone_decompression(weights_input, decompression_constants, parameters, signature);
         for(auto multiplier : adapter) {
             signature_push_back(signature, multiplier);
+            parameters.push_back(std::make_shared<v0::Parameter>(multiplier->get_output_element_type(0), multiplier->get_output_partial_shape(0)));
         }
 
-        // TODO: In case when comressed repacking of newly created weights is retained,
-        // replace weights_input by weigths_constant to keep decompression Convert in the model.
-        auto consumers = weights_input.get_target_inputs();
-
         if(!fusers.exist(signature)) {
-            // Build a small model for weight and LoRA fusion, and stash it into `fusers` cache.
-            ov::ParameterVector parameters;
-            auto target_parameter = std::make_shared<v0::Parameter>(weights_constant.get_element_type(), weights_constant.get_partial_shape());
-            parameters.push_back(target_parameter);   // original weights input is one of the parameters
-            ov::Output<ov::Node> target = weights_convert ? weights_convert->clone_with_new_inputs({target_parameter}) : target_parameter;
-            for(auto multiplier : adapter) {
-                parameters.push_back(std::make_shared<v0::Parameter>(multiplier->get_output_element_type(0), multiplier->get_output_partial_shape(0)));
+            NodePtr fused = tensors_multiplication(nullptr, NodeVector{parameters.end() - adapter.size(), parameters.end()}, target, false, 1, false);
+            if(!compressed && fused->get_output_element_type(0) != decompression.weights->get_element_type()) {
+                // pack back to the original f16/bf16 precision
+                fused = std::make_shared<v0::Convert>(fused, decompression.weights->get_element_type());
+            } else if(compressed && keep_compression && fused->get_output_element_type(0) != ov::element::f32) {
+                // requantization is done on host from f32 values
+                fused = std::make_shared<v0::Convert>(fused, ov::element::f32);
             }
-            auto result = std::make_shared<v0::Result>(tensors_multiplication(nullptr, NodeVector{parameters.begin() + 1, parameters.end()}, target, false, 1, false));
-            auto weights_model = std::make_shared<ov::Model>(ov::ResultVector{result}, parameters);
+            auto weights_model = std::make_shared<ov::Model>(ov::ResultVector{std::make_shared<v0::Result>(fused)}, parameters);
             fusers.insert(signature, weights_model);
         }
 
-        // Newly created contants in the next line are not mmaped unlike original weights, so it will inflate required memory
-        // eventually allocating up to 2x of the base model size.
-        // 2X is due to usually applied compression in the base model that is not retained in the current version of this code.
-        // But even if the compression is used, then still a copy of all weights that affected by the LoRA adapters are allocated in memory.
-        // FIXME: Provide a way for postponed weight repacking that will be triggered by the plugin in compile_model call for the base model.
-        // Constant sub-expression can be a solution, but it requres improvements inside plugins, because currently it works extremely slow.
-        auto replacement_const = std::make_shared<v0::Constant>(weights_input.get_element_type(), weights_input.get_shape());
-
-        ov::TensorVector outputs{replacement_const->get_tensor_view()};
-        // set input constants
         ov::TensorVector inputs;
-        inputs.reserve(1 + adapter.size());
-        inputs.push_back(std::dynamic_pointer_cast<v0::Constant>(weights_constant.get_node_shared_ptr())->get_tensor_view());
-        for(size_t i = 0; i < adapter.size(); ++i) {
-            inputs.push_back(adapter[i]->get_tensor_view());
+        inputs.reserve(decompression_constants.size() + adapter.size());
+        for(const auto& constant : decompression_constants) {
+            inputs.push_back(constant->get_tensor_view());
+        }
+        for(const auto& multiplier : adapter) {
+            inputs.push_back(multiplier->get_tensor_view());
         }
-        fusers.evaluate(signature, inputs, outputs);
 
-        for (auto consumer : consumers) {
-            consumer.replace_source_output(replacement_const->output(0));
+        // FIXME: Provide a way for postponed weight repacking that will be triggered by the plugin in compile_model call for the base model.
+        // Constant sub-expression can be a solution, but it requres improvements inside plugins, because currently it works extremely slow.
+        if(!compressed) {
+            // Fused weights are written directly to a new constant of the original type, decompression Convert is kept in the model
+            auto replacement_const = std::make_shared<v0::Constant>(decompression.weights->get_element_type(), decompression.weights->get_shape());
+            ov::TensorVector outputs{replacement_const->get_tensor_view()};
+            fusers.evaluate(signature, inputs, outputs);
+            // Only the weights input of this node is replaced, the original constant can be shared with other nodes
+            node->input(1).replace_source_output(
+                replace_decompression_constants(weights_input, {decompression.weights}, {replacement_const}));
+        } else if(keep_compression) {
+            // Decompressed fused weights live only until they are requantized
+            ov::TensorVector outputs{ov::Tensor(ov::element::f32, weights_input.get_shape())};
+            fusers.evaluate(signature, inputs, outputs);
+            auto requantized = requantize(outputs[0].data<float>(), decompression);
+            node->input(1).replace_source_output(
+                replace_decompression_constants(weights_input, decompression_constants, requantized.constants()));
+        } else {
+            // Newly created contants are not mmaped unlike original weights and they are not compressed,
+            // so they inflate required memory up to the decompressed size of all weights affected by LoRA adapters.
+            DEBUG_PRINT("Cannot preserve compression for weights of layer " << node->get_friendly_name() << ", fused weights are decompressed");
+            auto replacement_const = std::make_shared<v0::Constant>(weights_input.get_element_type(), weights_input.get_shape());
+            ov::TensorVector outputs{replacement_const->get_tensor_view()};
+            fusers.evaluate(signature, inputs, outputs);
+            node->input(1).replace_source_output(replacement_const->output(0));
         }
         return true;
     }
@@ -737,15 +1212,182 @@ namespace genai {
 class Adapter::Impl {
 public:
     Impl(const std::string& path) :
+        path(path),
         tensors(group_lora_tensors(read_safetensors(path), default_lora_patterns()))
     {}
 
+    AdapterMemoryInfo get_memory_info() const {
+        AdapterMemoryInfo info;
+        info.path = path;
+        for(const auto& lora_tensor : tensors) {
+            for(const auto& constant : {lora_tensor.second.alpha, lora_tensor.second.A, lora_tensor.second.B}) {
+                if(constant) {
+                    ++info.num_tensors;
+                    info.mapped_bytes += constant->get_byte_size();
+                }
+            }
+        }
+        return info;
+    }
+
+    // Reads a byte of each page of the mapped tensors, so the first inference with the adapter doesn't wait for the file
+    void warm_up() const {
+        constexpr size_t page_size = 4096;
+        volatile uint8_t sink = 0;
+        for(const auto& lora_tensor : tensors) {
+            for(const auto& constant : {lora_tensor.second.alpha, lora_tensor.second.A, lora_tensor.second.B}) {
+                if(constant) {
+                    const uint8_t* data = static_cast<const uint8_t*>(constant->get_data_ptr());
+                    for(size_t offset = 0; offset < constant->get_byte_size(); offset += page_size) {
+                        sink = sink ^ data[offset];
+                    }
+                }
+            }
+        }
+    }
+
+    const std::string path;
     LoRATensors tensors;
 };
 
 
+// Adapters obtained from AdapterRegistry that are alive in the process by absolute file path, entries for destroyed adapters are removed lazily.
+// Preloading is done by a single worker thread in the order of requests, so preloading of many adapters doesn't start a thread per adapter;
+// loading is bound by reading files, more threads would compete for the disk. The worker exits when the queue is empty.
+struct AdapterRegistryImpl {
+    std::mutex mutex;
+    std::map<std::string, std::weak_ptr<Adapter::Impl>> adapters;
+
+    std::mutex queue_mutex;
+    std::deque<std::pair<std::string, std::packaged_task<Adapter()>>> queue;
+    // preloads that are queued or running by absolute file path, a repeated preload of the same file returns the same future
+    std::map<std::string, std::shared_future<Adapter>> pending;
+    std::thread worker;
+    bool worker_running = false;
+    bool stopped = false;
+
+    static AdapterRegistryImpl& instance() {
+        static AdapterRegistryImpl registry;
+        return registry;
+    }
+
+    ~AdapterRegistryImpl() {
+        {
+            std::lock_guard<std::mutex> lock(queue_mutex);
+            stopped = true;
+        }
+        if(worker.joinable()) {
+            worker.join();
+        }
+    }
+
+    std::shared_future<Adapter> preload(const std::string& path) {
+        auto key = std::filesystem::absolute(path).lexically_normal().string();
+        std::lock_guard<std::mutex> lock(queue_mutex);
+        auto it = pending.find(key);
+        if(it != pending.end()) {
+            return it->second;
+        }
+
+        std::packaged_task<Adapter()> task([this, key]() {
+            Adapter adapter;
+            adapter.m_pimpl = get(key);
+            adapter.m_pimpl->warm_up();
+            return adapter;
+        });
+        auto future = task.get_future().share();
+        pending.emplace(key, future);
+        queue.emplace_back(key, std::move(task));
+
+        if(!worker_running) {
+            // the previous worker has left the loop already, join doesn't wait for the queue
+            if(worker.joinable()) {
+                worker.join();
+            }
+            worker_running = true;
+            worker = std::thread([this]() { process_queue(); });
+        }
+        return future;
+    }
+
+    void process_queue() {
+        std::unique_lock<std::mutex> lock(queue_mutex);
+        while(!queue.empty() && !stopped) {
+            auto item = std::move(queue.front());
+            queue.pop_front();
+            lock.unlock();
+            // exceptions are stored in the future by packaged_task
+            item.second();
+            lock.lock();
+            pending.erase(item.first);
+        }
+        worker_running = false;
+    }
+
+    std::shared_ptr<Adapter::Impl> get(const std::string& path) {
+        auto key = std::filesystem::absolute(path).lexically_normal().string();
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if(auto impl = adapters[key].lock()) {
+                return impl;
+            }
+        }
+        // The file is parsed without holding the lock to allow loading of different adapters in parallel
+        auto impl = std::make_shared<Adapter::Impl>(key);
+        std::lock_guard<std::mutex> lock(mutex);
+        if(auto existing = adapters[key].lock()) {
+            // the same file was loaded concurrently, use the first loaded one to share tensors
+            return existing;
+        }
+        adapters[key] = impl;
+        return impl;
+    }
+
+    std::vector<std::shared_ptr<Adapter::Impl>> alive() {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::vector<std::shared_ptr<Adapter::Impl>> result;
+        for(auto it = adapters.begin(); it != adapters.end();) {
+            if(auto impl = it->second.lock()) {
+                result.push_back(impl);
+                ++it;
+            } else {
+                it = adapters.erase(it);
+            }
+        }
+        return result;
+    }
+};
+
+
 Adapter::Adapter(const std::string& path) :
-    m_pimpl(std::make_shared<Adapter::Impl>(path)) {
+    m_pimpl(std::make_shared<Adapter::Impl>(std::filesystem::absolute(path).lexically_normal().string())) {
+}
+
+
+Adapter AdapterRegistry::get(const std::string& path) {
+    Adapter adapter;
+    adapter.m_pimpl = AdapterRegistryImpl::instance().get(path);
+    return adapter;
+}
+
+
+std::shared_future<Adapter> AdapterRegistry::preload(const std::string& path) {
+    return AdapterRegistryImpl::instance().preload(path);
+}
+
+
+std::vector<AdapterMemoryInfo> AdapterRegistry::get_memory_info() {
+    std::vector<AdapterMemoryInfo> result;
+    for(const auto& impl : AdapterRegistryImpl::instance().alive()) {
+        result.push_back(impl->get_memory_info());
+    }
+    return result;
+}
+
+
+AdapterMemoryInfo AdapterRegistry::get_memory_info(const Adapter& adapter) {
+    OPENVINO_ASSERT(adapter, "Memory information is requested for an empty adapter");
+    return adapter.m_pimpl->get_memory_info();
 }
 
 
@@ -766,10 +1408,25 @@ struct AdapterControllerImpl {
     bool need_full_apply = true;
     InferRequestSignatureCache lora_state_evaluators;
 
+    // Fully prepared A and B state tensors for all LoRA variables in the order of variable_ids
+    using LoRAStateTensors = std::vector<LoRAParts<ov::Tensor>>;
+    using StateCacheEntry = std::pair<std::vector<Adapter>, LoRAStateTensors>;
+    // LRU cache of prepared state tensors for recently used sets of adapters, the most recently used entry goes first
+    std::list<StateCacheEntry> state_cache;
+    size_t state_cache_capacity = 4;
+    static constexpr size_t max_lora_state_evaluators = 4;
+    // Guards lora_state_evaluators that are used by preparation in background and by `apply` on a cache miss
+    std::mutex evaluators_mutex;
+    // State tensors prepared by `prepare` in background, they are added to state_cache by the thread that waits for them,
+    // so the background task doesn't touch state_cache. Declared last to be destroyed, and so waited, first.
+    std::future<StateCacheEntry> pending_preparation;
+
     AdapterControllerImpl(std::shared_ptr<ov::Model> model, const AdapterConfig& config, const std::string& prefix) :
         prefix(prefix),
         current_config(config),  // FIXME: Compare current and passed configs and change incrementally
-        lora_state_evaluators("CPU")    // FIXME: Try to run on the same device that is used for model inference
+        // LoRA weight groups are independent, so they are evaluated in parallel in several infer requests,
+        // the pool is small because each request already uses multiple threads of the CPU plugin
+        lora_state_evaluators("CPU", max_lora_state_evaluators)    // FIXME: Try to run on the same device that is used for model inference
     {
         LoRAParametersByWeightGetter params_getter;
         #if FP16_BF16_TENSORS_SUPPORTED_IN_STATE
@@ -806,7 +1463,8 @@ struct AdapterControllerImpl {
                 ov::Tensor(params_getter.type, ov::Shape{0})
             };
             auto name = node->get_friendly_name();
-            auto lora_weight = prepare_lora_tensors(name, params_getter.weight_getter, lora_placeholder, false);
+            auto lora_weight = prepare_lora_tensors(name, current_config, params_getter.weight_getter, lora_placeholder, false);
+            lora_state_evaluators.wait();
             if(lora_weight.alpha) {
                 return LoRANode(
                     // TODO: Make sure that tensors will not be disposed during constant life time
@@ -825,6 +1483,18 @@ struct AdapterControllerImpl {
             // State mode
             params_getter.dynamic_lora_rank = (mode != AdapterConfig::MODE_STATIC_RANK);
             pm.register_pass<LoRASeparateTransform>(LoRAWeightStateGetter(params_getter, model, variable_ids));
+        } else if(mode == AdapterConfig::MODE_MULTI) {
+            // State mode with all adapters stacked, the adapters active in an inference are gathered and alphas are selected per token
+            auto per_token_alphas = std::make_shared<v0::Parameter>(ov::element::f32, ov::PartialShape::dynamic(2));
+            per_token_alphas->set_friendly_name(LORA_PER_TOKEN_ALPHAS_INPUT_NAME);
+            per_token_alphas->get_output_tensor(0).set_names({LORA_PER_TOKEN_ALPHAS_INPUT_NAME});
+            auto active_adapters = std::make_shared<v0::Parameter>(ov::element::i64, ov::PartialShape::dynamic(1));
+            active_adapters->set_friendly_name(LORA_ACTIVE_ADAPTERS_INPUT_NAME);
+            active_adapters->get_output_tensor(0).set_names({LORA_ACTIVE_ADAPTERS_INPUT_NAME});
+            model->add_parameters({per_token_alphas, active_adapters});
+            params_getter.dynamic_lora_rank = true;
+            pm.register_pass<LoRASeparateTransform>(LoRAWeightStateGetter(
+                params_getter, model, variable_ids, per_token_alphas, active_adapters, current_config.get_adapters().size()));
         } else if(mode == AdapterConfig::MODE_STATIC) {
             // Separate constant mode
             pm.register_pass<LoRASeparateTransform>(weight_as_constant);
@@ -875,8 +1545,14 @@ struct AdapterControllerImpl {
 
     void apply (ov::InferRequest& infer_request, std::optional<AdapterConfig> config) {
         // FIXME: If a part of LoRA state tensors are not set here, then need to carefully reset state in LLMPipeline where global reset is called after the generation
+        wait_for_preparation();
         ConfigChanged diff;
-        if(config) {
+        if(config && current_config.get_mode() == AdapterConfig::MODE_MULTI) {
+            // Alphas are provided per token as a model input, only a set of adapters is reflected in the state
+            OPENVINO_ASSERT(
+                !compare_configs(current_config, *config).adapter,
+                "Adapters cannot be changed when AdapterConfig::MODE_MULTI is used, select adapters per request in GenerationConfig instead");
+        } else if(config) {
             diff = compare_configs(current_config, *config);
             OPENVINO_ASSERT(
                 !diff.mode || config->get_mode() == AdapterConfig::MODE_AUTO,  // MODE_AUTO in this call means that mode is not changed
@@ -903,22 +1579,74 @@ struct AdapterControllerImpl {
         need_full_apply = full_apply;
     }
 
-    void set_new_adapter_alphas (ov::InferRequest& infer_request) {
-        // FIXME: Provide more economical way to update only alphas
-        set_new_adapter_tensors(infer_request);
+    // Starts evaluation of state tensors for a given config in a background thread, so that the next `apply` with the same set of adapters
+    // finds them in the cache. Does nothing if the tensors are already cached or the mode doesn't use state.
+    void prepare(const AdapterConfig& config) {
+        wait_for_preparation();
+        if(!is_state_mode() || !config || find_state_tensors(config.get_adapters()) != state_cache.end()) {
+            return;
+        }
+        auto weight_getters = make_weight_getters(config);
+        pending_preparation = std::async(std::launch::async, [this, config, weight_getters]() {
+            return StateCacheEntry{config.get_adapters(), evaluate_state_tensors(config, weight_getters)};
+        });
     }
 
-    void set_new_adapter_tensors (ov::InferRequest& infer_request) {
-        if(current_config.get_mode() != AdapterConfig::MODE_AUTO && current_config.get_mode() != AdapterConfig::MODE_DYNAMIC && current_config.get_mode() != AdapterConfig::MODE_STATIC_RANK ) {
-            return;
+    void wait_for_preparation() {
+        if(pending_preparation.valid()) {
+            StateCacheEntry prepared = pending_preparation.get();  // rethrows an exception if it happened in the background
+            if(find_state_tensors(prepared.first) == state_cache.end()) {
+                add_state_tensors(std::move(prepared.first), std::move(prepared.second));
+            }
         }
+    }
 
+    std::vector<LoRAWeightGetter> make_weight_getters(const AdapterConfig& config) {
         std::vector<LoRAWeightGetter> weight_getters;
-        const auto& adapters = current_config.get_adapters();
+        const auto& adapters = config.get_adapters();
         weight_getters.reserve(adapters.size());
         for(const auto& adapter: adapters) {
             weight_getters.emplace_back(LoRAWeightGetterDefault(&get_adapter_impl(adapter)->tensors, prefix));
         }
+        return weight_getters;
+    }
+
+    bool is_state_mode() const {
+        auto mode = current_config.get_mode();
+        return mode == AdapterConfig::MODE_AUTO || mode == AdapterConfig::MODE_DYNAMIC || mode == AdapterConfig::MODE_STATIC_RANK || mode == AdapterConfig::MODE_MULTI;
+    }
+
+    std::vector<float> get_alphas(const AdapterConfig& config) const {
+        OPENVINO_ASSERT(current_config.get_mode() == AdapterConfig::MODE_MULTI, "Per-request alphas are available in AdapterConfig::MODE_MULTI only");
+        const auto& registered_adapters = current_config.get_adapters();
+        std::vector<float> alphas(registered_adapters.size(), 0);
+        for(const auto& adapter: config.get_adapters()) {
+            auto it = std::find(registered_adapters.begin(), registered_adapters.end(), adapter);
+            OPENVINO_ASSERT(registered_adapters.end() != it,
+                "Adapter used in a request was not registered in the pipeline. All adapters should be passed to the pipeline constructor when AdapterConfig::MODE_MULTI is used.");
+            alphas[it - registered_adapters.begin()] = config.get_alpha(adapter);
+        }
+        return alphas;
+    }
+
+    size_t get_num_adapters() const {
+        OPENVINO_ASSERT(current_config.get_mode() == AdapterConfig::MODE_MULTI, "The number of per-request adapters is available in AdapterConfig::MODE_MULTI only");
+        return current_config.get_adapters().size();
+    }
+
+    void set_new_adapter_alphas (ov::InferRequest& infer_request) {
+        set_new_adapter_tensors(infer_request, true);
+    }
+
+    // Sets state tensors for all LoRA variables for the current config. A and B are taken from the cache of prepared state tensors
+    // or evaluated and cached if the current set of adapters is not in the cache. Alphas are always computed on host as they are tiny.
+    // If `alphas_only` is true, only alpha tensors are set assuming that the set of adapters is not changed since the last call.
+    void set_new_adapter_tensors (ov::InferRequest& infer_request, bool alphas_only = false) {
+        if(!is_state_mode()) {
+            return;
+        }
+
+        auto weight_getters = make_weight_getters(current_config);
 
         auto state = infer_request.query_state();
 
@@ -932,7 +1660,10 @@ struct AdapterControllerImpl {
             state_name_to_index[name] = i;
         }
 
-        for(const auto& lora_var_ids : variable_ids) {
+        const LoRAStateTensors* state_tensors = alphas_only ? nullptr : &get_state_tensors(current_config, weight_getters);
+
+        for(size_t i = 0; i < variable_ids.size(); ++i) {
+            const auto& lora_var_ids = variable_ids[i];
             // FIXME: Remove this mapping when the order of state will be the same as the order of variables
             LoRAIndices lora_indices;
             lora_indices.alpha = state_name_to_index.at(lora_var_ids.alpha.variable_id);
@@ -940,12 +1671,60 @@ struct AdapterControllerImpl {
             lora_indices.B = state_name_to_index.at(lora_var_ids.B.variable_id);
             lora_indices.name = lora_var_ids.name;  // TODO: Redundant?
 
-            set_lora_tensors(state, lora_var_ids, lora_indices, weight_getters);
+            state[lora_indices.alpha].set_state(alpha_tensor(lora_indices.name, weight_getters));
+            if(state_tensors) {
+                state[lora_indices.A].set_state((*state_tensors)[i].A);
+                state[lora_indices.B].set_state((*state_tensors)[i].B);
+            }
         }
     }
 
-     std::vector<LoRAWeight> collect_applicable_tensors (const std::string& lora_name, const std::vector<LoRAWeightGetter>& weight_getters) {
-        const auto& adapters = current_config.get_adapters();
+    std::list<StateCacheEntry>::iterator find_state_tensors(const std::vector<Adapter>& adapters) {
+        return std::find_if(state_cache.begin(), state_cache.end(), [&adapters](const StateCacheEntry& entry) {
+            return entry.first == adapters;
+        });
+    }
+
+    // Returns A and B state tensors for all LoRA variables for a set of adapters from a given config, alphas are not used as they are set separately.
+    // As the controller is bound to a single model, the set of adapters is the only key needed to identify the prepared tensors.
+    // On a cache miss, all LoRA weight groups are submitted for asynchronous evaluation and waited together.
+    const LoRAStateTensors& get_state_tensors(const AdapterConfig& config, const std::vector<LoRAWeightGetter>& weight_getters) {
+        const auto& adapters = config.get_adapters();
+        auto it = find_state_tensors(adapters);
+        if(it != state_cache.end()) {
+            state_cache.splice(state_cache.begin(), state_cache, it);
+            return state_cache.front().second;
+        }
+        return add_state_tensors(adapters, evaluate_state_tensors(config, weight_getters));
+    }
+
+    // Evaluates A and B state tensors for all LoRA variables without touching state_cache, can be called in background
+    LoRAStateTensors evaluate_state_tensors(const AdapterConfig& config, const std::vector<LoRAWeightGetter>& weight_getters) {
+        std::lock_guard<std::mutex> lock(evaluators_mutex);
+        LoRAStateTensors state_tensors;
+        state_tensors.reserve(variable_ids.size());
+        for(const auto& lora_var_ids : variable_ids) {
+            LoRAParts<ov::Tensor> lora_state_tensors{
+                ov::Tensor(lora_var_ids.alpha.data_type, dynamic_to_static(lora_var_ids.alpha.data_shape)),
+                ov::Tensor(lora_var_ids.A.data_type, dynamic_to_static(lora_var_ids.A.data_shape)),
+                ov::Tensor(lora_var_ids.B.data_type, dynamic_to_static(lora_var_ids.B.data_shape))
+            };
+            state_tensors.push_back(prepare_lora_tensors(lora_var_ids.name, config, weight_getters, lora_state_tensors));
+        }
+        lora_state_evaluators.wait();
+        return state_tensors;
+    }
+
+    const LoRAStateTensors& add_state_tensors(std::vector<Adapter> adapters, LoRAStateTensors&& state_tensors) {
+        state_cache.emplace_front(std::move(adapters), std::move(state_tensors));
+        while(state_cache.size() > state_cache_capacity) {
+            state_cache.pop_back();
+        }
+        return state_cache.front().second;
+    }
+
+     std::vector<LoRAWeight> collect_applicable_tensors (const std::string& lora_name, const AdapterConfig& config, const std::vector<LoRAWeightGetter>& weight_getters) {
+        const auto& adapters = config.get_adapters();
         OPENVINO_ASSERT(weight_getters.size() == adapters.size());
         std::vector<LoRAWeight> result;
         result.reserve(weight_getters.size());
@@ -954,7 +1733,7 @@ struct AdapterControllerImpl {
                 // FIXME: Introduce more flexible logic of setting alpha based on alpha set in the adapter file itself, now it is ignored and only alpha from config is used
                 OPENVINO_ASSERT(lora_tensors->A);
                 OPENVINO_ASSERT(lora_tensors->B);
-                lora_tensors->alpha = alpha_as_constant(current_config.get_alpha(adapters[i]));
+                lora_tensors->alpha = alpha_as_constant(config.get_alpha(adapters[i]));
                 result.push_back(LoRAWeight(
                     std::dynamic_pointer_cast<v0::Constant>(lora_tensors->alpha),
                     std::dynamic_pointer_cast<v0::Constant>(lora_tensors->A),
@@ -1065,9 +1844,6 @@ struct AdapterControllerImpl {
 
         #else
 
-        // TODO: As ov::Tensor lacks a convenient constructor to fill all elements with the same scalar value, do it via Constant that has such constructor
-        // FIXME: It's a huge overhead for setting just a scalar 0
-
         ov::Shape
             alpha_shape{1, 1},
             A_shape{1, outputs.A.get_shape()[1]},
@@ -1076,10 +1852,11 @@ struct AdapterControllerImpl {
         outputs.alpha.set_shape(alpha_shape);
         outputs.A.set_shape(A_shape);
         outputs.B.set_shape(B_shape);
-        std::make_shared<v0::Constant>(outputs.alpha.get_element_type(), alpha_shape, 0)->get_tensor_view().copy_to(outputs.alpha);
-        // Element values for A and B don't matter as we are multiplying by 0 in alpha anyway
-        std::make_shared<v0::Constant>(outputs.A.get_element_type(), A_shape, 0)->get_tensor_view().copy_to(outputs.A);
-        std::make_shared<v0::Constant>(outputs.B.get_element_type(), B_shape, 0)->get_tensor_view().copy_to(outputs.B);
+        // Zero bit pattern is zero value for all floating point types that are used for LoRA state
+        std::memset(outputs.alpha.data(), 0, outputs.alpha.get_byte_size());
+        // Element values for A and B don't matter as we are multiplying by 0 in alpha anyway, but keep them initialized
+        std::memset(outputs.A.data(), 0, outputs.A.get_byte_size());
+        std::memset(outputs.B.data(), 0, outputs.B.get_byte_size());
 
         #endif
 
@@ -1126,7 +1903,11 @@ struct AdapterControllerImpl {
             lora_state_evaluators.insert(signature, std::make_shared<ov::Model>(results, parameters));
         }
         auto output_tensors = to_tensor_vector(outputs);
-        lora_state_evaluators.evaluate(signature, to_tensor_vector(inputs), output_tensors);
+        // Input tensors are views of the constants, alpha constants are temporary and owned by `inputs` only,
+        // so a copy of `inputs` is held by the evaluator until the evaluation is finished.
+        auto inputs_owner = std::make_shared<const std::vector<LoRAWeight>>(inputs);
+        // Outputs are ready after lora_state_evaluators.wait() is called
+        lora_state_evaluators.evaluate_async(signature, to_tensor_vector(*inputs_owner), output_tensors, inputs_owner);
         return outputs;
     }
 
@@ -1138,26 +1919,44 @@ struct AdapterControllerImpl {
         return shape;
     }
 
-    void set_lora_tensors(std::vector<VariableState>& state, const LoRAVarIDs& lora_var_ids, const LoRAIndices& lora_indices, const std::vector<LoRAWeightGetter>& weight_getters) {
-        LoRAParts<ov::Tensor> lora_state_tensors{
-            ov::Tensor(lora_var_ids.alpha.data_type, dynamic_to_static(lora_var_ids.alpha.data_shape)),
-            ov::Tensor(lora_var_ids.A.data_type, dynamic_to_static(lora_var_ids.A.data_shape)),
-            ov::Tensor(lora_var_ids.B.data_type, dynamic_to_static(lora_var_ids.B.data_shape))
-        };
-        auto new_tensors = prepare_lora_tensors(lora_indices.name, weight_getters, lora_state_tensors);
-
-        state[lora_indices.alpha].set_state(new_tensors.alpha);
-        state[lora_indices.A].set_state(new_tensors.A);
-        state[lora_indices.B].set_state(new_tensors.B);
+    // Builds alpha state tensor on host, the layout of columns follows the order of adapters used in collect_applicable_tensors.
+    // In AdapterConfig::MODE_MULTI it is a matrix of shape [number of adapters, accumulated rank] that has 1 in i-th row for columns
+    // occupied by i-th adapter in the stacked A and B, otherwise it is [1, accumulated rank] filled with the alpha of a corresponding adapter.
+    ov::Tensor alpha_tensor(const std::string& name, const std::vector<LoRAWeightGetter>& weight_getters) {
+        const auto& adapters = current_config.get_adapters();
+        OPENVINO_ASSERT(weight_getters.size() == adapters.size());
+        std::vector<size_t> ranks(weight_getters.size(), 0);
+        for(size_t i = 0; i < weight_getters.size(); ++i) {
+            if(auto lora_tensors = weight_getters[i](name)) {
+                ranks[i] = lora_tensors->A->get_output_partial_shape(0)[0].get_length();
+            }
+        }
+        size_t total_rank = std::accumulate(ranks.begin(), ranks.end(), size_t(0));
+        bool selector = current_config.get_mode() == AdapterConfig::MODE_MULTI;
+        // Zero rank happens when there are no adapters for a given layer, then 1-rank empty adapters are set for A and B with zero alpha
+        ov::Tensor alpha(ov::element::f32, ov::Shape{selector ? adapters.size() : 1, std::max<size_t>(total_rank, 1)});
+        float* alpha_data = alpha.data<float>();
+        std::fill_n(alpha_data, alpha.get_size(), 0.0f);
+        for(size_t i = 0, column = 0; i < ranks.size(); column += ranks[i], ++i) {
+            if(selector) {
+                std::fill_n(alpha_data + i*alpha.get_shape()[1] + column, ranks[i], 1.0f);
+            } else {
+                // FIXME: Introduce more flexible logic of setting alpha based on alpha set in the adapter file itself, now it is ignored and only alpha from config is used
+                std::fill_n(alpha_data + column, ranks[i], current_config.get_alpha(adapters[i]));
+            }
+        }
+        return alpha;
     }
 
+    // Output tensors are ready to be used after lora_state_evaluators.wait() is called
     LoRAParts<ov::Tensor> prepare_lora_tensors (
         const std::string& name,
+        const AdapterConfig& config,
         const std::vector<LoRAWeightGetter>& weight_getters,
         LoRAParts<ov::Tensor>& output,
         bool set_empty_adapters = true
     ) {
-        auto lora_tensors = collect_applicable_tensors(name, weight_getters);
+        auto lora_tensors = collect_applicable_tensors(name, config, weight_getters);
         LoRAParts<ov::Tensor> new_tensors;
         if(!lora_tensors.empty()) {
             new_tensors = concat_adapters(lora_tensors, output);
@@ -1221,6 +2020,25 @@ void AdapterController::force_full_apply(bool full_apply) {
 }
 
 
+void AdapterController::prepare(const AdapterConfig& config) {
+    if (m_pimpl) {
+        m_pimpl->prepare(config);
+    }
+}
+
+
+std::vector<float> AdapterController::get_alphas(const AdapterConfig& config) const {
+    OPENVINO_ASSERT(m_pimpl, "AdapterController is not configured to use adapters");
+    return m_pimpl->get_alphas(config);
+}
+
+
+size_t AdapterController::get_num_adapters() const {
+    OPENVINO_ASSERT(m_pimpl, "AdapterController is not configured to use adapters");
+    return m_pimpl->get_num_adapters();
+}
+
+
 void AdapterConfig::set_mode(Mode _mode) {
     mode = _mode;
 }
@@ -8,6 +8,12 @@
 namespace ov {
 namespace genai {
 
+// Names of the model inputs that are added to the model when AdapterConfig::MODE_MULTI is used:
+// indices of registered adapters used by at least one token of an inference, at least one index is required,
+// and per-token alphas of shape [number of tokens, number of active adapters] in the order of the indices.
+inline constexpr char LORA_ACTIVE_ADAPTERS_INPUT_NAME[] = "lora_active_adapters";
+inline constexpr char LORA_PER_TOKEN_ALPHAS_INPUT_NAME[] = "lora_per_token_alphas";
+
 // Search for `adapters` property in `properties` map. If it is found and `adapter_config` is not nullptr,
 // set `adapter_config` with found value, and return a copy of `properties` with the `adapters` property removed.
 // If there is no `adapters` property, `adapter_config` is left unchanged and std::nullopt is returned.
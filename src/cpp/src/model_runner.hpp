@@ -8,12 +8,15 @@
 
 #include <openvino/runtime/infer_request.hpp>
 
+#include "openvino/genai/lora_adapter.hpp"
+
 #include "debug_utils.hpp"
 #include "sequence_group.hpp"
 #include "scheduler.hpp"
 #include "timer.hpp"
 
 #include "attention_output.hpp"
+#include "lora_helper.hpp"
 
 namespace ov::genai {
 
@@ -33,6 +36,13 @@ class ModelRunner {
     AttentionScoresForEachSubsequence m_last_attention_scores;
     size_t m_num_decoder_layers;
     bool m_collect_attention_scores;
+    std::optional<AdapterController> m_adapter_controller;
+    size_t m_num_adapters = 0;
+    std::optional<ov::InferRequest> m_embedding;
+    float m_scale_emb = 1.0f;
+    size_t m_hidden_size = 0;
+    // inputs_embeds is either [tokens, hidden_size] or [tokens, 1, hidden_size] depending on the model
+    bool m_inputs_embeds_with_seq_len = false;
 public:
     /**
      * Constructs the ModelRunner.
@@ -57,6 +67,30 @@ public:
         return m_request;
     }
 
+    /**
+     * Enables per-request LoRA adapters. The controller should be created in AdapterConfig::MODE_MULTI for the model of the handled
+     * infer request, then each `forward` call sets per-token alphas based on GenerationConfig::adapters of the scheduled sequence groups.
+     * @param adapter_controller The controller that was used to inject adapters into the model.
+     */
+    void set_adapter_controller(const AdapterController& adapter_controller) {
+        m_adapter_controller = adapter_controller;
+        m_num_adapters = m_adapter_controller->get_num_adapters();
+    }
+
+    /**
+     * Makes the handled model be fed with inputs_embeds instead of input_ids, e.g. for a language model of a visual language
+     * model. Prompt tokens of sequence groups having prompt embeddings take rows of these embeddings, all other scheduled tokens
+     * are embedded by a single inference of the embedding model per `forward` call.
+     * @param embedding The ov::InferRequest for a model taking input_ids [1, N] and returning embeddings [1, N, hidden_size].
+     * @param scale_emb A factor the output of the embedding model is multiplied by.
+     */
+    void set_embedding_model(ov::InferRequest embedding, float scale_emb = 1.0f) {
+        m_hidden_size = embedding.get_compiled_model().output().get_partial_shape()[2].get_length();
+        m_inputs_embeds_with_seq_len = m_request.get_compiled_model().input("inputs_embeds").get_partial_shape().rank().get_length() == 3;
+        m_embedding = std::move(embedding);
+        m_scale_emb = scale_emb;
+    }
+
     /**
      * @return A map of sequence IDs to vectors of ov::Tensor per-token attention scores. Each vector element is associated with its own
      * decoder layer, in order of their execution in the model. Each ov::Tensor has a shape of {N_k}, where N_k is the length of
@@ -102,6 +136,54 @@ public:
 
         max_context_len.data<int32_t>()[0] = max_context_len_val;
 
+        // inputs_embeds specific parameters: rows of prompt embeddings are copied directly, other tokens are collected to
+        // be embedded together after the loop
+        ov::Tensor inputs_embeds;
+        float* inputs_embeds_data = nullptr;
+        std::vector<int64_t> ids_to_embed;
+        std::vector<size_t> rows_to_embed;
+        const int64_t* input_ids_begin = input_ids.data<int64_t>();
+        if (m_embedding) {
+            inputs_embeds = m_inputs_embeds_with_seq_len ?
+                ov::Tensor(ov::element::f32, {total_num_tokens, 1, m_hidden_size}) :
+                ov::Tensor(ov::element::f32, {total_num_tokens, m_hidden_size});
+            inputs_embeds_data = inputs_embeds.data<float>();
+        }
+
+        // LoRA specific parameters: adapters used by at least one scheduled request and their alphas for each token,
+        // the model computes only the adapters listed in lora_active_adapters
+        std::vector<std::vector<float>> group_lora_alphas;
+        ov::Tensor lora_active_adapters;
+        ov::Tensor lora_per_token_alphas;
+        float* lora_per_token_alphas_data = nullptr;
+        if (m_adapter_controller) {
+            std::vector<int64_t> active_adapters;
+            std::vector<bool> is_active(m_num_adapters, false);
+            for (size_t i = 0; i < num_sequence_groups; ++i) {
+                size_t seq_group_id = scheduler_output.m_scheduled_sequence_groups_ids[i];
+                group_lora_alphas.push_back(
+                    m_adapter_controller->get_alphas(sequence_groups[seq_group_id]->get_sampling_parameters().adapters));
+                for (size_t adapter = 0; adapter < m_num_adapters; ++adapter) {
+                    is_active[adapter] = is_active[adapter] || group_lora_alphas.back()[adapter] != 0.0f;
+                }
+            }
+            for (size_t adapter = 0; adapter < m_num_adapters; ++adapter) {
+                if (is_active[adapter]) {
+                    active_adapters.push_back(adapter);
+                }
+            }
+            // the model requires at least one active adapter, its zero alphas keep the output unchanged
+            if (active_adapters.empty()) {
+                active_adapters.push_back(0);
+            }
+            lora_active_adapters = ov::Tensor(ov::element::i64, {active_adapters.size()});
+            std::copy(active_adapters.begin(), active_adapters.end(), lora_active_adapters.data<int64_t>());
+            lora_per_token_alphas = ov::Tensor(ov::element::f32, {total_num_tokens, active_adapters.size()});
+            lora_per_token_alphas_data = lora_per_token_alphas.data<float>();
+        }
+        const int64_t* active_adapters_begin = lora_active_adapters ? lora_active_adapters.data<int64_t>() : nullptr;
+        const size_t num_active_adapters = lora_active_adapters ? lora_active_adapters.get_size() : 0;
+
         // get raw pointers to copy to
         int64_t
             * input_ids_data = input_ids.data<int64_t>(),
@@ -137,6 +219,26 @@ public:
                         sequence->get_generated_ids()[position_id - sequence_group->get_prompt_len()];
 
                     position_ids_data[token_id] = position_id;
+
+                    if (m_embedding) {
+                        size_t row = input_ids_data + token_id - input_ids_begin;
+                        if (position_id < sequence_group->get_prompt_len() && sequence_group->has_prompt_embeds()) {
+                            std::copy_n(sequence_group->get_prompt_embeds().data<float>() + position_id * m_hidden_size,
+                                        m_hidden_size, inputs_embeds_data + row * m_hidden_size);
+                        } else {
+                            ids_to_embed.push_back(input_ids_data[token_id]);
+                            rows_to_embed.push_back(row);
+                        }
+                    }
+                }
+
+                if (m_adapter_controller) {
+                    for (size_t token_id = 0; token_id < num_scheduled_tokens; ++token_id) {
+                        for (size_t k = 0; k < num_active_adapters; ++k) {
+                            lora_per_token_alphas_data[k] = group_lora_alphas[i][active_adapters_begin[k]];
+                        }
+                        lora_per_token_alphas_data += num_active_adapters;
+                    }
                 }
 
                 size_t expected_kv_cache_size = sequence_group->get_num_processed_tokens() - sequence_group->get_num_evicted_tokens();
@@ -157,7 +259,14 @@ public:
         }
 
         // typical LLM parameters
-        m_request.set_tensor("input_ids", input_ids);
+        if (m_embedding) {
+            if (!ids_to_embed.empty()) {
+                _embed(ids_to_embed, rows_to_embed, inputs_embeds_data);
+            }
+            m_request.set_tensor("inputs_embeds", inputs_embeds);
+        } else {
+            m_request.set_tensor("input_ids", input_ids);
+        }
         m_request.set_tensor("position_ids", position_ids);
 
         // PA specific parameters
@@ -169,6 +278,11 @@ public:
         m_request.set_tensor("block_indices_begins", block_indices_begins);
         m_request.set_tensor("max_context_len", max_context_len);
 
+        if (m_adapter_controller) {
+            m_request.set_tensor(LORA_ACTIVE_ADAPTERS_INPUT_NAME, lora_active_adapters);
+            m_request.set_tensor(LORA_PER_TOKEN_ALPHAS_INPUT_NAME, lora_per_token_alphas);
+        }
+
         // print_tensor("input_ids", input_ids);
         // print_tensor("position_ids", position_ids);
 
@@ -194,6 +308,21 @@ public:
     }
 
 private:
+    void _embed(const std::vector<int64_t>& ids, const std::vector<size_t>& rows, float* inputs_embeds_data) {
+        ov::Tensor embedding_input(ov::element::i64, {1, ids.size()}, const_cast<int64_t*>(ids.data()));
+        m_embedding->set_input_tensor(embedding_input);
+        m_embedding->infer();
+        const ov::Tensor& embeds = m_embedding->get_output_tensor();
+        OPENVINO_ASSERT(embeds.get_size() == ids.size() * m_hidden_size, "Unexpected output shape of the embedding model");
+        const float* embeds_data = embeds.data<float>();
+        for (size_t i = 0; i < rows.size(); ++i) {
+            float* row_data = inputs_embeds_data + rows[i] * m_hidden_size;
+            for (size_t j = 0; j < m_hidden_size; ++j) {
+                row_data[j] = embeds_data[i * m_hidden_size + j] * m_scale_emb;
+            }
+        }
+    }
+
     void _set_block_indices(ov::InferRequest& infer_request, const std::vector<SequenceGroup::Ptr> & sequence_groups, const Scheduler::Output& scheduler_output,
                             size_t total_num_blocks) {
         size_t num_sequence_groups = scheduler_output.m_scheduled_sequence_groups_ids.size();
@@ -191,6 +191,9 @@ class SequenceGroup {
     ov::genai::GenerationConfig m_sampling_params;
     std::size_t m_block_size;
     TokenIds m_prompt_ids;
+    // [1, prompt_len, hidden_size] embeddings replacing embeddings of m_prompt_ids, e.g. merged text and image
+    // embeddings of visual language models
+    ov::Tensor m_prompt_embeds;
     GenerationStream::Ptr m_generation_stream;
     bool m_enable_prefix_caching;
     size_t m_num_evicted_tokens = 0;
@@ -470,6 +473,34 @@ public:
         return m_prompt_ids;
     }
 
+    /**
+     * Sets embeddings of the prompt which are passed to the model instead of embeddings of prompt ids. Prompt ids are
+     * replaced by `prompt_ids`, so penalties and n-gram checks of Sampler see the text tokens of the prompt. Prefix
+     * caching must be disabled for the group.
+     * @param prompt_embeds [1, prompt_len, hidden_size] tensor. It's kept as is, so it must not be modified afterwards.
+     * @param prompt_ids [1, prompt_len] tensor of tokens embedded in prompt_embeds. Negative ids mark rows which don't
+     * correspond to a token, e.g. image features, and are ignored by Sampler.
+     */
+    void set_prompt_embeds(const ov::Tensor& prompt_embeds, const ov::Tensor& prompt_ids) {
+        OPENVINO_ASSERT(!m_enable_prefix_caching, "Prompt embeddings are not compatible with prefix caching");
+        OPENVINO_ASSERT(m_num_processed_tokens == 0, "Prompt embeddings must be set before the prompt is processed");
+        OPENVINO_ASSERT(prompt_embeds.get_shape().size() == 3 && prompt_embeds.get_shape()[0] == 1,
+                        "Prompt embeddings must have [1, prompt_len, hidden_size] shape");
+        OPENVINO_ASSERT(prompt_ids.get_size() == prompt_embeds.get_shape()[1],
+                        "Prompt ids must have the same length as prompt embeddings");
+        m_prompt_embeds = prompt_embeds;
+        m_prompt_ids.resize(prompt_ids.get_size());
+        std::copy_n(prompt_ids.data<const int64_t>(), prompt_ids.get_size(), m_prompt_ids.begin());
+    }
+
+    bool has_prompt_embeds() const {
+        return static_cast<bool>(m_prompt_embeds);
+    }
+
+    const ov::Tensor& get_prompt_embeds() const {
+        return m_prompt_embeds;
+    }
+
     /**
      * @return The number of logical KV cache blocks required to host all the tokens in this sequence group, taking into account previous token evictions.
      */
@@ -22,6 +22,7 @@
 #include "clip.hpp"
 
 #include <openvino/openvino.hpp>
+#include <openvino/core/parallel.hpp>
 
 struct clip_hparams {
     int32_t image_size;
@@ -39,43 +40,123 @@ struct clip_hparams {
     int32_t image_crop_resolution;
 };
 
-// Linear interpolation between two points
-inline float clip_lerp(float s, float e, float t) {
-    return s + (e - s) * t;
+namespace {
+// Source samples and their weights for every destination position of
+// a 1D resampling, taps_per_output entries per position.
+struct ResampleTaps {
+    size_t taps_per_output;
+    std::vector<int> index;
+    std::vector<float> weight;
+};
+
+// Cubic Lagrange interpolation through samples at -1, 0, 1 and 2
+// evaluated at t in [0, 1), the same polynomial bicubic_resize() used
+// to build from differences of neighbouring samples for every pixel.
+ResampleTaps cubic_taps(int src_size, int dst_size) {
+    ResampleTaps taps{4, std::vector<int>(4 * dst_size), std::vector<float>(4 * dst_size)};
+    const float ratio = float(src_size) / float(dst_size);
+    for (int dst = 0; dst < dst_size; ++dst) {
+        const int base = int(ratio * dst);
+        const float t = ratio * dst - base;
+        const float weights[4] = {
+            -t * (t - 1.0f) * (t - 2.0f) / 6.0f,
+            (t + 1.0f) * (t - 1.0f) * (t - 2.0f) / 2.0f,
+            -(t + 1.0f) * t * (t - 2.0f) / 2.0f,
+            (t + 1.0f) * t * (t - 1.0f) / 6.0f
+        };
+        for (int tap = 0; tap < 4; ++tap) {
+            taps.index[4 * dst + tap] = std::min(std::max(base - 1 + tap, 0), src_size - 1);
+            taps.weight[4 * dst + tap] = weights[tap];
+        }
+    }
+    return taps;
 }
-// Bilinear resize function
-static void bilinear_resize(const clip_image_u8& src, clip_image_u8& dst, int target_width, int target_height) {
-    dst.nx = target_width;
-    dst.ny = target_height;
-    dst.buf.resize(3 * target_width * target_height);
 
-    float x_ratio = static_cast<float>(src.nx - 1) / target_width;
-    float y_ratio = static_cast<float>(src.ny - 1) / target_height;
+ResampleTaps linear_taps(int src_size, int dst_size) {
+    ResampleTaps taps{2, std::vector<int>(2 * dst_size), std::vector<float>(2 * dst_size)};
+    const float ratio = float(src_size - 1) / float(dst_size);
+    for (int dst = 0; dst < dst_size; ++dst) {
+        const float position = ratio * dst;
+        const int base = int(position);
+        const float t = position - base;
+        taps.index[2 * dst] = base;
+        taps.index[2 * dst + 1] = std::min(base + 1, src_size - 1);
+        taps.weight[2 * dst] = 1.0f - t;
+        taps.weight[2 * dst + 1] = t;
+    }
+    return taps;
+}
 
-    for (int y = 0; y < target_height; y++) {
-        for (int x = 0; x < target_width; x++) {
-            float px = x_ratio * x;
-            float py = y_ratio * y;
-            int x_floor = static_cast<int>(px);
-            int y_floor = static_cast<int>(py);
-            float x_lerp = px - x_floor;
-            float y_lerp = py - y_floor;
+// Separable resize of an RGB image: source rows used by the vertical
+// taps are resampled horizontally once into a float buffer, then every
+// destination row is a weighted sum of contiguous float rows. Both
+// passes are parallel over rows.
+void separable_resize(
+    const clip_image_u8& src,
+    clip_image_u8& dst,
+    int target_width,
+    int target_height,
+    const ResampleTaps& horizontal,
+    const ResampleTaps& vertical,
+    bool round_result
+) {
+    const size_t row_size = 3 * size_t(target_width);
+    std::vector<int> row_slot(src.ny, -1);
+    std::vector<int> slot_row;
+    for (int src_row : vertical.index) {
+        if (-1 == row_slot[src_row]) {
+            row_slot[src_row] = int(slot_row.size());
+            slot_row.push_back(src_row);
+        }
+    }
+    std::vector<float> rows(slot_row.size() * row_size);
+    ov::parallel_for(slot_row.size(), [&](size_t slot) {
+        const uint8_t* src_row = src.buf.data() + 3 * size_t(slot_row[slot]) * src.nx;
+        float* row = rows.data() + slot * row_size;
+        for (int x = 0; x < target_width; ++x) {
+            const int* index = horizontal.index.data() + horizontal.taps_per_output * x;
+            const float* weight = horizontal.weight.data() + horizontal.taps_per_output * x;
+            for (int c = 0; c < 3; ++c) {
+                float sum = 0.0f;
+                for (size_t tap = 0; tap < horizontal.taps_per_output; ++tap) {
+                    sum += weight[tap] * src_row[3 * index[tap] + c];
+                }
+                row[3 * x + c] = sum;
+            }
+        }
+    });
 
-            for (int c = 0; c < 3; c++) {
-                float top = clip_lerp(
-                    static_cast<float>(src.buf[3 * (y_floor * src.nx + x_floor) + c]),
-                    static_cast<float>(src.buf[3 * (y_floor * src.nx + (x_floor + 1)) + c]),
-                    x_lerp
-                );
-                float bottom = clip_lerp(
-                    static_cast<float>(src.buf[3 * ((y_floor + 1) * src.nx + x_floor) + c]),
-                    static_cast<float>(src.buf[3 * ((y_floor + 1) * src.nx + (x_floor + 1)) + c]),
-                    x_lerp
-                );
-                dst.buf[3 * (y * target_width + x) + c] = static_cast<uint8_t>(clip_lerp(top, bottom, y_lerp));
+    dst.nx = target_width;
+    dst.ny = target_height;
+    dst.buf.resize(row_size * target_height);
+    ov::parallel_for(size_t(target_height), [&](size_t y) {
+        const int* index = vertical.index.data() + vertical.taps_per_output * y;
+        const float* weight = vertical.weight.data() + vertical.taps_per_output * y;
+        uint8_t* dst_row = dst.buf.data() + y * row_size;
+        std::vector<float> sum(row_size, 0.0f);
+        for (size_t tap = 0; tap < vertical.taps_per_output; ++tap) {
+            const float* row = rows.data() + row_slot[index[tap]] * row_size;
+            const float w = weight[tap];
+            for (size_t k = 0; k < row_size; ++k) {
+                sum[k] += w * row[k];
             }
         }
-    }
+        // Adding 0.5 to a clamped non negative value rounds it half away from zero.
+        const float bias = round_result ? 0.5f : 0.0f;
+        for (size_t k = 0; k < row_size; ++k) {
+            dst_row[k] = static_cast<uint8_t>(std::min(std::max(sum[k], 0.0f), 255.0f) + bias);
+        }
+    });
+}
+}  // namespace
+
+// Bilinear resize function
+static void bilinear_resize(const clip_image_u8& src, clip_image_u8& dst, int target_width, int target_height) {
+    separable_resize(
+        src, dst, target_width, target_height,
+        linear_taps(src.nx, target_width), linear_taps(src.ny, target_height),
+        false
+    );
 }
 
 // Normalize image to float32 - careful with pytorch .to(model.device, dtype=torch.float16) - this sometimes reduces precision (32>16>32), sometimes not
@@ -84,77 +165,29 @@ static void normalize_image_u8_to_f32(const clip_image_u8* src, clip_image_f32*
     dst->ny = src->ny;
     dst->buf.resize(src->buf.size());
 
-    for (size_t i = 0; i < src->buf.size(); ++i) {
-        int c = i % 3; // rgb
-        dst->buf[i] = (static_cast<float>(src->buf[i]) / 255.0f - mean[c]) / std[c];
+    clip_ctx ctx;
+    std::copy_n(mean, 3, ctx.image_mean);
+    std::copy_n(std, 3, ctx.image_std);
+    const auto table = clip_normalization_table(ctx);
+    const size_t n_pixels = src->buf.size() / 3;
+    for (size_t i = 0; i < n_pixels; ++i) {
+        for (size_t c = 0; c < 3; ++c) {
+            dst->buf[3 * i + c] = table[c][src->buf[3 * i + c]];
+        }
     }
 }
 
-template<typename NUM>
-NUM clip(NUM x, NUM lower, NUM upper) {
-    return std::max(lower, std::min(x, upper));
-}
-
 bool bicubic_resize(const clip_image_u8 &img, clip_image_u8 &dst, int target_width, int target_height) {
-    const int nx = img.nx;
-    const int ny = img.ny;
-
-    dst.nx = target_width;
-    dst.ny = target_height;
-    dst.buf.resize(3 * target_width * target_height);
-
-    float Cc;
-    float C[5];
-    float d0, d2, d3, a0, a1, a2, a3;
-    int i, j, k, jj;
-    int x, y;
-    float dx, dy;
-    float tx, ty;
-
-    tx = (float)nx / (float)target_width;
-    ty = (float)ny / (float)target_height;
-
     // Bicubic interpolation; adapted from ViT.cpp, inspired from :
     //    -> https://github.com/yglukhov/bicubic-interpolation-image-processing/blob/master/libimage.c#L36
     //    -> https://en.wikipedia.org/wiki/Bicubic_interpolation
-
-    for (i = 0; i < target_height; i++) {
-        for (j = 0; j < target_width; j++) {
-            x = (int)(tx * j);
-            y = (int)(ty * i);
-
-            dx = tx * j - x;
-            dy = ty * i - y;
-
-            for (k = 0; k < 3; k++) {
-                for (jj = 0; jj <= 3; jj++) {
-                    d0 = img.buf[(clip(y - 1 + jj, 0, ny - 1) * nx + clip(x - 1, 0, nx - 1)) * 3 + k] - img.buf[(clip(y - 1 + jj, 0, ny - 1) * nx + clip(x, 0, nx - 1)) * 3 + k];
-                    d2 = img.buf[(clip(y - 1 + jj, 0, ny - 1) * nx + clip(x + 1, 0, nx - 1)) * 3 + k] - img.buf[(clip(y - 1 + jj, 0, ny - 1) * nx + clip(x, 0, nx - 1)) * 3 + k];
-                    d3 = img.buf[(clip(y - 1 + jj, 0, ny - 1) * nx + clip(x + 2, 0, nx - 1)) * 3 + k] - img.buf[(clip(y - 1 + jj, 0, ny - 1) * nx + clip(x, 0, nx - 1)) * 3 + k];
-                    a0 = img.buf[(clip(y - 1 + jj, 0, ny - 1) * nx + clip(x, 0, nx - 1)) * 3 + k];
-
-                    a1 = -1.0 / 3 * d0 + d2 - 1.0 / 6 * d3;
-                    a2 =  1.0 / 2 * d0 +      1.0 / 2 * d2;
-                    a3 = -1.0 / 6 * d0 -      1.0 / 2 * d2 + 1.0 / 6 * d3;
-
-                    C[jj] = a0 + a1 * dx + a2 * dx * dx + a3 * dx * dx * dx;
-
-                    d0 = C[0] - C[1];
-                    d2 = C[2] - C[1];
-                    d3 = C[3] - C[1];
-                    a0 = C[1];
-                    a1 = -1.0 / 3 * d0 + d2 - 1.0 / 6 * d3;
-                    a2 =  1.0 / 2 * d0 +      1.0 / 2 * d2;
-                    a3 = -1.0 / 6 * d0 -      1.0 / 2 * d2 + 1.0 / 6 * d3;
-                    Cc = a0 + a1 * dy + a2 * dy * dy + a3 * dy * dy * dy;
-
-                    const uint8_t Cc2 = std::min(std::max(std::round(Cc), 0.0f), 255.0f);
-                    dst.buf[(i * target_width + j) * 3 + k] = float(Cc2);
-                }
-            }
-        }
-    }
-
+    // The interpolation is separable, so weights are computed once per
+    // destination column and row instead of once per pixel.
+    separable_resize(
+        img, dst, target_width, target_height,
+        cubic_taps(img.nx, target_width), cubic_taps(img.ny, target_height),
+        true
+    );
     return true;
 }
 
@@ -191,11 +224,11 @@ static void resize_and_pad_image(const clip_image_u8& image, clip_image_u8 &imag
 
     // Copy the resized image into the center of the padded buffer
     for (int y = 0; y < new_height; ++y) {
-        for (int x = 0; x < new_width; ++x) {
-            for (int c = 0; c < 3; ++c) {
-                padded_image.buf[3 * ((y + pad_y) * target_width + (x + pad_x)) + c] = resized_image.buf[3 * (y * new_width + x) + c];
-            }
-        }
+        std::copy_n(
+            resized_image.buf.data() + 3 * y * new_width,
+            3 * new_width,
+            padded_image.buf.data() + 3 * ((y + pad_y) * target_width + pad_x)
+        );
     }
     image_output = std::move(padded_image);
 }
@@ -233,84 +266,40 @@ static std::pair<int, int> select_best_resolution(const std::pair<int, int> & or
     return best_fit;
 }
 
+std::array<std::array<float, 256>, 3> clip_normalization_table(const clip_ctx& ctx) {
+    std::array<std::array<float, 256>, 3> table;
+    for (size_t c = 0; c < 3; ++c) {
+        for (size_t value = 0; value < 256; ++value) {
+            table[c][value] = ((float(value) / 255.0f) - ctx.image_mean[c]) / ctx.image_std[c];
+        }
+    }
+    return table;
+}
+
+void clip_image_preprocess(const clip_ctx& ctx, const clip_image_u8& img, int x0, int y0, int width, int height, float* dst) {
+    OPENVINO_ASSERT(x0 >= 0 && y0 >= 0 && x0 + width <= img.nx && y0 + height <= img.ny, "The region is out of the image");
+    const auto table = clip_normalization_table(ctx);
+    const size_t plane_size = size_t(width) * height;
+    ov::parallel_for(size_t(height), [&](size_t y) {
+        const uint8_t* src_row = img.buf.data() + 3 * ((y0 + y) * img.nx + x0);
+        for (size_t c = 0; c < 3; ++c) {
+            // rgb hwc -> chw
+            float* dst_row = dst + c * plane_size + y * width;
+            const float* channel_table = table[c].data();
+            for (int x = 0; x < width; ++x) {
+                dst_row[x] = channel_table[src_row[3 * x + c]];
+            }
+        }
+    });
+}
+
 // returns the normalized float tensor for llava-1.5, for spatial_unpad with anyres processing for llava-1.6 it returns the normalized image patch tensors as a vector
 // res_imgs memory is being allocated here, previous allocations will be freed if found
 clip_image_f32 clip_image_preprocess(clip_ctx& ctx, const clip_image_u8& img) {
-    bool pad_to_square = true;
-
-    // the logic below is to pad the shorter side to the longer side with a background color: rgb(122, 116, 104)
-    // see https://github.com/haotian-liu/LLaVA/blob/e854a2bf85118c504f6f16bf5c3c7c92f8fa8c6b/llava/conversation.py#L113-L156
-
-    clip_image_u8 temp;  // we will keep the input image data here temporarily
-    temp.nx = img.nx;
-    temp.ny = img.ny;
-    temp.buf.resize(img.buf.size());
-    memcpy(temp.buf.data(), img.buf.data(), temp.buf.size());
-
-
-    const int nx = temp.nx;
-    const int ny = temp.ny;
-    // clip_image_save_to_bmp(*temp, "resized_vanilla.bmp");
-
-    const int nx2 = temp.nx;
-    const int ny2 = temp.ny;
-
     clip_image_f32 res;
-    res.nx = nx2;
-    res.ny = ny2;
-    res.buf.resize(3 * nx2 * ny2);
-
-    // const float scale = std::max(nx, ny) / (float)ctx.vision_model.hparams.image_size;
-
-    // const int nx3 = int(nx / scale + 0.5f);
-    // const int ny3 = int(ny / scale + 0.5f);
-
-    const int nx3 = nx;
-    const int ny3 = ny;
-
-    const auto& m3 = ctx.image_mean; // {0.48145466f, 0.4578275f, 0.40821073f};
-    const auto& s3 = ctx.image_std;  // {0.26862954f, 0.26130258f, 0.27577711f};
-
-    for (int y = 0; y < ny3; y++) {
-        for (int x = 0; x < nx3; x++) {
-            for (int c = 0; c < 3; c++) {
-                // linear interpolation
-                const float sx = x;
-                const float sy = y;
-
-                const int x0 = std::max(0, (int)std::floor(sx));
-                const int y0 = std::max(0, (int)std::floor(sy));
-
-                const int x1 = std::min(x0 + 1, nx - 1);
-                const int y1 = std::min(y0 + 1, ny - 1);
-
-                const float dx = sx - x0;
-                const float dy = sy - y0;
-
-                const int j00 = 3 * (y0 * nx + x0) + c;
-                const int j01 = 3 * (y0 * nx + x1) + c;
-                const int j10 = 3 * (y1 * nx + x0) + c;
-                const int j11 = 3 * (y1 * nx + x1) + c;
-
-                const float v00 = temp.buf[j00];
-                const float v01 = temp.buf[j01];
-                const float v10 = temp.buf[j10];
-                const float v11 = temp.buf[j11];
-
-                const float v0 = v00 * (1.0f - dx) + v01 * dx;
-                const float v1 = v10 * (1.0f - dx) + v11 * dx;
-
-                const float v = v0 * (1.0f - dy) + v1 * dy;
-
-                const uint8_t v2 = std::min(std::max(std::round(v), 0.0f), 255.0f);
-
-                //rgb hwc ->chw
-                //const int i = 3 * (y * nx3 + x) + c;
-                const int i = (y * nx3 + x) + c * nx3 * ny3;
-
-                res.buf[i] = ((float(v2) / 255.0f) - m3[c]) / s3[c];
-            }
-        }
-    }
+    res.nx = img.nx;
+    res.ny = img.ny;
+    res.buf.resize(3 * size_t(img.nx) * img.ny);
+    clip_image_preprocess(ctx, img, 0, 0, img.nx, img.ny, res.buf.data());
     return res;
 }
@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <array>
+#include <cstdint>
 #include <vector>
 #include <numeric>
 
@@ -52,3 +54,9 @@ bool bicubic_resize(const clip_image_u8& img, clip_image_u8& dst, int target_wid
 
 /** preprocess img and store the result in res_imgs, pad_to_square may be overriden to false depending on model configuration */
 clip_image_f32 clip_image_preprocess(struct clip_ctx& ctx, const clip_image_u8& img);
+
+/** normalized values (v / 255 - image_mean[c]) / image_std[c] of every uint8 value v for every channel c */
+std::array<std::array<float, 256>, 3> clip_normalization_table(const clip_ctx& ctx);
+
+/** normalize a width x height region of img starting at (x0, y0) and store it to dst in CHW layout, dst must hold 3 * width * height values */
+void clip_image_preprocess(const clip_ctx& ctx, const clip_image_u8& img, int x0, int y0, int width, int height, float* dst);
@@ -0,0 +1,237 @@
+// Copyright (C) 2023-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "visual_language/continuous_batching.hpp"
+#include "device_config.hpp"
+#include "paged_attention_transformations.hpp"
+#include "utils.hpp"
+
+using namespace ov::genai;
+
+namespace {
+ov::Tensor copy_image(const ov::Tensor& image) {
+    ov::Tensor copy{image.get_element_type(), image.get_shape()};
+    image.copy_to(copy);
+    return copy;
+}
+}  // namespace
+
+VLMContinuousBatchingEngine::VLMContinuousBatchingEngine(
+    const std::filesystem::path& language_model_path,
+    const std::filesystem::path& embedding_model_path,
+    float scale_emb,
+    const SchedulerConfig& scheduler_config,
+    const std::string& device,
+    const ov::AnyMap& compile_config,
+    const Tokenizer& tokenizer,
+    Embedder embedder
+) : m_tokenizer{tokenizer}, m_embedder{std::move(embedder)}, m_scale_emb{scale_emb} {
+    ov::Core core;
+    auto [core_config, compile_plugin_config] = utils::split_core_complile_config(compile_config);
+    core.set_property(core_config);
+    std::shared_ptr<ov::Model> model = core.read_model(language_model_path);
+    DeviceConfig device_config(core, scheduler_config, device, compile_plugin_config);
+    apply_paged_attention_transformations(model, device_config);
+    ov::InferRequest infer_request = core.compile_model(
+        model, device_config.get_device(), compile_plugin_config
+    ).create_infer_request();
+
+    m_cache_manager = std::make_shared<CacheManager>(device_config, core);
+    for (size_t decoder_layer_id = 0; decoder_layer_id < device_config.get_num_layers(); ++decoder_layer_id) {
+        infer_request.set_tensor(std::string("key_cache.") + std::to_string(decoder_layer_id), m_cache_manager->get_key_cache(decoder_layer_id));
+        infer_request.set_tensor(std::string("value_cache.") + std::to_string(decoder_layer_id), m_cache_manager->get_value_cache(decoder_layer_id));
+    }
+
+    SchedulerConfig updated_config = scheduler_config;
+    updated_config.num_kv_blocks = device_config.get_num_kv_blocks();
+    // Cache eviction relies on attention scores outputs which aren't
+    // requested from the transformations. Prefix caching hashes prompt
+    // ids which don't identify images.
+    updated_config.use_cache_eviction = false;
+    updated_config.enable_prefix_caching = false;
+
+    m_scheduler = std::make_shared<Scheduler>(updated_config, device_config.get_num_layers());
+    m_model_runner = std::make_shared<ModelRunner>(infer_request, updated_config, device_config.get_num_layers());
+    // Separate infer requests, so decoding doesn't wait for prompts
+    // being embedded.
+    ov::CompiledModel embedding = core.compile_model(
+        embedding_model_path, device_config.get_device(), compile_plugin_config
+    );
+    m_model_runner->set_embedding_model(embedding.create_infer_request(), scale_emb);
+    m_prompt_embedding = embedding.create_infer_request();
+    m_sampler = std::make_shared<Sampler>(m_tokenizer);
+}
+
+VLMContinuousBatchingEngine::~VLMContinuousBatchingEngine() {
+    std::lock_guard<std::mutex> lock{m_awaiting_requests_mutex};
+    for (const AwaitingRequest& request : m_awaiting_requests) {
+        request.prompt.wait();
+    }
+}
+
+GenerationHandle VLMContinuousBatchingEngine::add_request(
+    uint64_t request_id,
+    const std::string& prompt,
+    const std::vector<ov::Tensor>& images,
+    GenerationConfig config
+) {
+    config.set_eos_token_id(m_tokenizer.get_eos_token_id());
+    config.validate();
+    // The prompt length is set with its embeddings.
+    SequenceGroup::Ptr sequence_group = std::make_shared<SequenceGroup>(
+        request_id, ov::Tensor{ov::element::i64, {1, 0}}, config, m_scheduler->get_config().block_size, false
+    );
+    sequence_group->set_sequence_group_ptr(sequence_group);
+
+    std::vector<ov::Tensor> owned_images;
+    for (const ov::Tensor& image : images) {
+        owned_images.push_back(copy_image(image));
+    }
+    std::shared_future<PromptInputs> prompt_inputs = std::async(
+        std::launch::async,
+        [this, prompt, owned_images = std::move(owned_images)]() {
+            std::lock_guard<std::mutex> lock{m_embedder_mutex};
+            PromptInputs inputs = m_embedder(prompt, owned_images);
+            return PromptInputs{inputs.input_ids, merge_prompt_embeds(inputs)};
+        }
+    ).share();
+    {
+        std::lock_guard<std::mutex> lock{m_awaiting_requests_mutex};
+        m_awaiting_requests.push_back({sequence_group, prompt_inputs});
+    }
+    return std::make_shared<GenerationHandleImpl>(sequence_group->get_generation_stream(), config);
+}
+
+bool VLMContinuousBatchingEngine::has_non_finished_requests() {
+    std::lock_guard<std::mutex> lock{m_awaiting_requests_mutex};
+    return !m_awaiting_requests.empty() || !m_requests.empty();
+}
+
+void VLMContinuousBatchingEngine::step() {
+    pull_embedded_requests();
+    if (m_requests.empty()) {
+        return;
+    }
+
+    Scheduler::Output scheduler_output = m_scheduler->schedule(m_requests);
+    m_cache_manager->copy_blocks(scheduler_output.m_block_copy_map);
+
+    // If no tokens were scheduled, we are out of memory.
+    if (scheduler_output.m_total_num_scheduled_tokens == 0) {
+        for (SequenceGroup::Ptr& sequence_group : m_requests) {
+            sequence_group->set_out_of_memory();
+            sequence_group->notify_handle();
+        }
+        free_non_running_requests();
+        return;
+    }
+
+    ov::Tensor logits = m_model_runner->forward(m_requests, scheduler_output);
+    SamplerOutput sampler_output = m_sampler->sample(m_requests, logits);
+    for (const auto& [parent_id, child_ids] : sampler_output.m_forked_sequences) {
+        for (uint64_t child_id : child_ids) {
+            m_scheduler->fork_sequence(parent_id, child_id);
+        }
+    }
+    for (uint64_t seq_id : sampler_output.m_dropped_sequences) {
+        m_scheduler->free_sequence(seq_id);
+    }
+    for (SequenceGroup::Ptr& sequence_group : m_requests) {
+        if (sequence_group->handle_dropped()) {
+            sequence_group->push_empty_outputs();
+        }
+    }
+    free_non_running_requests();
+}
+
+void VLMContinuousBatchingEngine::pull_embedded_requests() {
+    std::shared_future<PromptInputs> first_awaiting;
+    {
+        std::lock_guard<std::mutex> lock{m_awaiting_requests_mutex};
+        if (m_requests.empty() && !m_awaiting_requests.empty()) {
+            first_awaiting = m_awaiting_requests.front().prompt;
+        }
+    }
+    // Nothing to decode, wait for a prompt instead of spinning. Waiting
+    // without the lock lets other threads add requests meanwhile.
+    if (first_awaiting.valid()) {
+        first_awaiting.wait();
+    }
+
+    std::exception_ptr error;
+    std::lock_guard<std::mutex> lock{m_awaiting_requests_mutex};
+    auto awaiting = m_awaiting_requests.begin();
+    while (awaiting != m_awaiting_requests.end()) {
+        if (std::future_status::ready != awaiting->prompt.wait_for(std::chrono::seconds{0})) {
+            ++awaiting;
+            continue;
+        }
+        try {
+            const PromptInputs& prompt_inputs = awaiting->prompt.get();
+            awaiting->sequence_group->set_prompt_embeds(prompt_inputs.inputs_embeds, prompt_inputs.input_ids);
+            m_requests.push_back(awaiting->sequence_group);
+        } catch (...) {
+            awaiting->sequence_group->set_generation_status(GenerationStatus::DROPPED_BY_PIPELINE);
+            awaiting->sequence_group->push_empty_outputs();
+            if (!error) {
+                error = std::current_exception();
+            }
+        }
+        awaiting = m_awaiting_requests.erase(awaiting);
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+void VLMContinuousBatchingEngine::free_non_running_requests() {
+    auto requests_iterator = m_requests.begin();
+    while (requests_iterator != m_requests.end()) {
+        const SequenceGroup::Ptr& request = *requests_iterator;
+        if (request->has_finished() || request->out_of_memory() || request->handle_dropped()) {
+            for (const Sequence::Ptr& sequence : request->get_sequences()) {
+                if (m_scheduler->has_block_table(sequence->get_id())) {
+                    m_scheduler->free_sequence(sequence->get_id());
+                }
+            }
+            m_sampler->clear_beam_search_info(request->get_request_id());
+            requests_iterator = m_requests.erase(requests_iterator);
+        } else {
+            ++requests_iterator;
+        }
+    }
+}
+
+ov::Tensor VLMContinuousBatchingEngine::merge_prompt_embeds(const PromptInputs& prompt) {
+    const int64_t* ids = prompt.input_ids.data<const int64_t>();
+    size_t prompt_len = prompt.input_ids.get_size();
+    std::vector<int64_t> token_ids;
+    for (size_t pos = 0; pos < prompt_len; ++pos) {
+        if (ids[pos] >= 0) {
+            token_ids.push_back(ids[pos]);
+        }
+    }
+    size_t hidden_size = prompt.inputs_embeds.get_shape().at(2);
+    const float* token_embeds = nullptr;
+    if (!token_ids.empty()) {
+        m_prompt_embedding.set_input_tensor(ov::Tensor{ov::element::i64, {1, token_ids.size()}, token_ids.data()});
+        m_prompt_embedding.infer();
+        OPENVINO_ASSERT(m_prompt_embedding.get_output_tensor().get_size() == token_ids.size() * hidden_size,
+            "Unexpected output shape of the embedding model");
+        token_embeds = m_prompt_embedding.get_output_tensor().data<const float>();
+    }
+    ov::Tensor merged{ov::element::f32, {1, prompt_len, hidden_size}};
+    float* merged_data = merged.data<float>();
+    const float* provided_embeds = prompt.inputs_embeds.data<const float>();
+    for (size_t pos = 0; pos < prompt_len; ++pos, merged_data += hidden_size) {
+        if (ids[pos] < 0) {
+            std::copy_n(provided_embeds + pos * hidden_size, hidden_size, merged_data);
+        } else {
+            std::transform(token_embeds, token_embeds + hidden_size, merged_data, [this](float value) {
+                return value * m_scale_emb;
+            });
+            token_embeds += hidden_size;
+        }
+    }
+    return merged;
+}
@@ -0,0 +1,122 @@
+// Copyright (C) 2023-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "openvino/genai/generation_handle.hpp"
+#include "openvino/genai/scheduler_config.hpp"
+#include "openvino/genai/tokenizer.hpp"
+#include "cache_manager.hpp"
+#include "model_runner.hpp"
+#include "sampler.hpp"
+#include "scheduler.hpp"
+#include <filesystem>
+#include <functional>
+#include <future>
+#include <list>
+#include <mutex>
+
+namespace ov::genai {
+/// @brief A prompt prepared for a language model. Negative ids of
+/// input_ids [1, prompt length] take rows of inputs_embeds
+/// [1, prompt length, hidden_size] at the same positions, e.g. image
+/// features, other ids are tokens to be embedded by a token embedding
+/// model.
+struct PromptInputs {
+    ov::Tensor input_ids;
+    ov::Tensor inputs_embeds;
+};
+
+/// @brief Generates responses to many VLM requests together the same
+/// way ContinuousBatchingPipeline does for LLM requests. The language
+/// model is converted to paged attention and takes inputs_embeds.
+/// Prompt tokens take rows of merged text and image embeddings
+/// computed for each request, generated tokens are embedded by
+/// ModelRunner. Prompts are embedded on a background thread, so image
+/// encoding of new requests overlaps decoding of running ones.
+class VLMContinuousBatchingEngine {
+public:
+    /// @brief Computes PromptInputs for a prompt and images. The result
+    /// must not share memory with infer requests. Calls are serialized.
+    using Embedder = std::function<PromptInputs(const std::string&, const std::vector<ov::Tensor>&)>;
+
+    /// @brief Construct the engine.
+    /// @param language_model_path A stateful language model taking
+    /// inputs_embeds.
+    /// @param embedding_model_path A model computing token embeddings.
+    /// @param scale_emb A factor token embeddings are multiplied by.
+    /// @param scheduler_config A config for Scheduler and KV cache.
+    /// @param device Inference device.
+    /// @param compile_config A config to compile models with.
+    /// @param tokenizer A tokenizer for Sampler's stop strings.
+    /// @param embedder A function embedding prompts.
+    VLMContinuousBatchingEngine(
+        const std::filesystem::path& language_model_path,
+        const std::filesystem::path& embedding_model_path,
+        float scale_emb,
+        const SchedulerConfig& scheduler_config,
+        const std::string& device,
+        const ov::AnyMap& compile_config,
+        const Tokenizer& tokenizer,
+        Embedder embedder
+    );
+
+    /// @brief Wait for prompts which are still being embedded.
+    ~VLMContinuousBatchingEngine();
+
+    /// @brief Start embedding a prompt on a background thread. The
+    /// request joins decoding in the first step() after that.
+    /// @param request_id A unique id of the request.
+    /// @param prompt A prompt to respond to.
+    /// @param images Images to be prepended to the prompt. They are
+    /// copied, so callers may release them.
+    /// @param config A config to follow for text generation.
+    /// @return A handle to read generated tokens as they are produced.
+    GenerationHandle add_request(
+        uint64_t request_id,
+        const std::string& prompt,
+        const std::vector<ov::Tensor>& images,
+        GenerationConfig config
+    );
+
+    bool has_non_finished_requests();
+
+    /// @brief Add embedded requests and run one decoding step for all
+    /// of them. Blocks until a prompt is embedded if nothing else is
+    /// running.
+    void step();
+
+private:
+    struct AwaitingRequest {
+        SequenceGroup::Ptr sequence_group;
+        // input_ids and merged inputs_embeds of the prompt.
+        std::shared_future<PromptInputs> prompt;
+    };
+
+    void pull_embedded_requests();
+    void free_non_running_requests();
+    /// Embed tokens of prompt and merge them with its provided rows
+    /// into inputs_embeds [1, prompt length, hidden_size].
+    ov::Tensor merge_prompt_embeds(const PromptInputs& prompt);
+
+    Tokenizer m_tokenizer;
+    Embedder m_embedder;
+    // Embeds prompt tokens. It's created from the same compiled model
+    // as ModelRunner's embedding request, so the weights are loaded
+    // once.
+    ov::InferRequest m_prompt_embedding;
+    float m_scale_emb;
+    std::shared_ptr<Scheduler> m_scheduler;
+    std::shared_ptr<CacheManager> m_cache_manager;
+    std::shared_ptr<ModelRunner> m_model_runner;
+    std::shared_ptr<Sampler> m_sampler;
+
+    std::vector<SequenceGroup::Ptr> m_requests;
+    // Requests whose prompts are being embedded.
+    std::list<AwaitingRequest> m_awaiting_requests;
+    std::mutex m_awaiting_requests_mutex;
+    // The embedder shares infer requests with VLMPipeline. Also guards
+    // m_prompt_embedding.
+    std::mutex m_embedder_mutex;
+};
+}  // namespace ov::genai
@@ -0,0 +1,145 @@
+// Copyright (C) 2023-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "visual_language/embedding_cache.hpp"
+#include <cstring>
+
+using namespace ov::genai;
+
+namespace {
+constexpr uint64_t PRIME_1 = 0x9E3779B185EBCA87ULL;
+constexpr uint64_t PRIME_2 = 0xC2B2AE3D27D4EB4FULL;
+
+uint64_t rotl(uint64_t value, int shift) {
+    return (value << shift) | (value >> (64 - shift));
+}
+
+uint64_t mix(uint64_t acc, uint64_t word) {
+    return rotl(acc + word * PRIME_2, 31) * PRIME_1;
+}
+
+// murmur3 finalizer
+uint64_t avalanche(uint64_t hash) {
+    hash ^= hash >> 33;
+    hash *= 0xFF51AFD7ED558CCDULL;
+    hash ^= hash >> 33;
+    hash *= 0xC4CEB9FE1A85EC53ULL;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+/// Non cryptographic hash of a byte range. Four independent lanes
+/// consume 32 bytes per iteration to keep multipliers busy, so hashing
+/// an image is negligible compared to its encoding.
+uint64_t hash_bytes(const uint8_t* data, size_t size, uint64_t seed) {
+    uint64_t lanes[4] = {seed + PRIME_1 + PRIME_2, seed + PRIME_2, seed, seed - PRIME_1};
+    size_t offset = 0;
+    for (; offset + 32 <= size; offset += 32) {
+        for (size_t lane = 0; lane < 4; ++lane) {
+            uint64_t word;
+            std::memcpy(&word, data + offset + lane * 8, sizeof(word));
+            lanes[lane] = mix(lanes[lane], word);
+        }
+    }
+    uint64_t hash = rotl(lanes[0], 1) + rotl(lanes[1], 7) + rotl(lanes[2], 12) + rotl(lanes[3], 18) + size;
+    for (; offset + 8 <= size; offset += 8) {
+        uint64_t word;
+        std::memcpy(&word, data + offset, sizeof(word));
+        hash = mix(hash, word);
+    }
+    for (; offset < size; ++offset) {
+        hash = mix(hash, data[offset]);
+    }
+    return avalanche(hash);
+}
+
+template <typename T>
+uint64_t hash_value(uint64_t hash, const T& value) {
+    return hash_bytes(reinterpret_cast<const uint8_t*>(&value), sizeof(value), hash);
+}
+
+size_t byte_size(const ov::Tensor& tensor) {
+    return tensor ? tensor.get_byte_size() : 0;
+}
+
+size_t byte_size(const ImageEmbedding& embedding) {
+    return byte_size(embedding.encoded_image.resized_source)
+        + byte_size(embedding.encoded_image.slices)
+        + byte_size(embedding.resampled_source)
+        + byte_size(embedding.resampled_slices);
+}
+}  // namespace
+
+ImageEmbeddingKey ImageEmbeddingCache::make_key(
+    const ov::Tensor& image,
+    const ProcessorConfig& config,
+    VLMModelType model_type
+) {
+    uint64_t config_hash = hash_value(0, model_type);
+    for (size_t value : {
+        config.image_size, config.patch_size, config.scale_resolution, config.max_slice_nums,
+        config.crop_size_height, config.crop_size_width, config.size_shortest_edge
+    }) {
+        config_hash = hash_value(config_hash, value);
+    }
+    for (const std::array<float, 3>& values : {config.norm_mean, config.norm_std, config.image_mean, config.image_std}) {
+        config_hash = hash_value(config_hash, values);
+    }
+    return {
+        hash_bytes(static_cast<const uint8_t*>(image.data()), image.get_byte_size(), 0),
+        config_hash,
+        image.get_shape()
+    };
+}
+
+std::optional<ImageEmbedding> ImageEmbeddingCache::get(const ImageEmbeddingKey& key) {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    auto found = m_index.find(key);
+    if (m_index.end() == found) {
+        ++m_misses;
+        return std::nullopt;
+    }
+    ++m_hits;
+    m_lru.splice(m_lru.begin(), m_lru, found->second);
+    return found->second->embedding;
+}
+
+void ImageEmbeddingCache::put(const ImageEmbeddingKey& key, const ImageEmbedding& embedding) {
+    size_t size = byte_size(embedding);
+    std::lock_guard<std::mutex> lock{m_mutex};
+    if (size > m_capacity_bytes) {
+        return;
+    }
+    auto found = m_index.find(key);
+    if (m_index.end() != found) {
+        m_bytes -= found->second->byte_size;
+        m_lru.erase(found->second);
+        m_index.erase(found);
+    }
+    evict_to_fit(size);
+    m_lru.push_front({key, embedding, size});
+    m_index.emplace(key, m_lru.begin());
+    m_bytes += size;
+}
+
+void ImageEmbeddingCache::clear() {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    m_index.clear();
+    m_lru.clear();
+    m_bytes = 0;
+}
+
+ImageEmbeddingCacheStats ImageEmbeddingCache::get_stats() const {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    return {m_hits, m_misses, m_evictions, m_lru.size(), m_bytes, m_capacity_bytes};
+}
+
+void ImageEmbeddingCache::evict_to_fit(size_t size) {
+    while (!m_lru.empty() && m_bytes + size > m_capacity_bytes) {
+        const Entry& last = m_lru.back();
+        m_bytes -= last.byte_size;
+        m_index.erase(last.key);
+        m_lru.pop_back();
+        ++m_evictions;
+    }
+}
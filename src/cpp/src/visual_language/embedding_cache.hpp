@@ -0,0 +1,108 @@
+// Copyright (C) 2023-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "openvino/genai/visual_language/pipeline.hpp"
+#include "visual_language/vision_encoder.hpp"
+#include <list>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+
+namespace ov::genai {
+/// @brief Everything computed for a single image before it is merged
+/// with text embeddings.
+struct ImageEmbedding {
+    /// @brief VisionEncoder output.
+    EncodedImage encoded_image;
+    /// @brief Resampled resized_source: [1, query_num, hidden_size].
+    /// Empty for models without a resampler.
+    ov::Tensor resampled_source;
+    /// @brief Resampled slices:
+    /// [slice_y, slice_x, query_num, hidden_size]. Empty if the image
+    /// wasn't sliced or the model has no resampler.
+    ov::Tensor resampled_slices;
+};
+
+/// @brief Identifies an image together with everything affecting its
+/// embeddings.
+struct ImageEmbeddingKey {
+    /// @brief A hash of image bytes.
+    uint64_t image_hash;
+    /// @brief A hash of ProcessorConfig and VLMModelType used to
+    /// compute the embeddings.
+    uint64_t config_hash;
+    ov::Shape image_shape;
+
+    bool operator==(const ImageEmbeddingKey& other) const {
+        return image_hash == other.image_hash && config_hash == other.config_hash && image_shape == other.image_shape;
+    }
+};
+
+/// @brief A content addressed LRU cache of image embeddings limited by
+/// the total byte size of stored tensors. Tensors are stored as is, so
+/// they must not share memory with infer requests and must not be
+/// modified after put(). Thread safe.
+class ImageEmbeddingCache {
+public:
+    /// @brief Construct the cache.
+    /// @param capacity_bytes A memory budget. 0 disables the cache.
+    explicit ImageEmbeddingCache(size_t capacity_bytes=0) : m_capacity_bytes{capacity_bytes} {}
+
+    /// @brief Check if the cache is able to store anything. Callers
+    /// are expected to skip key computation otherwise.
+    bool is_enabled() const {
+        return m_capacity_bytes > 0;
+    }
+
+    /// @brief Compute a key for an image.
+    /// @param image uint8 image.
+    /// @param config A config used to compute the embeddings.
+    /// @param model_type A model used to compute the embeddings.
+    static ImageEmbeddingKey make_key(
+        const ov::Tensor& image,
+        const ProcessorConfig& config,
+        VLMModelType model_type
+    );
+
+    /// @brief Find embeddings and mark them as most recently used.
+    /// Updates hit and miss counters.
+    std::optional<ImageEmbedding> get(const ImageEmbeddingKey& key);
+
+    /// @brief Store embeddings evicting least recently used entries
+    /// to fit the budget. Embeddings larger than the budget are
+    /// dropped.
+    void put(const ImageEmbeddingKey& key, const ImageEmbedding& embedding);
+
+    /// @brief Drop all entries. Counters are preserved.
+    void clear();
+
+    ImageEmbeddingCacheStats get_stats() const;
+
+private:
+    struct KeyHash {
+        size_t operator()(const ImageEmbeddingKey& key) const {
+            return static_cast<size_t>(key.image_hash ^ key.config_hash);
+        }
+    };
+
+    struct Entry {
+        ImageEmbeddingKey key;
+        ImageEmbedding embedding;
+        size_t byte_size;
+    };
+
+    void evict_to_fit(size_t size);
+
+    size_t m_capacity_bytes;
+    size_t m_bytes = 0;
+    size_t m_hits = 0;
+    size_t m_misses = 0;
+    size_t m_evictions = 0;
+    // Most recently used entries are at the front.
+    std::list<Entry> m_lru;
+    std::unordered_map<ImageEmbeddingKey, std::list<Entry>::iterator, KeyHash> m_index;
+    mutable std::mutex m_mutex;
+};
+}  // namespace ov::genai
@@ -3,15 +3,24 @@
 
 #include "openvino/genai/visual_language/pipeline.hpp"
 #include "openvino/genai/tokenizer.hpp"
-#include "vlm_sampling.hpp"
 #include "clip.hpp"
 #include "text_callback_streamer.hpp"
 #include "utils.hpp"
 #include "vision_encoder.hpp"
+#include "embedding_cache.hpp"
+#include "continuous_batching.hpp"
+#include "sampler.hpp"
 #include "vlm_config.hpp"
 #include <openvino/openvino.hpp>
+#include <openvino/op/constant.hpp>
+#include <openvino/op/less.hpp>
+#include <openvino/op/maximum.hpp>
+#include <openvino/op/multiply.hpp>
+#include <openvino/op/parameter.hpp>
+#include <openvino/op/select.hpp>
+#include <openvino/op/unsqueeze.hpp>
+#include <future>
 #include <optional>
-#include <random>
 
 using namespace ov::genai;
 
@@ -20,107 +29,8 @@ template<class... Ts> struct overloaded : Ts... {using Ts::operator()...;};
 template<class... Ts> overloaded(Ts...) -> overloaded<Ts...>;
 
 constexpr size_t BATCH_SIZE = 1;
-
-struct Args {
-    bool do_sample = false;
-    int top_k = 0;
-    float top_p = 0.7f;
-    float temp = 0.95f;
-    float repeat_penalty = 1.0f;
-};
-
-int64_t get_out_token_id(const std::vector<int>& input_ids, float* logits, size_t vocab_size, Args args) {
-    int64_t out_token;
-
-    // logits pre-process
-    if (args.repeat_penalty != 1.f) {
-        sampling_repetition_penalty(logits, logits + vocab_size, input_ids, args.repeat_penalty);
-    }
-
-    if (args.do_sample)
-    {
-        if (args.temp > 0) {
-            sampling_temperature(logits, logits + vocab_size, args.temp);
-        }
-
-        std::vector<TokenIdScore> token_scores(vocab_size);
-        for (int i = 0; i < vocab_size; i++) {
-            token_scores[i] = TokenIdScore(i, logits[i]);
-        }
-
-        // top_k sampling
-        if (0 < args.top_k && args.top_k < (int)token_scores.size()) {
-            sampling_top_k(token_scores.data(), token_scores.data() + args.top_k,
-                token_scores.data() + token_scores.size());
-            token_scores.resize(args.top_k);
-        }
-
-        // top_p sampling
-        if (0.f < args.top_p && args.top_p < 1.f) {
-            auto pos = sampling_top_p(token_scores.data(), token_scores.data() + token_scores.size(), args.top_p);
-            token_scores.resize(pos - token_scores.data());
-        }
-
-        // sample next token
-        sampling_softmax_inplace(token_scores.data(), token_scores.data() + token_scores.size());
-        for (size_t i = 0; i < token_scores.size(); i++) {
-            logits[i] = token_scores[i].score;
-        }
-
-        thread_local std::random_device rd;
-        thread_local std::mt19937 gen(rd());
-
-        std::discrete_distribution<> dist(logits, logits + token_scores.size());
-        out_token = token_scores[dist(gen)].id;
-    }
-    else {
-        out_token = std::max_element(logits, logits + vocab_size) - logits;
-    }
-
-    return out_token;
-}
-
-ov::Tensor process_prompt(ov::InferRequest& embedding, const ov::Tensor& prompt, float scale_emb) {
-    embedding.set_input_tensor(prompt);
-    embedding.infer();
-
-    const ov::Tensor& embed_output_tensor = embedding.get_output_tensor();
-
-    ov::Shape out_shape = embed_output_tensor.get_shape();
-    float* data = embed_output_tensor.data<float>();
-
-    //embedding * scale_emb
-    for (size_t idx = 0; idx < embed_output_tensor.get_size(); idx++) {
-        data[idx] = data[idx] * scale_emb;
-    }
-    return embed_output_tensor;
-}
-
-ov::Tensor concatenate_last_dim(const ov::Tensor& first, const ov::Tensor& second) {
-    size_t res_d_0 = first.get_shape().at(0);
-    size_t res_d_1 = first.get_shape().at(1);
-    OPENVINO_ASSERT(second.get_shape().at(0) == res_d_0);
-    OPENVINO_ASSERT(second.get_shape().at(1) == res_d_1);
-    size_t res_d_2 = first.get_shape().at(2) + second.get_shape().at(2);
-    ov::Tensor res{first.get_element_type(), {res_d_0, res_d_1, res_d_2}};
-    float* first_data = first.data<float>();
-    float* second_data = second.data<float>();
-    float* res_data = res.data<float>();
-    for (size_t i = 0; i < res_d_0; ++i) {
-        for (size_t j = 0; j < res_d_1; ++j) {
-            size_t k = 0;
-            for (; k < first.get_shape().at(2); ++k) {
-                res_data[i * res_d_1 * res_d_2 + j * res_d_2 + k]
-                    = first_data[i * res_d_1 * first.get_shape().at(2) + j * first.get_shape().at(2) + k];
-            }
-            for (size_t l = 0; l < second.get_shape().at(2); ++l, ++k) {
-                res_data[i * res_d_1 * res_d_2 + j * res_d_2 + k]
-                    = second_data[i * res_d_1 * second.get_shape().at(2) + j * second.get_shape().at(2) + l];
-            }
-        }
-    }
-    return res;
-}
+// Marks input_ids taking rows of inputs_embeds, see PromptInputs.
+constexpr int64_t EMBEDDED_TOKEN_ID = -1;
 
 ov::Tensor concatenate_mid_dim(const ov::Tensor& first, const ov::Tensor& second) {
     size_t res_d_0 = first.get_shape().at(0);
@@ -153,150 +63,183 @@ ov::Tensor concatenate_mid_dim(const ov::Tensor& first, const ov::Tensor& second
 }
 
 /// embed_dim: output dimension for each position
-/// pos: a list of positions to be encoded: size (H, W)
-/// out: (H, W, D)
-ov::Tensor get_1d_sincos_pos_embed_from_grid_new(size_t embed_dim, const ov::Tensor& pos) {
+/// length: the number of positions to encode: 0, 1, ..., length - 1
+/// out: (length, D), sin in the first half of D, cos in the second.
+/// Resampler's 2D embedding of (h, w) is a concatenation of the rows w
+/// and h of the table computed for D / 2, so the table is all the trig
+/// work needed for any grid up to length x length.
+ov::Tensor get_1d_sincos_pos_embed(size_t embed_dim, size_t length) {
     OPENVINO_ASSERT(embed_dim % 2 == 0);
-    ov::Shape pos_shape = pos.get_shape();
-    size_t H = pos_shape[0];
-    size_t W = pos_shape[1];
-
-    std::vector<float> omega(embed_dim / 2);
+    size_t half_dim = embed_dim / 2;
+    std::vector<float> omega(half_dim);
     for (size_t i = 0; i < omega.size(); ++i) {
-        omega[i] = 1.0f / std::pow(10000.0f, float(i) / (embed_dim / 2));
+        omega[i] = 1.0f / std::pow(10000.0f, float(i) / half_dim);
     }
 
-    std::vector<size_t> out_shape = {H, W, embed_dim};
-    ov::Tensor emb(ov::element::f32, out_shape);
-
-    float* pos_data = pos.data<float>();
+    ov::Tensor emb(ov::element::f32, {length, embed_dim});
     float* emb_data = emb.data<float>();
-
-    size_t counter = 0;
-    for (size_t h = 0; h < H; ++h) {
-        for (size_t w = 0; w < W; ++w) {
-            for (size_t d = 0; d < embed_dim / 2; ++d) {
-                // Correctly access the 2D position grid
-                float value = omega[d] * pos_data[h * W + w];
-                // There should be sinf() and cosf(), but they don't exist on default Ubuntu20 gcc.
-                emb_data[h * W * embed_dim + w * embed_dim + d] = std::sin(double(value));
-                emb_data[h * W * embed_dim + w * embed_dim + d + (embed_dim / 2)] = std::cos(double(value));
-            }
+    for (size_t pos = 0; pos < length; ++pos) {
+        for (size_t d = 0; d < half_dim; ++d) {
+            float value = omega[d] * float(pos);
+            // There should be sinf() and cosf(), but they don't exist on default Ubuntu20 gcc.
+            emb_data[pos * embed_dim + d] = std::sin(double(value));
+            emb_data[pos * embed_dim + d + half_dim] = std::cos(double(value));
         }
     }
     return emb;
 }
 
-ov::Tensor get_2d_sincos_pos_embed_from_grid(size_t embed_dim, const ov::Tensor& grid) {
-    OPENVINO_ASSERT(embed_dim % 2 == 0);
-    ov::Shape grid_shape = grid.get_shape();
-    float* grid_data = grid.data<float>();
-    ov::Shape plane_shape{grid_shape.at(1), grid_shape.at(2)};
-    ov::Tensor emb_h = get_1d_sincos_pos_embed_from_grid_new(embed_dim / 2, ov::Tensor{
-        ov::element::f32,
-        plane_shape,
-        grid_data
-    });  // (H, W, D/2)
-    ov::Tensor emb_w = get_1d_sincos_pos_embed_from_grid_new(embed_dim / 2, ov::Tensor{
-        ov::element::f32,
-        plane_shape,
-        grid_data + plane_shape.at(0) * plane_shape.at(1)
-    });  // (H, W, D/2)
-    return concatenate_last_dim(emb_h, emb_w);
-}
-
-/// image_size: image_size or (image_height, image_width)
-/// return:
-/// pos_embed: [image_height, image_width, embed_dim]
-ov::Tensor get_2d_sincos_pos_embed(size_t embed_dim, const ImageSize& image_size) {
-    size_t grid_h_size = image_size.height, grid_w_size = image_size.width;
-    ov::Tensor grid(ov::element::f32, {2, grid_h_size, grid_w_size});
-    float* data = grid.data<float>();
-    for (size_t y = 0; y < grid_h_size; ++y) {
-        std::iota(data, data + grid_w_size, 0.0f);
-        data += grid_w_size;
-    }
-    for (float y = 0.0f; y < grid_h_size; ++y) {
-        std::fill(data, data + grid_w_size, y);
-        data += grid_w_size;
-    }
-    return get_2d_sincos_pos_embed_from_grid(embed_dim, grid);
-}
-
-void adjust_pos_cache(
+/// Extend pos_embed_table if a target size is larger. MiniCPM does
+/// the same for images of extreme aspect ratios.
+void adjust_pos_embed_table(
     const std::vector<ImageSize>& target_sizes,
     size_t hidden_size,
-    ov::Tensor& pos_embed_cache
+    ov::Tensor& pos_embed_table
 ) {
-    size_t max_h = std::max_element(target_sizes.begin(), target_sizes.end(), [](const ImageSize& left, const ImageSize& right) {
-        return left.height < right.height;
-    })->height;
-    size_t max_w = std::max_element(target_sizes.begin(), target_sizes.end(), [](const ImageSize& left, const ImageSize& right) {
-        return left.width < right.width;
-    })->width;
-    size_t allocated_height, allocated_width;
-    if (pos_embed_cache) {
-        const ov::Shape& allocated_shape = pos_embed_cache.get_shape();
-        allocated_height = allocated_shape.at(0);
-        allocated_width = allocated_shape.at(1);
-    } else {
-        allocated_height = allocated_width = 70;
-    }
-    if (max_h > allocated_height || max_w > allocated_width) {
-        allocated_height = std::max(max_h, allocated_height);
-        allocated_width = std::max(max_w, allocated_width);
-        pos_embed_cache = get_2d_sincos_pos_embed(
-            hidden_size, {allocated_height, allocated_width}
-        );
+    size_t max_side = pos_embed_table.get_shape().at(0);
+    for (const ImageSize& target_size : target_sizes) {
+        max_side = std::max({max_side, target_size.height, target_size.width});
+    }
+    if (max_side > pos_embed_table.get_shape().at(0)) {
+        pos_embed_table = get_1d_sincos_pos_embed(hidden_size / 2, max_side);
     }
 }
 
-ov::Tensor merge_text_and_image_embeddings_llava(
+/// Replace image_token_index in input_ids with EMBEDDED_TOKEN_ID
+/// repeated for each row of image_embeds [1, image length,
+/// hidden_size] and copy the rows to the same positions.
+PromptInputs merge_text_and_image_llava(
     const ov::Tensor& input_ids,
-    const ov::Tensor& text_embeds,
     const ov::Tensor& image_embeds,
     int64_t image_token_index
 ) {
-    auto text_embeds_shape = text_embeds.get_shape();
-    auto image_embeds_shape = image_embeds.get_shape();
-
-    OPENVINO_ASSERT(
-        text_embeds_shape[2] == image_embeds_shape[2],
-        "Incompatible shapes between text_embeds and image_embeds"
-    );
-
-    size_t text_embeds_seq_length = text_embeds_shape[1];
-    size_t hidden_size = text_embeds_shape[2];
-    size_t image_embeds_seq_length = image_embeds_shape[1];
-
-    size_t merged_seq_length = text_embeds_seq_length + (image_embeds_seq_length - 1);
-
-    ov::Tensor merged_embeds(text_embeds.get_element_type(), {BATCH_SIZE, merged_seq_length, hidden_size});
-
     const int64_t* input_ids_data = input_ids.data<const int64_t>();
-    const float* text_embeds_data = text_embeds.data<const float>();
+    size_t text_length = input_ids.get_size();
+    size_t image_length = image_embeds.get_shape().at(1);
+    size_t hidden_size = image_embeds.get_shape().at(2);
+    size_t num_images = std::count(input_ids_data, input_ids_data + text_length, image_token_index);
+    size_t merged_length = text_length + num_images * (image_length - 1);
+
+    ov::Tensor merged_ids{ov::element::i64, {BATCH_SIZE, merged_length}};
+    ov::Tensor merged_embeds{image_embeds.get_element_type(), {BATCH_SIZE, merged_length, hidden_size}};
+    int64_t* merged_ids_data = merged_ids.data<int64_t>();
+    float* merged_embeds_data = merged_embeds.data<float>();
     const float* image_embeds_data = image_embeds.data<const float>();
-    float* merged_data = merged_embeds.data<float>();
-
 
     size_t merged_idx = 0;
-    for (size_t s = 0; s < text_embeds_seq_length; ++s) {
+    for (size_t s = 0; s < text_length; ++s) {
         if (input_ids_data[s] == image_token_index) {
-            for (size_t i = 0; i < image_embeds_seq_length; ++i) {
-                std::copy_n(image_embeds_data + i * hidden_size,
-                            hidden_size,
-                            merged_data + merged_idx * hidden_size);
-                merged_idx++;
-            }
+            std::fill_n(merged_ids_data + merged_idx, image_length, EMBEDDED_TOKEN_ID);
+            std::copy_n(image_embeds_data, image_length * hidden_size, merged_embeds_data + merged_idx * hidden_size);
+            merged_idx += image_length;
         } else {
-            std::copy_n(text_embeds_data + s * hidden_size,
-                        hidden_size,
-                        merged_data + merged_idx * hidden_size);
+            merged_ids_data[merged_idx] = input_ids_data[s];
             merged_idx++;
         }
     }
+    return {merged_ids, merged_embeds};
+}
 
-    return merged_embeds;
+ov::Tensor copy_tensor(const ov::Tensor& tensor) {
+    ov::Tensor copy{tensor.get_element_type(), tensor.get_shape()};
+    tensor.copy_to(copy);
+    return copy;
+}
+
+/// Stack [1, L_i, D] tensors into [N, max(L_i), D] padding them with
+/// zeros.
+ov::Tensor pad_and_stack(const std::vector<ov::Tensor>& items) {
+    if (1 == items.size()) {
+        return items.at(0);
+    }
+    size_t max_len = 0;
+    for (const ov::Tensor& item : items) {
+        max_len = std::max(max_len, item.get_shape().at(1));
+    }
+    size_t hidden_size = items.at(0).get_shape().at(2);
+    ov::Tensor stacked{ov::element::f32, {items.size(), max_len, hidden_size}};
+    float* stacked_data = stacked.data<float>();
+    std::fill_n(stacked_data, stacked.get_size(), 0.0f);
+    for (size_t idx = 0; idx < items.size(); ++idx) {
+        std::copy_n(items.at(idx).data<float>(), items.at(idx).get_size(), stacked_data + idx * max_len * hidden_size);
+    }
+    return stacked;
+}
+
+/// Fold a token embedding model into a language model. The returned
+/// model takes input_ids[N, L] and inputs_embeds[N or 1, L or 1,
+/// hidden_size]. Non-negative input_ids are embedded and multiplied by
+/// scale_emb, negative ones take rows of inputs_embeds at the same
+/// positions, see PromptInputs. Prefill passes text tokens together
+/// with image features, and decode passes a token with a single row of
+/// inputs_embeds broadcast and unused, so both share the same infer
+/// request and KV cache and no separate embedding model is compiled.
+std::shared_ptr<ov::Model> fuse_token_embedding(
+    const std::shared_ptr<ov::Model>& language,
+    const std::shared_ptr<ov::Model>& embedding,
+    float scale_emb
+) {
+    OPENVINO_ASSERT(1 == embedding->get_parameters().size() && 1 == embedding->get_results().size(),
+        "Token embedding model must have a single input and a single output");
+    std::shared_ptr<ov::op::v0::Parameter> embedding_input = embedding->get_parameters().at(0);
+    auto input_ids = std::make_shared<ov::op::v0::Parameter>(embedding_input->get_element_type(), ov::PartialShape{-1, -1});
+    input_ids->set_friendly_name("input_ids");
+    input_ids->get_output_tensor(0).set_names({"input_ids"});
+    auto zero = ov::op::v0::Constant::create(embedding_input->get_element_type(), ov::Shape{}, {0});
+    // Negative ids are replaced with 0, their embeddings are discarded.
+    auto token_ids = std::make_shared<ov::op::v1::Maximum>(input_ids, zero);
+    embedding_input->output(0).replace(token_ids->output(0));
+    ov::Output<ov::Node> token_embeds = embedding->get_results().at(0)->input_value(0);
+    if (1.0f != scale_emb) {
+        auto scale = ov::op::v0::Constant::create(token_embeds.get_element_type(), ov::Shape{}, {scale_emb});
+        token_embeds = std::make_shared<ov::op::v1::Multiply>(token_embeds, scale)->output(0);
+    }
+
+    std::shared_ptr<ov::op::v0::Parameter> language_input;
+    for (const std::shared_ptr<ov::op::v0::Parameter>& parameter : language->get_parameters()) {
+        if (parameter->get_output_tensor(0).get_names().count("inputs_embeds")) {
+            language_input = parameter;
+        }
+    }
+    OPENVINO_ASSERT(language_input, "Language model must have inputs_embeds input");
+    auto inputs_embeds = std::make_shared<ov::op::v0::Parameter>(language_input->get_element_type(), language_input->get_partial_shape());
+    inputs_embeds->set_friendly_name("inputs_embeds");
+    auto provided = std::make_shared<ov::op::v0::Unsqueeze>(
+        std::make_shared<ov::op::v1::Less>(input_ids, zero),
+        ov::op::v0::Constant::create(ov::element::i64, ov::Shape{}, {2})
+    );
+    auto merged = std::make_shared<ov::op::v1::Select>(provided, inputs_embeds, token_embeds);
+    language_input->output(0).replace(merged->output(0));
+    language->remove_parameter(language_input);
+    language_input->get_output_tensor(0).set_names({});
+    inputs_embeds->get_output_tensor(0).set_names({"inputs_embeds"});
+    language->add_parameters({inputs_embeds, input_ids});
+    language->validate_nodes_and_infer_types();
+    return language;
+}
+
+size_t get_image_embedding_cache_size(const ov::AnyMap& device_config) {
+    size_t cache_size = 0;
+    utils::read_anymap_param(device_config, ov::genai::image_embedding_cache_size.name(), cache_size);
+    return cache_size;
+}
+
+std::optional<SchedulerConfig> get_scheduler_config(const ov::AnyMap& device_config) {
+    auto found = device_config.find(ov::genai::scheduler_config.name());
+    if (device_config.end() == found) {
+        return std::nullopt;
+    }
+    return found->second.as<SchedulerConfig>();
+}
+
+/// Remove properties handled by the pipeline itself.
+/// ov::Core::compile_model() doesn't accept them.
+ov::AnyMap without_properties(const ov::AnyMap& device_config, const std::vector<std::string>& names) {
+    ov::AnyMap compile_config{device_config};
+    for (const std::string& name : names) {
+        compile_config.erase(name);
+    }
+    return compile_config;
 }
 }
 
@@ -314,25 +257,38 @@ public:
     // [N, H*W, old_hidden_size] is the input shape.
     // [N, query_num, hidden_size] is the output shape.
     ov::InferRequest m_resampler;
-    // A model to compute token embeddings.
-    // Input shape: [N, conversation length].
-    // Output shape: [1, conversation length, hidden_size].
-    ov::InferRequest m_embedding;
-    // A language model used to generate a response.
-    // Input shapes: inputs_embeds[N, conversation length, hidden_size],
-    // position_ids[N, conversation length], beam_idx[N].
+    // A language model used to generate a response with the token
+    // embedding model folded in, see fuse_token_embedding().
+    // Input shapes: inputs_embeds[N or 1, conversation length or 1,
+    // hidden_size], input_ids[N, conversation length],
+    // position_ids[N, conversation length],
+    // attention_mask[N, history length], beam_idx[N].
     // Output shape: logits[N, conversation length, vocab_size].
     ov::InferRequest m_language;
-    // Precomputed positional embeddings for the resampler.
-    // [70, 70, hidden_size]. 70 is the initial guess of the image
-    // height and width after dividing by patch_size.
-    ov::Tensor m_pos_embed_cache;
+    // Ones backing attention_mask of m_language. It only grows, so
+    // extending the mask by a generated token doesn't refill it.
+    std::vector<int64_t> m_attention_mask;
+    // The row of KV cache holding the response of the previous chat
+    // turn after beam search.
+    int32_t m_selected_beam = 0;
+    // Precomputed positional embeddings for the resampler, see
+    // get_1d_sincos_pos_embed(). [70, hidden_size / 2]. 70 is MiniCPM's
+    // max_size of the image height and width after dividing by
+    // patch_size. Larger sizes extend the table.
+    ov::Tensor m_pos_embed_table;
+    // Reused resampler inputs, they only grow.
+    ov::Tensor m_resampler_pos_embed;
+    ov::Tensor m_resampler_key_padding_mask;
     // True if chat mode is activated to save conversation
     // history between generate() calls.
     bool m_is_chat_conversation;
     ChatHistory m_history;
     std::string m_templated_chat_history;
-    size_t m_image_id;  // Used to insert <image_id>i</image_id> per image (not a slice).
+    size_t m_image_id;  // Used to insert <image_id>i</image_id> per image (not a slice) in chat mode.
+    // Embeddings of previously seen images.
+    ImageEmbeddingCache m_image_embedding_cache;
+    // Set if scheduler_config was passed. Replaces m_language then.
+    std::unique_ptr<VLMContinuousBatchingEngine> m_continuous_batching;
 
     VLMPipelineImpl(
         const std::filesystem::path& model_dir,
@@ -344,36 +300,61 @@ public:
                 model_dir, "config.json"
             )
         },
-        m_tokenizer{Tokenizer(model_dir.string(), device_config)},
-        m_vision_encoder(model_dir, m_vlm_config.model_type, device, device_config, ov::Core{}),
+        m_tokenizer{Tokenizer(model_dir.string(), without_properties(
+            device_config, {image_embedding_cache_size.name(), image_resize_in_model.name(), scheduler_config.name()}
+        ))},
+        m_vision_encoder(
+            model_dir,
+            m_vlm_config.model_type,
+            device,
+            without_properties(device_config, {image_embedding_cache_size.name(), scheduler_config.name()}),
+            ov::Core{}
+        ),
         m_is_chat_conversation{false},
-        m_image_id{0} {
+        m_image_id{0},
+        m_image_embedding_cache{get_image_embedding_cache_size(device_config)} {
+            const ov::AnyMap compile_config = without_properties(
+                device_config, {image_embedding_cache_size.name(), image_resize_in_model.name(), scheduler_config.name()}
+            );
+            std::filesystem::path language_model_path, embedding_model_path;
             if (m_vlm_config.model_type == VLMModelType::MINICPM) {
                 m_resampler = ov::Core{}.compile_model(
-                    model_dir / "resampler.xml", device, device_config
-                ).create_infer_request();
-
-                m_embedding = ov::Core{}.compile_model(
-                    model_dir / "embed_tokens.xml", device, device_config
+                    model_dir / "resampler.xml", device, compile_config
                 ).create_infer_request();
 
-                m_language = ov::Core{}.compile_model(
-                    model_dir / "language_model.xml", device, device_config
-                ).create_infer_request();
+                language_model_path = model_dir / "language_model.xml";
+                embedding_model_path = model_dir / "embed_tokens.xml";
 
-                m_pos_embed_cache = get_2d_sincos_pos_embed(m_vlm_config.hidden_size, {70, 70});
+                m_pos_embed_table = get_1d_sincos_pos_embed(m_vlm_config.hidden_size / 2, 70);
+                m_resampler_pos_embed = ov::Tensor{ov::element::f32, {0, 0, m_vlm_config.hidden_size}};
+                m_resampler_key_padding_mask = ov::Tensor{ov::element::boolean, {0, 0}};
             } else if (m_vlm_config.model_type == VLMModelType::LLAVA) {
-                m_language = ov::Core{}.compile_model(
-                    model_dir / "openvino_language_model.xml", device, device_config
-                ).create_infer_request();
-
-                // Reusing the same m_embedding for llava text_embeddings model
-                m_embedding = ov::Core{}.compile_model(
-                    model_dir / "openvino_text_embeddings_model.xml", device, device_config
-                ).create_infer_request();
+                language_model_path = model_dir / "openvino_language_model.xml";
+                embedding_model_path = model_dir / "openvino_text_embeddings_model.xml";
             }
 
-            m_language.get_tensor("attention_mask").set_shape({1, 0});
+            if (std::optional<SchedulerConfig> scheduler = get_scheduler_config(device_config)) {
+                m_continuous_batching = std::make_unique<VLMContinuousBatchingEngine>(
+                    language_model_path,
+                    embedding_model_path,
+                    m_vlm_config.scale_emb,
+                    *scheduler,
+                    device,
+                    compile_config,
+                    m_tokenizer,
+                    [this](const std::string& prompt, const std::vector<ov::Tensor>& images) {
+                        return get_prompt_inputs(prompt, images);
+                    }
+                );
+                return;
+            }
+            ov::Core core;
+            m_language = core.compile_model(fuse_token_embedding(
+                core.read_model(language_model_path),
+                core.read_model(embedding_model_path),
+                m_vlm_config.scale_emb
+            ), device, compile_config).create_infer_request();
+            set_attention_mask_len(0);
     }
 
     DecodedResults generate(
@@ -382,85 +363,103 @@ public:
         const GenerationConfig& generation_config,
         const StreamerVariant& streamer
     ) {
-        ov::Tensor inputs_embeds;
-        if (m_vlm_config.model_type == VLMModelType::MINICPM) {
-            inputs_embeds = get_inputs_embeds_minicpm(prompt, rgbs);
-        } else if (m_vlm_config.model_type == VLMModelType::LLAVA) {
-            inputs_embeds = get_inputs_embeds_llava(prompt, rgbs);
+        if (m_continuous_batching) {
+            return generate_continuous_batching(prompt, rgbs, generation_config, streamer);
         }
-
-        m_language.set_tensor("inputs_embeds", inputs_embeds);
+        GenerationConfig config = generation_config;
+        config.set_eos_token_id(m_tokenizer.get_eos_token_id());
+        config.validate();
+        PromptInputs prompt_inputs = get_prompt_inputs(prompt, rgbs);
+        size_t prompt_len = prompt_inputs.input_ids.get_shape().at(1);
+        config.max_new_tokens = config.get_max_new_tokens(prompt_len);
+
+        // Sampler tracks beams and applies LogitProcessor the same way
+        // it does for ContinuousBatchingPipeline. The group's prompt is
+        // already embedded, it's prefilled at once.
+        SequenceGroup::Ptr sequence_group = std::make_shared<SequenceGroup>(
+            0, ov::Tensor{ov::element::i64, {1, 0}}, config, 1, false
+        );
+        sequence_group->set_sequence_group_ptr(sequence_group);
+        sequence_group->set_prompt_embeds(prompt_inputs.inputs_embeds, prompt_inputs.input_ids);
+        std::vector<SequenceGroup::Ptr> requests{sequence_group};
+        GenerationHandle handle = std::make_shared<GenerationHandleImpl>(sequence_group->get_generation_stream(), config);
+        Sampler sampler{m_tokenizer};
+        sampler.set_seed(config.rng_seed);
+
+        m_language.set_tensor("inputs_embeds", prompt_inputs.inputs_embeds);
+        m_language.set_tensor("input_ids", prompt_inputs.input_ids);
         size_t history_len = m_language.get_tensor("attention_mask").get_shape().at(1);
-        m_language.get_tensor("attention_mask").set_shape({1, history_len + inputs_embeds.get_shape()[1]});
-        std::fill_n(m_language.get_tensor("attention_mask").data<int64_t>(), m_language.get_tensor("attention_mask").get_size(), 1);
-        
-        m_language.get_tensor("position_ids").set_shape({1, inputs_embeds.get_shape().at(1)});
-        std::iota(m_language.get_tensor("position_ids").data<int64_t>(), m_language.get_tensor("position_ids").data<int64_t>() + m_language.get_tensor("position_ids").get_size(), history_len);
-        
-        m_language.get_tensor("beam_idx").set_shape({ BATCH_SIZE });
-        m_language.get_tensor("beam_idx").data<int32_t>()[0] = 0;
-
-        m_language.infer();
-
-        ov::Shape logits_shape = m_language.get_tensor("logits").get_shape();
-        auto attention_size = m_language.get_tensor("attention_mask").get_size();
-
-        int64_t sequence_len = m_language.get_tensor("logits").get_shape().at(1) - 1;
-        size_t vocab_size = m_language.get_tensor("logits").get_shape().back();
-        float* logits = m_language.get_tensor("logits").data<float>() + sequence_len * vocab_size;
-        int64_t out_token = std::max_element(logits, logits + vocab_size) - logits;
+        set_attention_mask_len(history_len + prompt_len);
 
-        m_language.get_tensor("inputs_embeds").set_shape({BATCH_SIZE, 1, m_vlm_config.hidden_size});
-        m_language.get_tensor("position_ids").set_shape({ BATCH_SIZE, 1 });
-
-        m_embedding.get_input_tensor().set_shape({ 1, 1 });
+        m_language.get_tensor("position_ids").set_shape({BATCH_SIZE, prompt_len});
+        std::iota(m_language.get_tensor("position_ids").data<int64_t>(), m_language.get_tensor("position_ids").data<int64_t>() + m_language.get_tensor("position_ids").get_size(), history_len);
 
-        int64_t eos_token_id = m_tokenizer.get_eos_token_id();
-        std::shared_ptr<StreamerBase> streamer_ptr = std::visit(overloaded{
-            [&m_tokenizer = m_tokenizer](
-                const std::function<bool(std::string)>& callback
-            ) -> std::shared_ptr<StreamerBase> {
-                return std::make_shared<TextCallbackStreamer>(m_tokenizer, callback);
-            },
-            [](const std::shared_ptr<StreamerBase>& ptr) {
-                return ptr;
-            },
-            [](std::monostate) {
-                return std::shared_ptr<StreamerBase>{nullptr};
-            },
-        }, streamer);
+        // Continue the beam selected by the previous chat turn.
+        m_language.get_tensor("beam_idx").set_shape({BATCH_SIZE});
+        m_language.get_tensor("beam_idx").data<int32_t>()[0] = m_selected_beam;
+        sequence_group->schedule_tokens(prompt_len);
+
+        // Sequence id => the row of the last inferred batch the
+        // sequence's last token was sampled from.
+        std::unordered_map<uint64_t, int32_t> beam_rows{{sequence_group->get_sequences().front()->get_id(), 0}};
+        // Sequences of the last inferred batch and the numbers of their
+        // generated tokens in KV cache.
+        std::vector<std::pair<Sequence::CPtr, size_t>> last_batch{{sequence_group->get_sequences().front(), 0}};
+        // Generated tokens are embedded inside m_language, the row of
+        // decode_embeds is broadcast and unused.
+        ov::Tensor decode_embeds{prompt_inputs.inputs_embeds.get_element_type(), {BATCH_SIZE, 1, m_vlm_config.hidden_size}};
+        ov::Tensor decode_ids{ov::element::i64, {BATCH_SIZE, 1}};
+        std::shared_ptr<StreamerBase> streamer_ptr = make_streamer(streamer);
         std::vector<int64_t> generated;
-        while (true) {  //(out_token != eos_token_id)
-            m_embedding.get_input_tensor().data<int64_t>()[0] = out_token;
-            m_embedding.infer();
-            const ov::Tensor& embed_prompt_tensor = m_embedding.get_output_tensor();
-            float* embed_data = embed_prompt_tensor.data<float>();
-            for (auto idx = 0; idx < embed_prompt_tensor.get_size(); idx++) {
-                embed_data[idx] = embed_data[idx] * m_vlm_config.scale_emb;
-            }
-
-            m_language.set_tensor("inputs_embeds", embed_prompt_tensor);
-            m_language.get_tensor("attention_mask").set_shape({ BATCH_SIZE, m_language.get_tensor("attention_mask").get_shape()[1] + 1 });
-            std::fill_n(m_language.get_tensor("attention_mask").data<int64_t>(), m_language.get_tensor("attention_mask").get_size(), 1);
-            m_language.get_tensor("position_ids").data<int64_t>()[0] = int64_t(m_language.get_tensor("attention_mask").get_size() - 1);
-
+        while (true) {
             m_language.infer();
-
-            generated.push_back(out_token);
-            if (streamer_ptr && streamer_ptr->put(out_token)) {
+            SamplerOutput sampler_output = sampler.sample(requests, m_language.get_tensor("logits"));
+            for (const auto& [parent_id, child_ids] : sampler_output.m_forked_sequences) {
+                for (uint64_t child_id : child_ids) {
+                    beam_rows[child_id] = beam_rows.at(parent_id);
+                }
+            }
+            if (read_outputs(handle, streamer_ptr, generated) || sequence_group->has_finished()) {
                 break;
             }
-            logits = m_language.get_tensor("logits").data<float>();
 
-            out_token = std::max_element(logits, logits + vocab_size) - logits;
-            if (out_token == eos_token_id) {
-                break;
+            std::vector<Sequence::Ptr> running_sequences = sequence_group->get_running_sequences();
+            size_t batch_size = running_sequences.size();
+            last_batch.clear();
+            decode_ids.set_shape({batch_size, 1});
+            m_language.set_tensor("inputs_embeds", decode_embeds);
+            m_language.set_tensor("input_ids", decode_ids);
+            m_language.get_tensor("beam_idx").set_shape({batch_size});
+            int64_t* input_ids = decode_ids.data<int64_t>();
+            int32_t* beam_idx = m_language.get_tensor("beam_idx").data<int32_t>();
+            for (size_t row = 0; row < batch_size; ++row) {
+                input_ids[row] = running_sequences[row]->get_generated_ids().back();
+                beam_idx[row] = beam_rows.at(running_sequences[row]->get_id());
+                beam_rows[running_sequences[row]->get_id()] = int32_t(row);
+                last_batch.emplace_back(running_sequences[row], running_sequences[row]->get_generated_len());
             }
+            size_t attention_len = m_language.get_tensor("attention_mask").get_shape().at(1) + 1;
+            set_attention_mask_len(attention_len, batch_size);
+            m_language.get_tensor("position_ids").set_shape({batch_size, 1});
+            std::fill_n(m_language.get_tensor("position_ids").data<int64_t>(), batch_size, int64_t(attention_len - 1));
+            sequence_group->schedule_tokens(1);
         }
+        sampler.clear_beam_search_info(sequence_group->get_request_id());
 
         if (streamer_ptr) {
             streamer_ptr->end();
         }
+        if (m_is_chat_conversation) {
+            // The next turn continues the KV cache of the selected answer.
+            if (std::optional<int32_t> row = find_kv_row(generated, last_batch)) {
+                m_selected_beam = *row;
+            } else {
+                prefill_answer(history_len + prompt_len, generated);
+            }
+        }
+        if (!generated.empty() && generated.back() == m_tokenizer.get_eos_token_id()) {
+            generated.pop_back();
+        }
 
         std::string decoded_results = m_tokenizer.decode(generated);
         if (m_is_chat_conversation) {
@@ -472,7 +471,8 @@ public:
             for (auto& variable : m_language.query_state()) {
                 variable.reset();
             }
-            m_language.get_tensor("attention_mask").set_shape({1, 0});
+            set_attention_mask_len(0);
+            m_selected_beam = 0;
         }
         return {{std::move(decoded_results)}};
     }
@@ -504,8 +504,30 @@ public:
         );
     }
 
+    GenerationHandle add_request(
+        uint64_t request_id,
+        const std::string& prompt,
+        const std::vector<ov::Tensor>& rgbs,
+        const GenerationConfig& generation_config
+    ) {
+        OPENVINO_ASSERT(m_continuous_batching, "add_request() requires scheduler_config passed to VLMPipeline constructor");
+        OPENVINO_ASSERT(!m_is_chat_conversation, "Chat mode isn't supported with continuous batching");
+        return m_continuous_batching->add_request(request_id, prompt, rgbs, generation_config);
+    }
+
+    void step() {
+        OPENVINO_ASSERT(m_continuous_batching, "step() requires scheduler_config passed to VLMPipeline constructor");
+        m_continuous_batching->step();
+    }
+
+    bool has_non_finished_requests() {
+        return m_continuous_batching && m_continuous_batching->has_non_finished_requests();
+    }
+
     void start_chat(const std::string& system_message) {
+        OPENVINO_ASSERT(!m_continuous_batching, "Chat mode isn't supported with continuous batching");
         m_is_chat_conversation = true;
+        m_image_id = 0;
         bool have_state = 0 != m_language.get_tensor("attention_mask").get_size();
         if (have_state) {
             // Resetting state may be slow.
@@ -513,7 +535,8 @@ public:
                 variable.reset();
             }
             // Since if is already introduced, move all resetting here.
-            m_language.get_tensor("attention_mask").set_shape({1, 0});
+            set_attention_mask_len(0);
+            m_selected_beam = 0;
             m_history.clear();
             m_templated_chat_history.clear();
         }
@@ -543,28 +566,176 @@ public:
         m_generation_config = new_config;
     }
 
-    ov::Tensor get_inputs_embeds_llava(const std::string& prompt, const std::vector<ov::Tensor>& images) {
+    /// Run a single request through m_continuous_batching.
+    DecodedResults generate_continuous_batching(
+        const std::string& prompt,
+        const std::vector<ov::Tensor>& rgbs,
+        const GenerationConfig& generation_config,
+        const StreamerVariant& streamer
+    ) {
+        OPENVINO_ASSERT(
+            !m_continuous_batching->has_non_finished_requests(),
+            "generate() cannot be called while requests added by add_request() are not finished"
+        );
+        std::shared_ptr<StreamerBase> streamer_ptr = make_streamer(streamer);
+        GenerationHandle handle = add_request(0, prompt, rgbs, generation_config);
+        std::vector<int64_t> generated;
+        bool dropped = false;
+        while (m_continuous_batching->has_non_finished_requests()) {
+            m_continuous_batching->step();
+            dropped = dropped || read_outputs(handle, streamer_ptr, generated);
+        }
+        if (streamer_ptr) {
+            streamer_ptr->end();
+        }
+        if (!generated.empty() && generated.back() == m_tokenizer.get_eos_token_id()) {
+            generated.pop_back();
+        }
+        return {{m_tokenizer.decode(generated)}};
+    }
+
+    /// Find the row of KV cache holding all but the last token of the
+    /// selected answer. Finished beams are forked without being
+    /// reported by Sampler, so rows are matched by tokens. Returns
+    /// std::nullopt if no row matches, e.g. the beam finished before
+    /// the last step.
+    static std::optional<int32_t> find_kv_row(
+        const std::vector<int64_t>& answer,
+        const std::vector<std::pair<Sequence::CPtr, size_t>>& last_batch
+    ) {
+        for (size_t row = 0; row < last_batch.size(); ++row) {
+            const auto& [sequence, kv_len] = last_batch[row];
+            const std::vector<int64_t>& ids = sequence->get_generated_ids();
+            if (kv_len + 1 == answer.size() && ids.size() >= kv_len && std::equal(ids.begin(), ids.begin() + kv_len, answer.begin())) {
+                return int32_t(row);
+            }
+        }
+        return std::nullopt;
+    }
+
+    /// Trim KV cache to its first prefix_len positions, which are
+    /// shared by all rows, and infer all but the last token of answer
+    /// on top of them. Used when no row holds the selected answer.
+    void prefill_answer(size_t prefix_len, const std::vector<int64_t>& answer) {
+        for (ov::VariableState& variable : m_language.query_state()) {
+            // KV cache layout is [batch, heads, seq_len, head_dim].
+            ov::Tensor state = variable.get_state();
+            ov::Coordinate begin(state.get_shape().size(), 0), end{state.get_shape()};
+            end.at(0) = BATCH_SIZE;
+            end.at(2) = prefix_len;
+            ov::Tensor trimmed{state.get_element_type(), ov::Shape{end}};
+            ov::Tensor{state, begin, end}.copy_to(trimmed);
+            variable.set_state(trimmed);
+        }
+        m_selected_beam = 0;
+        set_attention_mask_len(prefix_len);
+        size_t answer_len = answer.empty() ? 0 : answer.size() - 1;
+        if (0 == answer_len) {
+            return;
+        }
+        ov::element::Type embeds_type = m_language.get_tensor("inputs_embeds").get_element_type();
+        m_language.set_tensor("inputs_embeds", ov::Tensor{embeds_type, {BATCH_SIZE, 1, m_vlm_config.hidden_size}});
+        ov::Tensor input_ids{ov::element::i64, {BATCH_SIZE, answer_len}};
+        std::copy_n(answer.begin(), answer_len, input_ids.data<int64_t>());
+        m_language.set_tensor("input_ids", input_ids);
+        m_language.get_tensor("beam_idx").set_shape({BATCH_SIZE});
+        m_language.get_tensor("beam_idx").data<int32_t>()[0] = 0;
+        set_attention_mask_len(prefix_len + answer_len);
+        m_language.get_tensor("position_ids").set_shape({BATCH_SIZE, answer_len});
+        std::iota(m_language.get_tensor("position_ids").data<int64_t>(), m_language.get_tensor("position_ids").data<int64_t>() + answer_len, int64_t(prefix_len));
+        m_language.infer();
+    }
+
+    /// Append tokens pushed to handle to generated and put them to
+    /// streamer_ptr. Streamable configs push a token per step, others
+    /// push all sequences once finished and the sequence with the
+    /// highest score is taken then.
+    /// @return true if streamer_ptr asked to stop. The handle is
+    /// dropped then.
+    static bool read_outputs(
+        GenerationHandle& handle,
+        const std::shared_ptr<StreamerBase>& streamer_ptr,
+        std::vector<int64_t>& generated
+    ) {
+        while (handle->can_read()) {
+            std::unordered_map<uint64_t, GenerationOutput> outputs = handle->read();
+            if (outputs.empty()) {
+                continue;
+            }
+            auto best = std::max_element(outputs.begin(), outputs.end(), [](const auto& left, const auto& right) {
+                return left.second.score < right.second.score;
+            });
+            for (int64_t token : best->second.generated_ids) {
+                generated.push_back(token);
+                if (streamer_ptr && streamer_ptr->put(token)) {
+                    handle->drop();
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    std::shared_ptr<StreamerBase> make_streamer(const StreamerVariant& streamer) {
+        return std::visit(overloaded{
+            [&m_tokenizer = m_tokenizer](
+                const std::function<bool(std::string)>& callback
+            ) -> std::shared_ptr<StreamerBase> {
+                return std::make_shared<TextCallbackStreamer>(m_tokenizer, callback);
+            },
+            [](const std::shared_ptr<StreamerBase>& ptr) {
+                return ptr;
+            },
+            [](std::monostate) {
+                return std::shared_ptr<StreamerBase>{nullptr};
+            },
+        }, streamer);
+    }
+
+    PromptInputs get_prompt_inputs(const std::string& prompt, const std::vector<ov::Tensor>& images) {
+        if (m_vlm_config.model_type == VLMModelType::MINICPM) {
+            return get_prompt_inputs_minicpm(prompt, images);
+        }
+        OPENVINO_ASSERT(m_vlm_config.model_type == VLMModelType::LLAVA, "Unsupported model type");
+        return get_prompt_inputs_llava(prompt, images);
+    }
+
+    /// Make attention_mask of m_language a view of batch_size x len
+    /// ones from m_attention_mask growing it geometrically if needed.
+    void set_attention_mask_len(size_t len, size_t batch_size=BATCH_SIZE) {
+        if (batch_size * len >= m_attention_mask.size()) {
+            m_attention_mask.resize(std::max(batch_size * len + 1, 2 * m_attention_mask.size()), 1);
+        }
+        m_language.set_tensor("attention_mask", ov::Tensor{ov::element::i64, {batch_size, len}, m_attention_mask.data()});
+    }
+
+    PromptInputs get_prompt_inputs_llava(const std::string& prompt, const std::vector<ov::Tensor>& images) {
+        OPENVINO_ASSERT(images.size() <= 1, "Only a single image allowed");
+        // The image is encoded while the prompt is tokenized. The task
+        // touches only the vision encoder and the embedding cache.
+        std::future<ImageEmbedding> embed_future;
+        if (!images.empty()) {
+            embed_future = std::async(std::launch::async, [this, &images]() {
+                return embed_image_llava(images.at(0));
+            });
+        }
         std::string image_token = "<image>"; // TODO Consider getting from vlm_config or json
         std::string formatted_prompt = "USER: " + (images.empty() ? prompt : image_token + "\n" + prompt) + " ASSISTANT:";
         ov::Tensor input_ids = m_tokenizer.encode(formatted_prompt).input_ids;
         if (images.empty()) {
-            return process_prompt(m_embedding, input_ids, m_vlm_config.scale_emb);
+            // Tokens are embedded by m_language.
+            return {copy_tensor(input_ids), ov::Tensor{ov::element::f32, {BATCH_SIZE, input_ids.get_size(), m_vlm_config.hidden_size}}};
         } else {
-            OPENVINO_ASSERT(1 == images.size(), "Only a single image allowed");
-            EncodedImage encoded_image = m_vision_encoder.encode(images.at(0));
-            ov::Tensor image_embeds = encoded_image.resized_source;
-            
-            ov::Tensor text_embeds = process_prompt(m_embedding, input_ids, m_vlm_config.scale_emb);
+            ov::Tensor image_embeds = embed_future.get().encoded_image.resized_source;
 
             int64_t image_token_index = 32000; // TODO Consider getting from m_vlm_config.image_token_index or config.json
 
-            return merge_text_and_image_embeddings_llava(input_ids, text_embeds, image_embeds, image_token_index);
+            return merge_text_and_image_llava(input_ids, image_embeds, image_token_index);
         }
     }
 
-    ov::Tensor get_inputs_embeds_minicpm(const std::string& prompt, const std::vector<ov::Tensor>& images) {
-        std::string images_prompt;
-        std::vector<EncodedImage> embeds;
+    PromptInputs get_prompt_inputs_minicpm(const std::string& prompt, const std::vector<ov::Tensor>& images) {
+        std::vector<ov::Tensor> single_images;
         for (const ov::Tensor& rgb : images) {
             ov::Tensor reshaped = rgb;
             ov::Shape rgb_shape = rgb.get_shape();
@@ -577,41 +748,54 @@ public:
             }
             ov::Shape reshaped_shape = reshaped.get_shape();
             for (size_t batch_idx = 0; batch_idx < reshaped_shape.at(0); ++batch_idx) {
-                ov::Tensor single_image{
+                single_images.push_back(ov::Tensor{
                     ov::element::u8,
                     {1, reshaped_shape.at(1), reshaped_shape.at(2), reshaped_shape.at(3)},
-                    reshaped.data<uint8_t>() + batch_idx * reshaped_shape.at(1) * reshaped_shape.at(1) * reshaped_shape.at(1)
-                };
-                EncodedImage encoded_image = m_vision_encoder.encode(single_image);
-                if (m_vlm_config.use_image_id) {
-                    images_prompt += m_vlm_config.im_id_start + std::to_string(m_image_id) + m_vlm_config.im_id_end;
-                    ++m_image_id;
-                }
-                std::string unk64;
-                for (size_t idx = 0; idx < m_vlm_config.query_num; ++idx) {
-                    unk64 += m_vlm_config.unk;
-                }
-                images_prompt += m_vlm_config.im_start + unk64 + m_vlm_config.im_end;
-                if (encoded_image.slices) {
-                    ov::Shape slices_shape = encoded_image.slices.get_shape();
-                    for (size_t row_idx = 0; row_idx < slices_shape.at(0); ++row_idx) {
-                        for (size_t col_idx = 0; col_idx < slices_shape.at(1); ++col_idx) {
-                            images_prompt += m_vlm_config.slice_start + unk64 + m_vlm_config.slice_end;
-                        }
-                        images_prompt += '\n';
+                    reshaped.data<uint8_t>() + batch_idx * reshaped_shape.at(1) * reshaped_shape.at(2) * reshaped_shape.at(3)
+                });
+            }
+        }
+        // Images are encoded and resampled while the prompt is built
+        // and tokenized. The prompt only needs slice grids
+        // which are known from image sizes.
+        std::future<std::vector<ImageEmbedding>> embeds_future = std::async(std::launch::async, [this, &single_images]() {
+            return embed_images_minicpm(single_images);
+        });
+        std::vector<ImageSize> slices_grids;
+        std::string images_prompt;
+        // Image ids continue through a chat and start from 0 for every
+        // other request, so a prompt doesn't depend on earlier requests.
+        size_t image_id = m_is_chat_conversation ? m_image_id : 0;
+        for (const ov::Tensor& single_image : single_images) {
+            slices_grids.push_back(m_vision_encoder.get_slices_grid(single_image));
+            if (m_vlm_config.use_image_id) {
+                images_prompt += m_vlm_config.im_id_start + std::to_string(image_id) + m_vlm_config.im_id_end;
+                ++image_id;
+            }
+            std::string unk64;
+            for (size_t idx = 0; idx < m_vlm_config.query_num; ++idx) {
+                unk64 += m_vlm_config.unk;
+            }
+            images_prompt += m_vlm_config.im_start + unk64 + m_vlm_config.im_end;
+            const ImageSize& grid = slices_grids.back();
+            if (grid.height > 0) {
+                for (size_t row_idx = 0; row_idx < grid.height; ++row_idx) {
+                    for (size_t col_idx = 0; col_idx < grid.width; ++col_idx) {
+                        images_prompt += m_vlm_config.slice_start + unk64 + m_vlm_config.slice_end;
                     }
-                }
-                if ('\n' != *(images_prompt.end() - 1)) {
-                    // Image wasn't sliced, add \n to the end of image anyway.
-                    // Strangely, \n isn't placed between </image><slice>.
                     images_prompt += '\n';
                 }
-                embeds.push_back(std::move(encoded_image));
+            }
+            if ('\n' != *(images_prompt.end() - 1)) {
+                // Image wasn't sliced, add \n to the end of image anyway.
+                // Strangely, \n isn't placed between </image><slice>.
+                images_prompt += '\n';
             }
         }
         images_prompt += prompt;
         ov::Tensor encoded_input;
         if (m_is_chat_conversation) {
+            m_image_id = image_id;
             // KV cache in model already contains prompts and answers from previous iterations.
             // So only new prompt wrapped into chat template to be sent into model. Tokenizer always returns
             // token_ids = {<bos token>, ...<valuable tokens>}. So if tokenizer applies only to the new prompt,
@@ -638,13 +822,9 @@ public:
         } else {
             encoded_input = m_tokenizer.encode(images_prompt).input_ids;
         }
-        m_embedding.set_input_tensor(encoded_input);
-        m_embedding.infer();
-        ov::Tensor inputs_embeds = m_embedding.get_output_tensor();
-        OPENVINO_ASSERT(
-            m_vlm_config.hidden_size == inputs_embeds.get_shape().at(2),
-            "Unexpected embedding size"
-        );
+        // Tokens are embedded by m_language, only image rows are set.
+        ov::Tensor input_ids = copy_tensor(encoded_input);
+        ov::Tensor inputs_embeds{ov::element::f32, {BATCH_SIZE, input_ids.get_size(), m_vlm_config.hidden_size}};
         ov::Tensor special_tokens = m_tokenizer.encode(
             m_vlm_config.im_start
             + m_vlm_config.im_end
@@ -659,72 +839,164 @@ public:
         int64_t im_end_id = special_tokens.data<int64_t>()[1];
         int64_t slice_start_id = special_tokens.data<int64_t>()[2];
         int64_t slice_end_id = special_tokens.data<int64_t>()[3];
+        std::vector<ImageEmbedding> embeds = embeds_future.get();
+        for (size_t idx = 0; idx < embeds.size(); ++idx) {
+            const ov::Tensor& slices = embeds.at(idx).encoded_image.slices;
+            OPENVINO_ASSERT(
+                slices_grids.at(idx).height == (slices ? slices.get_shape().at(0) : 0)
+                    && slices_grids.at(idx).width == (slices ? slices.get_shape().at(1) : 0),
+                "Image slices don't match the prompt"
+            );
+        }
         int64_t im_start_pos = 0, slice_start_pos = 0;
-        int64_t* begin = encoded_input.data<int64_t>();
+        int64_t* begin = input_ids.data<int64_t>();
         int64_t* ids = begin;
-        size_t encoded_input_size = encoded_input.get_size();
+        size_t encoded_input_size = input_ids.get_size();
         int64_t* end = ids + encoded_input_size;
         float* inputs_embeds_data = inputs_embeds.data<float>();
-        for (const EncodedImage& encoded_image : embeds) {
-            const ov::Tensor& resampled_source = resample(*this, encoded_image.resized_source, {encoded_image.resized_source_size});
+        for (const ImageEmbedding& embedding : embeds) {
+            const ov::Tensor& resampled_source = embedding.resampled_source;
             float* emb = resampled_source.data<float>();
             ids = std::find(ids, end, im_start_id);
             OPENVINO_ASSERT(end != ids);
             ++ids;
             std::copy_n(emb, resampled_source.get_size(), inputs_embeds_data + std::distance(begin, ids) * m_vlm_config.hidden_size);
+            std::fill_n(ids, m_vlm_config.query_num, EMBEDDED_TOKEN_ID);
             ids += m_vlm_config.query_num;
-            if (encoded_image.slices) {
-                size_t token_idx = 0;
-                const ov::Shape& slices_shape = encoded_image.slices.get_shape();
+            if (embedding.resampled_slices) {
+                const ov::Shape& slices_shape = embedding.resampled_slices.get_shape();
+                size_t slice_size = slices_shape.at(2) * slices_shape.at(3);
+                const float* slices_data = embedding.resampled_slices.data<float>();
                 for (size_t i = 0; i < slices_shape.at(0); ++i) {
                     for (size_t ja = 0; ja < slices_shape.at(1); ++ja) {
-                        size_t d2 = slices_shape.at(2);
-                        size_t d3 = slices_shape.at(3);
-                        ov::Tensor encoded_view{ov::element::f32, {1, d2, d3}, encoded_image.slices.data<float>() + (i * slices_shape.at(1) + ja) * d2 * d3};
-                        const ov::Tensor& vision_embed_tensor_i_j = resample(*this, encoded_view, {encoded_image.slices_size});
                         ids = std::find(ids, end, slice_start_id);
                         OPENVINO_ASSERT(end != ids);
                         ++ids;
-                        std::copy_n(vision_embed_tensor_i_j.data<float>(), vision_embed_tensor_i_j.get_size(), inputs_embeds_data + std::distance(begin, ids) * m_vlm_config.hidden_size);
+                        std::copy_n(slices_data + (i * slices_shape.at(1) + ja) * slice_size, slice_size, inputs_embeds_data + std::distance(begin, ids) * m_vlm_config.hidden_size);
+                        std::fill_n(ids, m_vlm_config.query_num, EMBEDDED_TOKEN_ID);
                         ids += m_vlm_config.query_num;
                     }
                 }
             }
         }
 
-        return inputs_embeds;
+        return {input_ids, inputs_embeds};
+    }
+
+    /// Encode and resample [1HWC] images. Images found in
+    /// m_image_embedding_cache are reused, the rest are encoded by a
+    /// single vision encoder inference and their resized sources and
+    /// slices are resampled by a single resampler inference.
+    std::vector<ImageEmbedding> embed_images_minicpm(const std::vector<ov::Tensor>& images) {
+        std::vector<ImageEmbedding> embeddings(images.size());
+        std::vector<ImageEmbeddingKey> keys;
+        std::vector<ov::Tensor> missed_images;
+        std::vector<size_t> missed_indices;
+        for (size_t idx = 0; idx < images.size(); ++idx) {
+            if (m_image_embedding_cache.is_enabled()) {
+                keys.push_back(ImageEmbeddingCache::make_key(images.at(idx), m_vision_encoder.m_processor_config, m_vlm_config.model_type));
+                if (std::optional<ImageEmbedding> cached = m_image_embedding_cache.get(keys.back())) {
+                    embeddings.at(idx) = *cached;
+                    continue;
+                }
+            }
+            missed_images.push_back(images.at(idx));
+            missed_indices.push_back(idx);
+        }
+        if (missed_images.empty()) {
+            return embeddings;
+        }
+        std::vector<EncodedImage> encoded_images = m_vision_encoder.encode_batch(missed_images);
+
+        std::vector<ov::Tensor> resampler_inputs;
+        std::vector<ImageSize> target_sizes;
+        for (const EncodedImage& encoded_image : encoded_images) {
+            resampler_inputs.push_back(encoded_image.resized_source);
+            target_sizes.push_back(encoded_image.resized_source_size);
+            if (encoded_image.slices) {
+                const ov::Shape& slices_shape = encoded_image.slices.get_shape();
+                size_t d2 = slices_shape.at(2);
+                size_t d3 = slices_shape.at(3);
+                for (size_t slice_idx = 0; slice_idx < slices_shape.at(0) * slices_shape.at(1); ++slice_idx) {
+                    resampler_inputs.push_back(ov::Tensor{ov::element::f32, {1, d2, d3}, encoded_image.slices.data<float>() + slice_idx * d2 * d3});
+                    target_sizes.push_back(encoded_image.slices_size);
+                }
+            }
+        }
+        ov::Tensor resampled = resample(*this, pad_and_stack(resampler_inputs), target_sizes);
+        const size_t resampled_size = m_vlm_config.query_num * m_vlm_config.hidden_size;
+        OPENVINO_ASSERT(resampler_inputs.size() * resampled_size == resampled.get_size());
+        const float* resampled_data = resampled.data<float>();
+        size_t item_idx = 0;
+        for (size_t missed_idx = 0; missed_idx < missed_indices.size(); ++missed_idx) {
+            ImageEmbedding& embedding = embeddings.at(missed_indices.at(missed_idx));
+            embedding.encoded_image = std::move(encoded_images.at(missed_idx));
+            embedding.resampled_source = ov::Tensor{ov::element::f32, {1, m_vlm_config.query_num, m_vlm_config.hidden_size}};
+            std::copy_n(resampled_data + item_idx * resampled_size, resampled_size, embedding.resampled_source.data<float>());
+            ++item_idx;
+            if (embedding.encoded_image.slices) {
+                const ov::Shape& slices_shape = embedding.encoded_image.slices.get_shape();
+                size_t n_slices = slices_shape.at(0) * slices_shape.at(1);
+                embedding.resampled_slices = ov::Tensor{ov::element::f32, {slices_shape.at(0), slices_shape.at(1), m_vlm_config.query_num, m_vlm_config.hidden_size}};
+                std::copy_n(resampled_data + item_idx * resampled_size, n_slices * resampled_size, embedding.resampled_slices.data<float>());
+                item_idx += n_slices;
+            }
+            if (m_image_embedding_cache.is_enabled()) {
+                m_image_embedding_cache.put(keys.at(missed_indices.at(missed_idx)), embedding);
+            }
+        }
+        return embeddings;
+    }
+
+    /// Encode an image or take the result from m_image_embedding_cache.
+    ImageEmbedding embed_image_llava(const ov::Tensor& image) {
+        if (!m_image_embedding_cache.is_enabled()) {
+            return {m_vision_encoder.encode(image)};
+        }
+        ImageEmbeddingKey key = ImageEmbeddingCache::make_key(image, m_vision_encoder.m_processor_config, m_vlm_config.model_type);
+        if (std::optional<ImageEmbedding> cached = m_image_embedding_cache.get(key)) {
+            return *cached;
+        }
+        ImageEmbedding embedding{m_vision_encoder.encode(image)};
+        // The encoder returns its own output tensor which is overwritten by the next inference.
+        embedding.encoded_image.resized_source = copy_tensor(embedding.encoded_image.resized_source);
+        m_image_embedding_cache.put(key, embedding);
+        return embedding;
+    }
+
+    ImageEmbeddingCacheStats get_image_embedding_cache_stats() const {
+        return m_image_embedding_cache.get_stats();
+    }
+
+    void clear_image_embedding_cache() {
+        m_image_embedding_cache.clear();
     }
 
     ov::Tensor resample(VLMPipeline::VLMPipelineImpl& pipe, const ov::Tensor& encoded_image, const std::vector<ImageSize>& target_sizes) {
         size_t bs = encoded_image.get_shape().at(0);
-        std::vector<size_t> patch_len{target_sizes.size()};
+        std::vector<size_t> patch_len(target_sizes.size());
         std::transform(target_sizes.begin(), target_sizes.end(), patch_len.begin(), [](const ImageSize& height_width) {
             return height_width.height * height_width.width;
         });
-        adjust_pos_cache(
-            target_sizes,
-            pipe.m_vlm_config.hidden_size,
-            pipe.m_pos_embed_cache
-        );
+        adjust_pos_embed_table(target_sizes, pipe.m_vlm_config.hidden_size, pipe.m_pos_embed_table);
         size_t max_patch_len = *std::max_element(patch_len.begin(), patch_len.end());
-        ov::Tensor key_padding_mask(ov::element::boolean, {bs, max_patch_len});
+        ov::Tensor& key_padding_mask = pipe.m_resampler_key_padding_mask;
+        key_padding_mask.set_shape({bs, max_patch_len});
         bool* mask_data = key_padding_mask.data<bool>();
-        size_t embed_len = pipe.m_pos_embed_cache.get_shape().at(2);
-        ov::Tensor pos_embed(ov::element::f32, {max_patch_len, bs, embed_len});  // BLD => L * B * D
+        size_t embed_len = pipe.m_vlm_config.hidden_size;
+        size_t half_len = embed_len / 2;
+        ov::Tensor& pos_embed = pipe.m_resampler_pos_embed;
+        pos_embed.set_shape({max_patch_len, bs, embed_len});  // BLD => L * B * D
         float* pos_embed_data = pos_embed.data<float>();
-        float* cache_data = pipe.m_pos_embed_cache.data<float>();
-        size_t _d0 = pipe.m_pos_embed_cache.get_shape().at(0);
-        size_t _d1 = pipe.m_pos_embed_cache.get_shape().at(1);
+        const float* table_data = pipe.m_pos_embed_table.data<float>();
         for (size_t i = 0; i < bs; ++i) {
             size_t target_h = target_sizes.at(i).height;
             size_t target_w = target_sizes.at(i).width;
             for (size_t h_idx = 0; h_idx < target_h; ++h_idx) {
                 for (size_t w_idx = 0; w_idx < target_w; ++w_idx) {
-                    std::copy_n(
-                        cache_data + (h_idx * _d1 + w_idx) * embed_len,
-                        embed_len,
-                        pos_embed_data + (h_idx * target_w + w_idx) * bs * embed_len + i * embed_len
-                    );
+                    float* dst = pos_embed_data + (h_idx * target_w + w_idx) * bs * embed_len + i * embed_len;
+                    std::copy_n(table_data + w_idx * half_len, half_len, dst);
+                    std::copy_n(table_data + h_idx * half_len, half_len, dst + half_len);
                 }
             }
             for (size_t flat = target_h * target_w; flat < max_patch_len; ++flat) {
@@ -765,6 +1037,23 @@ DecodedResults VLMPipeline::generate(
     return m_pimpl->generate(prompt, config_map);
 }
 
+GenerationHandle VLMPipeline::add_request(
+    uint64_t request_id,
+    const std::string& prompt,
+    const std::vector<ov::Tensor>& rgbs,
+    const GenerationConfig& generation_config
+) {
+    return m_pimpl->add_request(request_id, prompt, rgbs, generation_config);
+}
+
+void VLMPipeline::step() {
+    m_pimpl->step();
+}
+
+bool VLMPipeline::has_non_finished_requests() {
+    return m_pimpl->has_non_finished_requests();
+}
+
 void VLMPipeline::start_chat(const std::string& system_message) {
     m_pimpl->start_chat(system_message);
 }
@@ -788,3 +1077,11 @@ GenerationConfig VLMPipeline::get_generation_config() const {
 void VLMPipeline::set_generation_config(const GenerationConfig& new_config) {
     m_pimpl->set_generation_config(new_config);
 }
+
+ImageEmbeddingCacheStats VLMPipeline::get_image_embedding_cache_stats() const {
+    return m_pimpl->get_image_embedding_cache_stats();
+}
+
+void VLMPipeline::clear_image_embedding_cache() {
+    m_pimpl->clear_image_embedding_cache();
+}
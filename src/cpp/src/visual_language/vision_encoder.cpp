@@ -3,7 +3,15 @@
 
 #include "vision_encoder.hpp"
 #include "visual_language/clip.hpp"
+#include "openvino/genai/visual_language/pipeline.hpp"
 #include "utils.hpp"
+#include <openvino/core/parallel.hpp>
+#include <openvino/op/clamp.hpp>
+#include <openvino/op/constant.hpp>
+#include <openvino/op/convert.hpp>
+#include <openvino/op/interpolate.hpp>
+#include <openvino/op/parameter.hpp>
+#include <openvino/op/round.hpp>
 
 using namespace ov::genai;
 
@@ -45,175 +53,141 @@ std::pair<int, int> get_refine_size(std::pair<int, int> original_size, std::pair
     return refine_size;
 }
 
-std::vector<std::vector<clip_image_u8>> slice_image(const clip_image_u8& img, const int max_slice_nums, const int scale_resolution, const int patch_size, const bool never_split) {
-    const std::pair<int, int> original_size{img.nx, img.ny};
-    const int original_width = img.nx;
-    const int original_height = img.ny;
+/// Resize with bicubic_resize() or with resizer built by
+/// create_bicubic_resize_model() if it isn't empty.
+void resize(const clip_image_u8& src, clip_image_u8& dst, int target_width, int target_height, ov::InferRequest& resizer) {
+    if (!resizer) {
+        bicubic_resize(src, dst, target_width, target_height);
+        return;
+    }
+    resizer.set_tensor("image", ov::Tensor{
+        ov::element::u8, {1, size_t(src.ny), size_t(src.nx), 3}, const_cast<uint8_t*>(src.buf.data())
+    });
+    ov::Tensor target_size{ov::element::i64, {2}};
+    target_size.data<int64_t>()[0] = target_height;
+    target_size.data<int64_t>()[1] = target_width;
+    resizer.set_tensor("target_size", target_size);
+    resizer.infer();
+    const ov::Tensor& resized = resizer.get_output_tensor();
+    dst.nx = target_width;
+    dst.ny = target_height;
+    dst.buf.assign(resized.data<uint8_t>(), resized.data<uint8_t>() + resized.get_size());
+}
+
+/// An image resized according to scale_resolution and an optional
+/// refined image covered by a grid of equally sized slices. Slices
+/// aren't copied, preprocess_for_encoder() reads them from
+/// refined_image.
+struct SlicedImage {
+    clip_image_u8 resized_source;
+    clip_image_u8 refined_image;
+    /// @brief {columns, rows} of the grid. {0, 0} if the image isn't
+    /// sliced.
+    std::pair<int, int> grid{0, 0};
+};
+
+/// {columns, rows} of the grid an image of original_size is sliced
+/// into. {0, 0} if the image isn't sliced.
+std::pair<int, int> find_best_grid(std::pair<int, int> original_size, const int max_slice_nums, const int scale_resolution) {
+    const int original_width = original_size.first;
+    const int original_height = original_size.second;
     const float log_ratio = log(1.0f * original_width / original_height);
     const float ratio = 1.0f * original_width * original_height / (scale_resolution * scale_resolution);
     const int multiple = std::min(int(ceil(ratio)), max_slice_nums);
-
-    std::vector<std::vector<clip_image_u8>> images;
-    images.push_back(std::vector<clip_image_u8>{});
-
     if (multiple <= 1) {
-        auto best_size = find_best_resize(original_size, scale_resolution, patch_size, true);
-        images.back().push_back(clip_image_u8{});
-        bicubic_resize(img, images.back().back(), best_size.first, best_size.second);
+        return {0, 0};
     }
-    else if (multiple > 1) {
 
-        std::vector<int> candidate_split_grids_nums;
-        for (int i : {multiple - 1, multiple, multiple + 1}) {
-            if (i == 1 || i > max_slice_nums) {
-                continue;
-            }
-            candidate_split_grids_nums.push_back(i);
+    std::vector<int> candidate_split_grids_nums;
+    for (int i : {multiple - 1, multiple, multiple + 1}) {
+        if (i == 1 || i > max_slice_nums) {
+            continue;
         }
+        candidate_split_grids_nums.push_back(i);
+    }
 
-        auto best_size = find_best_resize(original_size, scale_resolution, patch_size);
-        images.back().push_back(clip_image_u8{});
-        bicubic_resize(img, images.back().back(), best_size.first, best_size.second);
-
-        std::vector<std::pair<int, int>> candidate_grids;
-
-        for (int split_grids_nums : candidate_split_grids_nums) {
-            int m = 1;
-            while (m <= split_grids_nums) {
-                if (split_grids_nums % m == 0) {
-                    candidate_grids.emplace_back(m, split_grids_nums / m);
-                }
-                ++m;
+    std::vector<std::pair<int, int>> candidate_grids;
+
+    for (int split_grids_nums : candidate_split_grids_nums) {
+        int m = 1;
+        while (m <= split_grids_nums) {
+            if (split_grids_nums % m == 0) {
+                candidate_grids.emplace_back(m, split_grids_nums / m);
             }
+            ++m;
         }
+    }
 
-        std::pair<int, int> best_grid{ 1, 1 };
-        float min_error = std::numeric_limits<float>::infinity();
+    std::pair<int, int> best_grid{ 1, 1 };
+    float min_error = std::numeric_limits<float>::infinity();
 
-        for (const auto& grid : candidate_grids) {
-            float error = std::abs(log_ratio - std::log(1.0f * grid.first / grid.second));
-            if (error < min_error) {
-                best_grid = grid;
-                min_error = error;
-            }
-        }
-        auto refine_size = get_refine_size(original_size, best_grid, scale_resolution, patch_size, true);
-        clip_image_u8 refine_image;
-        bicubic_resize(img, refine_image, refine_size.first, refine_size.second);
-
-        // split_to_patches
-        int width = refine_image.nx;
-        int height = refine_image.ny;
-        int grid_x = int(width / best_grid.first);
-        int grid_y = int(height / best_grid.second);
-        for (int patches_i = 0, ic = 0; patches_i < height && ic < best_grid.second; patches_i += grid_y, ic += 1) {
-            images.push_back(std::vector<clip_image_u8>{});
-            for (int patches_j = 0, jc = 0; patches_j < width && jc < best_grid.first; patches_j += grid_x, jc += 1) {
-                images.back().push_back(clip_image_u8{});
-                clip_image_u8& patch = images.back().back();
-                patch.nx = grid_x;
-                patch.ny = grid_y;
-                patch.buf.resize(3 * patch.nx * patch.ny);
-                for (int y = patches_i; y < patches_i + grid_y; ++y) {
-                    for (int x = patches_j; x < patches_j + grid_x; ++x) {
-                        const int i = 3 * (y * refine_image.nx + x);
-                        const int j = 3 * ((y - patches_i) * patch.nx + (x - patches_j));
-                        patch.buf[j] = refine_image.buf[i];
-                        patch.buf[j + 1] = refine_image.buf[i + 1];
-                        patch.buf[j + 2] = refine_image.buf[i + 2];
-                    }
-                }
-            }
+    for (const auto& grid : candidate_grids) {
+        float error = std::abs(log_ratio - std::log(1.0f * grid.first / grid.second));
+        if (error < min_error) {
+            best_grid = grid;
+            min_error = error;
         }
     }
-
-    return images;
+    return best_grid;
 }
 
-// Reimplemented https://pytorch.org/docs/stable/generated/torch.nn.Unfold.html#torch.nn.Unfold
-// in shape [NCHW], out shape: [N, C*kernel*kernel, H*W/kernel/kernel]
-ov::Tensor unfold(const ov::Tensor& images_tensor, size_t kernel) {
-    ov::Shape images_shape = images_tensor.get_shape();
-
-    OPENVINO_ASSERT(4 == images_shape.size(), "Input tensor must be 4D (NCHW).");
-
-    const size_t bs = images_shape.at(0);
-    const size_t images_c = images_shape.at(1);
-    const size_t images_h = images_shape.at(2);
-    const size_t images_w = images_shape.at(3);
-
-    OPENVINO_ASSERT(images_h >= kernel && images_w >= kernel, "Input height and width must be greater than or equal to kernel size.");
-
-    const size_t new_c = images_c * kernel * kernel;
-    const size_t output_h = (images_h - kernel) / kernel + 1;
-    const size_t output_w = (images_w - kernel) / kernel + 1;
-    const size_t kernels_per_plane = output_h * output_w;
-
-    ov::Tensor unfolded_tensor(ov::element::f32, {bs, new_c, kernels_per_plane});
-    const float* images = images_tensor.data<float>();
-    float* unfolded = unfolded_tensor.data<float>();
-    for (size_t batch_idx = 0; batch_idx < bs; ++batch_idx) {
-        for (size_t c_idx = 0; c_idx < images_c; ++c_idx) {
-            for (size_t h_out = 0; h_out < output_h; ++h_out) {
-                for (size_t w_out = 0; w_out < output_w; ++w_out) {
-                    size_t h_idx = h_out * kernel;  // Calculate input height index
-                    size_t w_idx = w_out * kernel;  // Calculate input width index
-
-                    for (size_t kh = 0; kh < kernel; ++kh) {
-                        for (size_t kw = 0; kw < kernel; ++kw) {
-                            size_t input_idx = (batch_idx * images_c * images_h * images_w) +
-                                               (c_idx * images_h * images_w) +
-                                               ((h_idx + kh) * images_w) +
-                                               (w_idx + kw);
-
-                            size_t unfolded_c_idx = (c_idx * kernel * kernel) + (kh * kernel) + kw;
-                            size_t unfolded_idx = (batch_idx * new_c * kernels_per_plane) +
-                                                  unfolded_c_idx * kernels_per_plane +
-                                                  (h_out * output_w + w_out);
-
-                            unfolded[unfolded_idx] = images[input_idx];
-                        }
-                    }
-                }
-            }
-        }
+SlicedImage slice_image(const clip_image_u8& img, const int max_slice_nums, const int scale_resolution, const int patch_size, const bool never_split, ov::InferRequest& resizer) {
+    const std::pair<int, int> original_size{img.nx, img.ny};
+    const std::pair<int, int> best_grid = find_best_grid(original_size, max_slice_nums, scale_resolution);
+
+    SlicedImage sliced;
+
+    if (0 == best_grid.first) {
+        auto best_size = find_best_resize(original_size, scale_resolution, patch_size, true);
+        resize(img, sliced.resized_source, best_size.first, best_size.second, resizer);
+    } else {
+        auto best_size = find_best_resize(original_size, scale_resolution, patch_size);
+        resize(img, sliced.resized_source, best_size.first, best_size.second, resizer);
+        // refine_size is a multiple of best_grid, so the grid covers the refined image exactly.
+        auto refine_size = get_refine_size(original_size, best_grid, scale_resolution, patch_size, true);
+        resize(img, sliced.refined_image, refine_size.first, refine_size.second, resizer);
+        sliced.grid = best_grid;
     }
-    return unfolded_tensor;
+
+    return sliced;
 }
 
-ov::Tensor preprocess_for_encoder(const ov::Tensor& images, size_t kernel) {
-    ov::Shape images_shape = images.get_shape();
-    OPENVINO_ASSERT(4 == images_shape.size());
-    ov::Tensor unfolded_tensor = unfold(images, kernel);
-    const ov::Shape& unfolded_shape = unfolded_tensor.get_shape();  // [N, C*kernel*kernel, H*W/kernel/kernel]
-    const size_t bs = unfolded_shape[0];
-    const size_t d1 = unfolded_shape[1];
-    const size_t d2 = unfolded_shape[2];
+/// Normalize a width x height region of an image starting at (x0, y0)
+/// and lay it out as pixel_values of the encoder. The reference
+/// implementation applies
+/// https://pytorch.org/docs/stable/generated/torch.nn.Unfold.html#torch.nn.Unfold
+/// with kernel and stride patch_size to [1, C, H, W] and permutes the
+/// result to [1, C, patch_size, H*W/patch_size]. Element [c, h, w]
+/// ends up at [c, h % patch_size, h / patch_size * W + w], so every
+/// image row is normalized straight to its place. Rows and columns
+/// beyond a multiple of patch_size are dropped like Unfold does.
+ov::Tensor preprocess_for_encoder(
+    const clip_image_u8& img,
+    int x0,
+    int y0,
+    int width,
+    int height,
+    const std::array<std::array<float, 256>, 3>& normalization_table,
+    size_t patch_size
+) {
+    OPENVINO_ASSERT(size_t(height) >= patch_size && size_t(width) >= patch_size, "Input height and width must be greater than or equal to kernel size.");
     const size_t channels = 3;
-    const size_t new_len = d2 * kernel;
-
-    ov::Tensor permuted_tensor{ov::element::f32, {bs, channels, kernel, new_len}};
-    const float* unfolded = unfolded_tensor.data<float>();
-    float* permuted = permuted_tensor.data<float>();
-    for (size_t b_idx = 0; b_idx < bs; ++b_idx) {
-        for (size_t c_idx = 0; c_idx < channels; ++c_idx) {
-            for (size_t k1_idx = 0; k1_idx < kernel; ++k1_idx) {
-                for (size_t d2_idx = 0; d2_idx < d2; ++d2_idx) {
-                    for (size_t k2_idx = 0; k2_idx < kernel; ++k2_idx) {
-                        size_t unfolded_idx = b_idx * d1 * d2 +
-                                            (c_idx * kernel * kernel + k1_idx * kernel + k2_idx) * d2 +
-                                            d2_idx;
-                        size_t permuted_idx = b_idx * channels * kernel * new_len +
-                                            c_idx * kernel * new_len +
-                                            k1_idx * new_len +
-                                            d2_idx * kernel + k2_idx;
-                        permuted[permuted_idx] = unfolded[unfolded_idx];
-                    }
-                }
+    const size_t used_width = width / patch_size * patch_size;
+    const size_t used_height = height / patch_size * patch_size;
+    const size_t new_len = used_height / patch_size * used_width;
+    ov::Tensor pixel_values{ov::element::f32, {1, channels, patch_size, new_len}};
+    float* pixels = pixel_values.data<float>();
+    ov::parallel_for(used_height, [&](size_t h) {
+        const uint8_t* src_row = img.buf.data() + channels * ((y0 + h) * img.nx + x0);
+        for (size_t c = 0; c < channels; ++c) {
+            float* dst_row = pixels + (c * patch_size + h % patch_size) * new_len + h / patch_size * used_width;
+            const float* channel_table = normalization_table[c].data();
+            for (size_t w = 0; w < used_width; ++w) {
+                dst_row[w] = channel_table[src_row[channels * w + c]];
             }
         }
-    }
-    return permuted_tensor;
+    });
+    return pixel_values;
 }
 
 // torch.bucketize(fractional_coords, boundaries, right=True)
@@ -275,76 +249,121 @@ ov::Tensor prepare_vis_position_ids(
     return position_ids;
 }
 
-EncodedImage llava_image_embed_make_with_bytes_slice(clip_ctx& ctx_clip, const ov::Tensor& img, ov::InferRequest& encoder, int max_slice_nums, int scale_resolution, size_t patch_size, bool never_split) {
+/// pixel_values of a resized source image and of its slices.
+struct PreprocessedImage {
+    ov::Tensor resized_source;
+    ImageSize resized_source_size;
+    /// @brief Slices in row major order of the grid.
+    std::vector<ov::Tensor> slices;
+    ImageSize slices_size;
+    /// @brief {columns, rows} of the grid. {0, 0} if the image isn't
+    /// sliced.
+    std::pair<int, int> grid{0, 0};
+};
+
+PreprocessedImage preprocess_minicpm(const clip_ctx& ctx_clip, const ov::Tensor& img, int max_slice_nums, int scale_resolution, size_t patch_size, bool never_split, ov::InferRequest& resizer) {
     clip_image_u8 source{
         int(img.get_shape().at(3)),
         int(img.get_shape().at(2)),
         {img.data<uint8_t>(), img.data<uint8_t>() + img.get_size()}
     };
-    std::vector<std::vector<clip_image_u8>> imgs = ::slice_image(source, max_slice_nums, scale_resolution, patch_size, never_split);
-    std::vector<std::vector<ov::Tensor>> results;
-    std::vector<std::vector<ImageSize>> sizes;
-
-    // std::vector<clip_image_f32*> img_res_v; // format N x H x W x RGB (N x 336 x 336 x 3), so interleaved RGB - different to the python implementation which is N x 3 x 336 x 336
-    std::vector<std::vector<clip_image_f32>> preprocessed{imgs.size()};
-    std::transform(imgs.begin(), imgs.end(), preprocessed.begin(), [&ctx_clip](const std::vector<clip_image_u8>& row) {
-        std::vector<clip_image_f32> processed_row{row.size()};
-        std::transform(row.begin(), row.end(), processed_row.begin(), [&ctx_clip](const clip_image_u8& raw) {
-            return clip_image_preprocess(ctx_clip, raw);
-        });
-        return processed_row;
+    SlicedImage sliced = ::slice_image(source, max_slice_nums, scale_resolution, patch_size, never_split, resizer);
+    const auto normalization_table = clip_normalization_table(ctx_clip);
+
+    PreprocessedImage preprocessed;
+    const clip_image_u8& resized = sliced.resized_source;
+    preprocessed.resized_source_size = {resized.ny / patch_size, resized.nx / patch_size};
+    preprocessed.resized_source = preprocess_for_encoder(resized, 0, 0, resized.nx, resized.ny, normalization_table, patch_size);
+    if (0 == sliced.grid.first) {
+        return preprocessed;
+    }
+
+    const size_t grid_cols = sliced.grid.first, grid_rows = sliced.grid.second;
+    const int slice_width = sliced.refined_image.nx / sliced.grid.first;
+    const int slice_height = sliced.refined_image.ny / sliced.grid.second;
+    preprocessed.slices_size = {slice_height / patch_size, slice_width / patch_size};
+    preprocessed.grid = sliced.grid;
+    // Slices are independent, prepare all of them in parallel.
+    preprocessed.slices.resize(grid_rows * grid_cols);
+    ov::parallel_for(preprocessed.slices.size(), [&](size_t idx) {
+        preprocessed.slices[idx] = preprocess_for_encoder(
+            sliced.refined_image,
+            int(idx % grid_cols) * slice_width,
+            int(idx / grid_cols) * slice_height,
+            slice_width,
+            slice_height,
+            normalization_table,
+            patch_size
+        );
     });
+    return preprocessed;
+}
 
-    const clip_image_f32& resized_preprocessed = preprocessed.at(0).at(0);
-    ImageSize resized_source_size{resized_preprocessed.ny / patch_size, resized_preprocessed.nx / patch_size};
-    ov::Tensor input_tensor{ov::element::f32, {1, 3, size_t(resized_preprocessed.ny), size_t(resized_preprocessed.nx)}, (void*)(resized_preprocessed.buf.data())};
-    ov::Tensor pixel_values = preprocess_for_encoder(input_tensor, patch_size);
-    encoder.set_tensor("pixel_values", pixel_values);
-    ov::Tensor patch_attention_mask{ov::element::boolean, {pixel_values.get_shape().at(0), 1, resized_source_size.height * resized_source_size.width}};
-    std::fill_n(patch_attention_mask.data<bool>(), patch_attention_mask.get_size(), true);
+/// Encode pixel_values of different sizes in a single inference. Items
+/// are padded to the longest one with zeros and patch_attention_mask
+/// excludes the padding from attention. Returns encoder's output
+/// [N, max_patches, hidden_size] where only the first
+/// sizes[i].height * sizes[i].width rows of item i are valid.
+ov::Tensor encode_padded(
+    ov::InferRequest& encoder,
+    const std::vector<ov::Tensor>& pixel_values,
+    const std::vector<ImageSize>& sizes,
+    const clip_ctx& ctx_clip,
+    size_t patch_size
+) {
+    const size_t batch_size = pixel_values.size();
+    size_t max_len = 0;
+    for (const ov::Tensor& item : pixel_values) {
+        max_len = std::max(max_len, item.get_shape().at(3));
+    }
+    const size_t channels = 3;
+    ov::Tensor batched{ov::element::f32, {batch_size, channels, patch_size, max_len}};
+    float* batched_data = batched.data<float>();
+    std::fill_n(batched_data, batched.get_size(), 0.0f);
+    ov::parallel_for(batch_size, [&](size_t batch_idx) {
+        const float* item = pixel_values.at(batch_idx).data<float>();
+        size_t len = pixel_values.at(batch_idx).get_shape().at(3);
+        for (size_t row = 0; row < channels * patch_size; ++row) {
+            std::copy_n(item + row * len, len, batched_data + (batch_idx * channels * patch_size + row) * max_len);
+        }
+    });
+    const size_t max_patches = max_len / patch_size;
+    ov::Tensor patch_attention_mask{ov::element::boolean, {batch_size, 1, max_patches}};
+    bool* mask_data = patch_attention_mask.data<bool>();
+    for (size_t batch_idx = 0; batch_idx < batch_size; ++batch_idx) {
+        size_t n_patches = sizes.at(batch_idx).height * sizes.at(batch_idx).width;
+        std::fill_n(mask_data + batch_idx * max_patches, n_patches, true);
+        std::fill_n(mask_data + batch_idx * max_patches + n_patches, max_patches - n_patches, false);
+    }
+    ov::Tensor position_ids = prepare_vis_position_ids(batched, patch_attention_mask, sizes, ctx_clip.patch_size, ctx_clip.image_size / ctx_clip.patch_size);
+    encoder.set_tensor("pixel_values", batched);
     encoder.set_tensor("patch_attention_mask", patch_attention_mask);
-    ov::Tensor position_ids = prepare_vis_position_ids(pixel_values, patch_attention_mask, {resized_source_size}, ctx_clip.patch_size, ctx_clip.image_size / ctx_clip.patch_size);
     encoder.set_tensor("position_ids", position_ids);
     encoder.infer();
-    const ov::Tensor& output_tensor = encoder.get_output_tensor();
-    ov::Tensor resized_source{ov::element::f32, output_tensor.get_shape()};
-    output_tensor.copy_to(resized_source);
-
-    if (1 == preprocessed.size()) {
-        return {std::move(resized_source), resized_source_size};
-    }
+    return encoder.get_output_tensor();
+}
 
-    ImageSize raw_size{
-        size_t(preprocessed.at(1).at(0).ny),
-        size_t(preprocessed.at(1).at(0).nx)
-    };
-    ImageSize slices_size{
-        raw_size.height / patch_size,
-        raw_size.width / patch_size
-    };
-    size_t n_patches = slices_size.height * slices_size.width,
-        old_hidden_size = resized_source.get_shape().at(2);
-    ov::Tensor encoded_slices{ov::element::f32, {preprocessed.size() - 1, preprocessed.at(1).size(), n_patches, old_hidden_size}};
-    for (size_t row = 1; row < preprocessed.size(); ++row) {
-        for (size_t col = 0; col < preprocessed.at(row).size(); ++col) {
-            clip_image_f32& elem = preprocessed.at(row).at(col);
-            ov::Tensor pixel_values = preprocess_for_encoder(
-                {ov::element::f32, {1, 3, size_t(elem.ny), size_t(elem.nx)}, elem.buf.data()},
-                patch_size
-            );
-            encoder.set_tensor("pixel_values", pixel_values);
-            ov::Tensor patch_attention_mask{ov::element::boolean, {1, 1, slices_size.height * slices_size.width}};
-            std::fill_n(patch_attention_mask.data<bool>(), patch_attention_mask.get_size(), true);
-            encoder.set_tensor("patch_attention_mask", patch_attention_mask);
-            ov::Tensor position_ids = prepare_vis_position_ids(pixel_values, patch_attention_mask, {slices_size}, ctx_clip.patch_size, ctx_clip.image_size / ctx_clip.patch_size);
-            encoder.set_tensor("position_ids", position_ids);
-            const ov::Tensor& old = encoder.get_output_tensor();
-            encoder.set_output_tensor({ov::element::f32, {1, n_patches, old_hidden_size}, encoded_slices.data<float>() + ((row - 1) * preprocessed.at(row).size() + col) * n_patches * old_hidden_size});
-            encoder.infer();
-            encoder.set_output_tensor(old);
-        }
-    }
-    return {resized_source, resized_source_size, encoded_slices, slices_size};
+/// A model resizing [1, H, W, 3] uint8 image to target_size
+/// {height, width} with Pillow's bicubic filter, the filter used by
+/// HF image processors. The result differs slightly from
+/// bicubic_resize().
+std::shared_ptr<ov::Model> create_bicubic_resize_model() {
+    auto image = std::make_shared<ov::op::v0::Parameter>(ov::element::u8, ov::PartialShape{1, -1, -1, 3});
+    image->get_output_tensor(0).set_names({"image"});
+    auto target_size = std::make_shared<ov::op::v0::Parameter>(ov::element::i64, ov::Shape{2});
+    target_size->get_output_tensor(0).set_names({"target_size"});
+    auto image_f32 = std::make_shared<ov::op::v0::Convert>(image, ov::element::f32);
+    auto axes = std::make_shared<ov::op::v0::Constant>(ov::element::i64, ov::Shape{2}, std::vector<int64_t>{1, 2});
+    ov::op::v11::Interpolate::InterpolateAttrs attrs;
+    attrs.mode = ov::op::v11::Interpolate::InterpolateMode::BICUBIC_PILLOW;
+    attrs.shape_calculation_mode = ov::op::v11::Interpolate::ShapeCalcMode::SIZES;
+    attrs.coordinate_transformation_mode = ov::op::v11::Interpolate::CoordinateTransformMode::PYTORCH_HALF_PIXEL;
+    attrs.cube_coeff = -0.5;
+    auto resized = std::make_shared<ov::op::v11::Interpolate>(image_f32, target_size, axes, attrs);
+    auto rounded = std::make_shared<ov::op::v5::Round>(resized, ov::op::v5::Round::RoundMode::HALF_AWAY_FROM_ZERO);
+    auto clamped = std::make_shared<ov::op::v0::Clamp>(rounded, 0.0, 255.0);
+    auto resized_u8 = std::make_shared<ov::op::v0::Convert>(clamped, ov::element::u8);
+    return std::make_shared<ov::Model>(ov::OutputVector{resized_u8}, ov::ParameterVector{image, target_size}, "bicubic_resize");
 }
 
 ProcessorConfig from_any_map(
@@ -364,7 +383,7 @@ ProcessorConfig from_any_map(
 }
 
 
-ov::Tensor preprocess_image_llava(const ov::Tensor& image, const ProcessorConfig& config) {
+ov::Tensor preprocess_image_llava(const ov::Tensor& image, const ProcessorConfig& config, ov::InferRequest& resizer) {
     bool do_resize = true;
     bool do_center_crop = true;
 
@@ -382,60 +401,49 @@ ov::Tensor preprocess_image_llava(const ov::Tensor& image, const ProcessorConfig
         float scale = static_cast<float>(target_size) / std::min(input_image.nx, input_image.ny);
         int new_width = static_cast<int>(input_image.nx * scale);
         int new_height = static_cast<int>(input_image.ny * scale);
-        bicubic_resize(input_image, resized_image, new_width, new_height);
+        resize(input_image, resized_image, new_width, new_height, resizer);
     } else {
-        resized_image = input_image;
+        resized_image = std::move(input_image);
     }
 
-    // Center crop
-    clip_image_u8 cropped_image;
+    // Center crop is fused with normalization: only the cropped region is read.
+    int start_x = 0, start_y = 0;
+    int crop_width = resized_image.nx, crop_height = resized_image.ny;
     if (do_center_crop) {
-        int crop_height = config.crop_size_height;
-        int crop_width = config.crop_size_width;
-        int start_x = (resized_image.nx - crop_width) / 2;
-        int start_y = (resized_image.ny - crop_height) / 2;
-
-        cropped_image.nx = crop_width;
-        cropped_image.ny = crop_height;
-        cropped_image.buf.resize(3 * crop_width * crop_height);
-
-        for (int y = 0; y < crop_height; ++y) {
-            for (int x = 0; x < crop_width; ++x) {
-                for (int c = 0; c < 3; ++c) {
-                    cropped_image.buf[(y * crop_width + x) * 3 + c] = 
-                        resized_image.buf[((start_y + y) * resized_image.nx + (start_x + x)) * 3 + c];
-                }
-            }
-        }
-    } else {
-        cropped_image = resized_image;
+        crop_height = config.crop_size_height;
+        crop_width = config.crop_size_width;
+        start_x = (resized_image.nx - crop_width) / 2;
+        start_y = (resized_image.ny - crop_height) / 2;
     }
 
-    // Normalize
+    // Normalize and convert to NCHW
     clip_ctx ctx;
     std::copy(config.image_mean.begin(), config.image_mean.end(), ctx.image_mean);
     std::copy(config.image_std.begin(), config.image_std.end(), ctx.image_std);
 
-    clip_image_f32 normalized_image = clip_image_preprocess(ctx, cropped_image);
-
-    // Convert clip_image_f32 to ov::Tensor
-    ov::Tensor result(
-        ov::element::f32,
-        {1, 3, size_t(normalized_image.ny), size_t(normalized_image.nx)},
-        (void*)(normalized_image.buf.data())
-    );
-
+    ov::Tensor result(ov::element::f32, {1, 3, size_t(crop_height), size_t(crop_width)});
+    clip_image_preprocess(ctx, resized_image, start_x, start_y, crop_width, crop_height, result.data<float>());
     return result;
 }
 }
 
 VisionEncoder::VisionEncoder(const std::filesystem::path& model_dir, const VLMModelType model_type, const std::string& device, const ov::AnyMap device_config, ov::Core core) :
     model_type(model_type) {
+        ov::AnyMap compile_config{device_config};
+        bool resize_in_model = false;
+        auto found = compile_config.find(image_resize_in_model.name());
+        if (compile_config.end() != found) {
+            resize_in_model = found->second.as<bool>();
+            compile_config.erase(found);
+        }
         if (model_type == VLMModelType::MINICPM) {
-            m_vision_encoder = core.compile_model(model_dir / "image_encoder.xml", device, device_config).create_infer_request();
+            m_vision_encoder = core.compile_model(model_dir / "image_encoder.xml", device, compile_config).create_infer_request();
         } else if (model_type == VLMModelType::LLAVA) {
             // Vision embeddings model is merged with multi modal projector at model export stage by optimum-intel
-            m_vision_encoder = core.compile_model(model_dir / "openvino_vision_embeddings_model.xml", device, device_config).create_infer_request();
+            m_vision_encoder = core.compile_model(model_dir / "openvino_vision_embeddings_model.xml", device, compile_config).create_infer_request();
+        }
+        if (resize_in_model) {
+            m_image_resizer = core.compile_model(create_bicubic_resize_model(), device, compile_config).create_infer_request();
         }
         m_processor_config = ov::genai::utils::from_config_json_if_exists<ov::genai::ProcessorConfig>(
             model_dir, "preprocessor_config.json"
@@ -444,7 +452,7 @@ VisionEncoder::VisionEncoder(const std::filesystem::path& model_dir, const VLMMo
 
 EncodedImage VisionEncoder::encode(const ov::Tensor& image, const ProcessorConfig& config) {
     if (model_type == VLMModelType::MINICPM) {
-        return encode_minicpm(image, config);
+        return encode_minicpm({image}, config).at(0);
     } else if (model_type == VLMModelType::LLAVA) {
         return encode_llava(image, config);
     }
@@ -456,17 +464,80 @@ EncodedImage VisionEncoder::encode(const ov::Tensor& image, const ov::AnyMap& co
     ));
 }
 
-EncodedImage VisionEncoder::encode_minicpm(const ov::Tensor& image, const ProcessorConfig& config) {
+ImageSize VisionEncoder::get_slices_grid(const ov::Tensor& image) const {
+    OPENVINO_ASSERT(model_type == VLMModelType::MINICPM, "Only MiniCPM slices images");
+    std::pair<int, int> grid = find_best_grid(
+        // The same width and height as preprocess_minicpm() takes.
+        {int(image.get_shape().at(3)), int(image.get_shape().at(2))},
+        m_processor_config.max_slice_nums,
+        m_processor_config.scale_resolution
+    );
+    return {size_t(grid.second), size_t(grid.first)};
+}
+
+std::vector<EncodedImage> VisionEncoder::encode_batch(const std::vector<ov::Tensor>& images, const ProcessorConfig& config) {
+    if (model_type == VLMModelType::MINICPM) {
+        return encode_minicpm(images, config);
+    }
+    std::vector<EncodedImage> encoded;
+    for (const ov::Tensor& image : images) {
+        encoded.push_back(encode(image, config));
+    }
+    return encoded;
+}
+
+std::vector<EncodedImage> VisionEncoder::encode_minicpm(const std::vector<ov::Tensor>& images, const ProcessorConfig& config) {
+    if (images.empty()) {
+        return {};
+    }
     clip_ctx ctx_clip;
     ctx_clip.patch_size = m_processor_config.patch_size;
     ctx_clip.image_size = m_processor_config.image_size;
     std::copy(config.norm_mean.begin(), config.norm_mean.end(), ctx_clip.image_mean);
     std::copy(config.norm_std.begin(), config.norm_std.end(), ctx_clip.image_std);
-    return llava_image_embed_make_with_bytes_slice(ctx_clip, image, m_vision_encoder, config.max_slice_nums, config.scale_resolution, config.patch_size, 0 == config.max_slice_nums);
+
+    std::vector<PreprocessedImage> preprocessed;
+    std::vector<ov::Tensor> pixel_values;
+    std::vector<ImageSize> sizes;
+    for (const ov::Tensor& image : images) {
+        preprocessed.push_back(preprocess_minicpm(ctx_clip, image, config.max_slice_nums, config.scale_resolution, config.patch_size, 0 == config.max_slice_nums, m_image_resizer));
+        pixel_values.push_back(preprocessed.back().resized_source);
+        sizes.push_back(preprocessed.back().resized_source_size);
+        for (const ov::Tensor& slice : preprocessed.back().slices) {
+            pixel_values.push_back(slice);
+            sizes.push_back(preprocessed.back().slices_size);
+        }
+    }
+
+    // Resized sources and slices of all images are encoded in one inference.
+    const ov::Tensor& output = encode_padded(m_vision_encoder, pixel_values, sizes, ctx_clip, config.patch_size);
+    const size_t max_patches = output.get_shape().at(1), hidden_size = output.get_shape().at(2);
+    const float* output_data = output.data<float>();
+    size_t item_idx = 0;
+    std::vector<EncodedImage> encoded;
+    for (const PreprocessedImage& image : preprocessed) {
+        EncodedImage encoded_image;
+        encoded_image.resized_source_size = image.resized_source_size;
+        size_t n_patches = image.resized_source_size.height * image.resized_source_size.width;
+        encoded_image.resized_source = ov::Tensor{ov::element::f32, {1, n_patches, hidden_size}};
+        std::copy_n(output_data + item_idx * max_patches * hidden_size, n_patches * hidden_size, encoded_image.resized_source.data<float>());
+        ++item_idx;
+        if (!image.slices.empty()) {
+            encoded_image.slices_size = image.slices_size;
+            n_patches = image.slices_size.height * image.slices_size.width;
+            encoded_image.slices = ov::Tensor{ov::element::f32, {size_t(image.grid.second), size_t(image.grid.first), n_patches, hidden_size}};
+            float* slices_data = encoded_image.slices.data<float>();
+            for (size_t slice_idx = 0; slice_idx < image.slices.size(); ++slice_idx, ++item_idx) {
+                std::copy_n(output_data + item_idx * max_patches * hidden_size, n_patches * hidden_size, slices_data + slice_idx * n_patches * hidden_size);
+            }
+        }
+        encoded.push_back(std::move(encoded_image));
+    }
+    return encoded;
 }
 
 EncodedImage VisionEncoder::encode_llava(const ov::Tensor& image, const ProcessorConfig& config) {
-    ov::Tensor preprocessed_image = preprocess_image_llava(image, config);
+    ov::Tensor preprocessed_image = preprocess_image_llava(image, config, m_image_resizer);
 
     m_vision_encoder.set_tensor("pixel_values", preprocessed_image);
     m_vision_encoder.infer();
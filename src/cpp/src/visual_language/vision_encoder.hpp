@@ -48,6 +48,10 @@ public:
     ov::InferRequest m_vision_encoder;
     /// @brief A config to follow.
     ProcessorConfig m_processor_config;
+    /// @brief An optional model resizing images instead of the
+    /// reference bicubic implementation. Compiled if
+    /// image_resize_in_model is set.
+    ov::InferRequest m_image_resizer;
 
     /// @brief Construct from an already compiled model and a config.
     /// @param encoder Compiled model.
@@ -62,7 +66,8 @@ public:
     /// preprocessor_config.json.
     /// @param device A device to compile the encoder for.
     /// @param device_config A config to be passed to
-    /// ov::Core::compile_model().
+    /// ov::Core::compile_model(). May also contain
+    /// image_resize_in_model.
     /// @param core ov::Core to be used to compile the model.
     explicit VisionEncoder(
         const std::filesystem::path& model_dir,
@@ -92,6 +97,15 @@ public:
         const ov::Tensor& image, const ProcessorConfig& config
     );
 
+    /// @brief Compute the grid MiniCPM slices an image into following
+    /// the config obtained in constructors. The grid only depends on
+    /// the image size, so a prompt can be built while the image is
+    /// being encoded.
+    /// @param image An image of the same layout encode_batch() takes.
+    /// @return Rows and columns of the grid. {0, 0} if the image isn't
+    /// sliced.
+    ImageSize get_slices_grid(const ov::Tensor& image) const;
+
     /// @brief Compute embeddings of an image given
     /// ProcessorConfig members.
     /// @param image An image to infer embeddings for. Image shape must be
@@ -104,6 +118,28 @@ public:
         const ov::Tensor& image, const ov::AnyMap& config_map
     );
 
+    /// @brief Compute embeddings of several images. MiniCPM encodes
+    /// resized sources and slices of all images in a single inference
+    /// padding them to the longest one, other models encode images one
+    /// by one.
+    /// @param images Images to infer embeddings for. Every image shape
+    /// must be [1CHW].
+    /// @return Embeddings of every image in the order of images.
+    std::vector<EncodedImage> encode_batch(const std::vector<ov::Tensor>& images) {
+        return encode_batch(images, m_processor_config);
+    }
+
+    /// @brief Compute embeddings of several images given
+    /// ProcessorConfig.
+    /// @param images Images to infer embeddings for. Every image shape
+    /// must be [1CHW].
+    /// @param config A config to follow instead of the config obtained
+    /// in constructors.
+    /// @return Embeddings of every image in the order of images.
+    std::vector<EncodedImage> encode_batch(
+        const std::vector<ov::Tensor>& images, const ProcessorConfig& config
+    );
+
     /// @brief Compute embeddings of an image given
     /// ProcessorConfig members.
     /// @param image An image to infer embeddings for. Image shape must be
@@ -123,8 +159,8 @@ public:
     }
 
 private:
-    EncodedImage encode_minicpm(
-        const ov::Tensor& image, const ProcessorConfig& config
+    std::vector<EncodedImage> encode_minicpm(
+        const std::vector<ov::Tensor>& images, const ProcessorConfig& config
     );
 
     EncodedImage encode_llava(
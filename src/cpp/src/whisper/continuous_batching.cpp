@@ -0,0 +1,436 @@
+// Copyright (C) 2023-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "continuous_batching.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <openvino/op/constant.hpp>
+#include <openvino/op/gather.hpp>
+#include <openvino/op/parameter.hpp>
+#include <openvino/op/result.hpp>
+
+#include "logit_processor.hpp"
+#include "paged_attention_transformations.hpp"
+#include "timestamps.hpp"
+
+namespace {
+
+// present.N.encoder.* outputs of the decoder depend only on encoder hidden states, so the decoder cut to them computes
+// cross-attention cache without decoding of input ids
+std::shared_ptr<ov::Model> get_cross_attention_cache_model(const std::shared_ptr<ov::Model>& decoder) {
+    ov::ResultVector results;
+    for (const auto& output : decoder->outputs()) {
+        if (output.get_any_name().find(".encoder.") != std::string::npos) {
+            results.push_back(ov::as_type_ptr<ov::op::v0::Result>(output.get_node_shared_ptr()));
+        }
+    }
+    OPENVINO_ASSERT(!results.empty(), "Whisper decoder model has no present.N.encoder.* outputs");
+
+    // input_ids remain an input only if the cut graph depends on them, e.g. takes the batch size from them
+    auto model = std::make_shared<ov::Model>(results, decoder->get_parameters());
+    ov::ParameterVector parameters;
+    for (const auto& op : model->get_ordered_ops()) {
+        if (auto parameter = ov::as_type_ptr<ov::op::v0::Parameter>(op)) {
+            parameters.push_back(parameter);
+        }
+    }
+    return std::make_shared<ov::Model>(results, parameters, "cross_attention_cache");
+}
+
+// Inputs with the given names become stacked by slots, each consumer takes the rows of the slots listed in the new
+// encoder_slots input, one slot per token
+void gather_encoder_inputs(const std::shared_ptr<ov::Model>& model, const std::vector<std::string>& names) {
+    auto slots = std::make_shared<ov::op::v0::Parameter>(ov::element::i64, ov::PartialShape{-1});
+    slots->set_friendly_name("encoder_slots");
+    slots->get_output_tensor(0).set_names({"encoder_slots"});
+    auto axis = ov::op::v0::Constant::create(ov::element::i64, {}, {0});
+
+    for (const auto& name : names) {
+        ov::Output<ov::Node> input = model->input(name);
+        // targets are taken before the gather becomes one of them
+        auto targets = input.get_target_inputs();
+        auto gather = std::make_shared<ov::op::v8::Gather>(input, slots, axis);
+        for (auto target : targets) {
+            target.replace_source_output(gather);
+        }
+    }
+    model->add_parameters({slots});
+    model->validate_nodes_and_infer_types();
+}
+
+}  // namespace
+
+namespace ov {
+namespace genai {
+
+WhisperContinuousBatchingEngine::WhisperContinuousBatchingEngine(const std::filesystem::path& model_path,
+                                                                 const SchedulerConfig& scheduler_config,
+                                                                 const std::string& device,
+                                                                 const ov::AnyMap& compile_plugin_config,
+                                                                 ov::Core& core,
+                                                                 const Tokenizer& tokenizer,
+                                                                 const WhisperConfig& model_config,
+                                                                 WhisperInitializedModels& models,
+                                                                 WhisperFeatureExtractor& feature_extractor)
+    : m_model_config{model_config},
+      m_models{models},
+      m_feature_extractor{feature_extractor} {
+    auto model = core.read_model((model_path / "openvino_decoder_with_past_model.xml").string());
+    const auto& inputs = model->inputs();
+    OPENVINO_ASSERT(std::any_of(inputs.begin(), inputs.end(), [](const ov::Output<ov::Node>& input) {
+                        return input.get_names().count("cache_position") > 0;
+                    }),
+                    "Whisper decoder_with_past model without cache_position input is not supported by continuous "
+                    "batching, re-export the model with a newer optimum-intel");
+    // paged attention transformations require self-attention cache in variables
+    make_decoder_with_past_stateful(model);
+
+    DeviceConfig device_config(core, scheduler_config, device, compile_plugin_config);
+    apply_paged_attention_transformations(model, device_config);
+
+    for (const auto& input : model->inputs()) {
+        const std::string& name = input.get_any_name();
+        if (name == "encoder_hidden_states" || name.find("past_key_values") != std::string::npos) {
+            m_encoder_input_names.push_back(name);
+        }
+    }
+    gather_encoder_inputs(model, m_encoder_input_names);
+
+    auto decoder = core.read_model((model_path / "openvino_decoder_model.xml").string());
+    m_cross_attention_cache =
+        core.compile_model(get_cross_attention_cache_model(decoder), device_config.get_device(), compile_plugin_config)
+            .create_infer_request();
+
+    ov::InferRequest infer_request =
+        core.compile_model(model, device_config.get_device(), compile_plugin_config).create_infer_request();
+
+    m_cache_manager = std::make_shared<CacheManager>(device_config, core);
+    for (size_t decoder_layer_id = 0; decoder_layer_id < device_config.get_num_layers(); ++decoder_layer_id) {
+        infer_request.set_tensor(std::string("key_cache.") + std::to_string(decoder_layer_id),
+                                 m_cache_manager->get_key_cache(decoder_layer_id));
+        infer_request.set_tensor(std::string("value_cache.") + std::to_string(decoder_layer_id),
+                                 m_cache_manager->get_value_cache(decoder_layer_id));
+    }
+
+    SchedulerConfig updated_config = scheduler_config;
+    updated_config.num_kv_blocks = device_config.get_num_kv_blocks();
+    // cache eviction relies on attention scores outputs which are not requested from the transformations
+    updated_config.use_cache_eviction = false;
+
+    m_scheduler = std::make_shared<Scheduler>(updated_config, device_config.get_num_layers());
+    m_model_runner = std::make_shared<ModelRunner>(infer_request, updated_config, device_config.get_num_layers());
+    m_sampler = std::make_shared<Sampler>(tokenizer);
+
+    m_raw_metrics.m_inference_durations = {{MicroSeconds(0.0f)}};
+}
+
+GenerationHandle WhisperContinuousBatchingEngine::add_request(uint64_t request_id,
+                                                              const RawSpeechInput& raw_speech,
+                                                              const WhisperGenerationConfig& config) {
+    RequestData request_data;
+    request_data.config = config;
+
+    WhisperEncodedInput encoded_input;
+    {
+        std::lock_guard<std::mutex> lock{m_encoder_mutex};
+        encoded_input = whisper_encode(config, raw_speech, m_models, m_feature_extractor);
+
+        for (const auto& input : m_cross_attention_cache.get_compiled_model().inputs()) {
+            const std::string& name = input.get_any_name();
+            if (name == "input_ids") {
+                // the cache doesn't depend on the token, only on the batch size of input_ids
+                ov::Tensor input_ids(ov::element::i64, {1, 1});
+                input_ids.data<int64_t>()[0] = encoded_input.init_ids.front();
+                m_cross_attention_cache.set_tensor(input, input_ids);
+            } else {
+                OPENVINO_ASSERT(name == "encoder_hidden_states", "Unexpected cross-attention cache model input ", name);
+                m_cross_attention_cache.set_tensor(input, encoded_input.encoder_hidden_states);
+            }
+        }
+        m_cross_attention_cache.infer();
+
+        for (const auto& output : m_cross_attention_cache.get_compiled_model().outputs()) {
+            const ov::Tensor& cache = m_cross_attention_cache.get_tensor(output);
+            // present.0.encoder.key -> past_key_values.0.encoder.key
+            const std::string name = "past_key_values" + output.get_any_name().substr(std::string("present").size());
+            ov::Tensor& input = request_data.decoder_with_past_inputs[name];
+            input = ov::Tensor(cache.get_element_type(), cache.get_shape());
+            cache.copy_to(input);
+        }
+    }
+    request_data.decoder_with_past_inputs["encoder_hidden_states"] = encoded_input.encoder_hidden_states;
+
+    // decoding is greedy, whisper specific logits processing is applied before sampling
+    GenerationConfig sampling_params;
+    sampling_params.max_new_tokens = config.get_max_new_tokens(encoded_input.init_ids.size());
+    sampling_params.set_eos_token_id(config.eos_token_id);
+    sampling_params.validate();
+
+    SequenceGroup::Ptr sequence_group = std::make_shared<SequenceGroup>(request_id,
+                                                                        encoded_input.init_ids,
+                                                                        sampling_params,
+                                                                        m_scheduler->get_config().block_size,
+                                                                        false);
+    sequence_group->set_sequence_group_ptr(sequence_group);
+
+    {
+        std::lock_guard<std::mutex> lock{m_awaiting_requests_mutex};
+        m_awaiting_requests.emplace_back(sequence_group, std::move(request_data));
+    }
+    return std::make_shared<GenerationHandleImpl>(sequence_group->get_generation_stream(), sampling_params);
+}
+
+bool WhisperContinuousBatchingEngine::has_non_finished_requests() {
+    std::lock_guard<std::mutex> lock{m_awaiting_requests_mutex};
+    return !m_awaiting_requests.empty() || !m_requests.empty();
+}
+
+void WhisperContinuousBatchingEngine::step() {
+    std::vector<std::pair<SequenceGroup::Ptr, RequestData>> awaiting_requests;
+    {
+        std::lock_guard<std::mutex> lock{m_awaiting_requests_mutex};
+        awaiting_requests.swap(m_awaiting_requests);
+    }
+    for (auto& [sequence_group, request_data] : awaiting_requests) {
+        RequestData& data = m_request_data[sequence_group->get_request_id()] = std::move(request_data);
+        allocate_encoder_slot(data);
+        m_requests.push_back(sequence_group);
+    }
+
+    Scheduler::Output scheduler_output = m_scheduler->schedule(m_requests);
+    m_cache_manager->copy_blocks(scheduler_output.m_block_copy_map);
+
+    // if no tokens were scheduled, we are out of memory
+    if (scheduler_output.m_total_num_scheduled_tokens == 0) {
+        for (auto& sequence_group : m_requests) {
+            sequence_group->set_out_of_memory();
+            sequence_group->notify_handle();
+        }
+        free_non_running_requests();
+        return;
+    }
+
+    set_encoder_inputs(scheduler_output);
+
+    const auto infer_start = std::chrono::steady_clock::now();
+    ov::Tensor logits = m_model_runner->forward(m_requests, scheduler_output);
+    const auto infer_end = std::chrono::steady_clock::now();
+    const auto infer_ms = PerfMetrics::get_microsec(infer_end - infer_start);
+    m_raw_metrics.m_inference_durations[0] += MicroSeconds(infer_ms);
+    m_raw_metrics.m_token_infer_durations.emplace_back(infer_ms);
+    m_raw_metrics.m_new_token_times.emplace_back(infer_end);
+    m_raw_metrics.m_batch_sizes.emplace_back(scheduler_output.m_scheduled_sequence_groups_ids.size());
+
+    process_logits(logits);
+
+    SamplerOutput sampler_output = m_sampler->sample(m_requests, logits);
+    for (const auto& [parent_id, child_ids] : sampler_output.m_forked_sequences) {
+        for (auto child_id : child_ids) {
+            m_scheduler->fork_sequence(parent_id, child_id);
+        }
+    }
+    for (auto seq_id : sampler_output.m_dropped_sequences) {
+        m_scheduler->free_sequence(seq_id);
+    }
+
+    for (auto& sequence_group : m_requests) {
+        if (sequence_group->handle_dropped()) {
+            sequence_group->push_empty_outputs();
+        }
+    }
+
+    free_non_running_requests();
+}
+
+// Copies encoder dependent inputs of a new request to a free slot, they stay there until the request is freed
+void WhisperContinuousBatchingEngine::allocate_encoder_slot(RequestData& request_data) {
+    if (m_free_encoder_slots.empty()) {
+        // slots are kept by their index, so the content of the previous tensors is moved to the beginning
+        const size_t num_slots = std::max<size_t>(1, m_num_encoder_slots * 2);
+        ov::InferRequest infer_request = m_model_runner->get_infer_request();
+        for (const auto& name : m_encoder_input_names) {
+            const ov::Tensor& input = request_data.decoder_with_past_inputs.at(name);
+            ov::Shape shape = input.get_shape();
+            shape[0] = num_slots;
+
+            ov::Tensor stacked(input.get_element_type(), shape);
+            ov::Tensor& current = m_encoder_inputs[name];
+            if (current) {
+                std::memcpy(stacked.data(), current.data(), current.get_byte_size());
+            }
+            current = stacked;
+            infer_request.set_tensor(name, current);
+        }
+        for (size_t slot = num_slots; slot > m_num_encoder_slots; --slot) {
+            m_free_encoder_slots.push_back(slot - 1);
+        }
+        m_num_encoder_slots = num_slots;
+    }
+
+    request_data.slot = m_free_encoder_slots.back();
+    m_free_encoder_slots.pop_back();
+    for (const auto& name : m_encoder_input_names) {
+        const ov::Tensor& input = request_data.decoder_with_past_inputs.at(name);
+        const size_t slot_byte_size = input.get_byte_size();
+        std::memcpy(static_cast<uint8_t*>(m_encoder_inputs.at(name).data()) + request_data.slot * slot_byte_size,
+                    input.data(),
+                    slot_byte_size);
+    }
+    request_data.decoder_with_past_inputs.clear();
+}
+
+// After paged attention transformations tokens of all sequences are enumerated along the batch dimension of
+// activations, so encoder dependent inputs are gathered from the slot of the owning request for each scheduled token.
+// The order of tokens is the same as in ModelRunner::forward.
+void WhisperContinuousBatchingEngine::set_encoder_inputs(const Scheduler::Output& scheduler_output) {
+    std::vector<int64_t> token_slots;
+    std::vector<int64_t> token_positions;
+    for (size_t seq_group_id : scheduler_output.m_scheduled_sequence_groups_ids) {
+        const auto& sequence_group = m_requests[seq_group_id];
+        const size_t slot = m_request_data.at(sequence_group->get_request_id()).slot;
+        const size_t num_scheduled_tokens = sequence_group->get_num_scheduled_tokens();
+        const size_t position = sequence_group->get_num_processed_tokens();
+        for (size_t seq_id = 0; seq_id < sequence_group->num_running_seqs(); ++seq_id) {
+            for (size_t token_id = 0; token_id < num_scheduled_tokens; ++token_id) {
+                token_slots.push_back(slot);
+                token_positions.push_back(position + token_id);
+            }
+        }
+    }
+
+    ov::InferRequest infer_request = m_model_runner->get_infer_request();
+
+    ov::Tensor encoder_slots(ov::element::i64, {token_slots.size()});
+    std::copy(token_slots.begin(), token_slots.end(), encoder_slots.data<int64_t>());
+    infer_request.set_tensor("encoder_slots", encoder_slots);
+
+    ov::Tensor cache_position(ov::element::i64, {token_positions.size()});
+    std::copy(token_positions.begin(), token_positions.end(), cache_position.data<int64_t>());
+    infer_request.set_tensor("cache_position", cache_position);
+}
+
+// Applies tokens suppression and timestamps rules to the logits of tokens which are sampled in this step,
+// logits layout is the same as expected by Sampler::sample
+void WhisperContinuousBatchingEngine::process_logits(ov::Tensor& logits) {
+    const ov::Shape logits_shape = logits.get_shape();
+    const size_t batch_seq_len = logits_shape[1], vocab_size = logits_shape[2];
+    float* logits_data = logits.data<float>();
+
+    size_t currently_processed_tokens = 0;
+    for (auto& sequence_group : m_requests) {
+        if (!sequence_group->is_scheduled()) {
+            continue;
+        }
+
+        const size_t num_running_sequences = sequence_group->num_running_seqs();
+        const size_t actual_seq_len = sequence_group->get_num_scheduled_tokens();
+        if (sequence_group->requires_sampling()) {
+            const WhisperGenerationConfig& config = m_request_data.at(sequence_group->get_request_id()).config;
+            auto running_sequences = sequence_group->get_running_sequences();
+            for (size_t seq_id = 0; seq_id < num_running_sequences; ++seq_id) {
+                float* token_logits =
+                    logits_data + (currently_processed_tokens + seq_id * actual_seq_len + actual_seq_len - 1) * vocab_size;
+                ov::Tensor token_logits_tensor(ov::element::f32, {1, 1, vocab_size}, token_logits);
+
+                const auto& generated_ids = running_sequences[seq_id]->get_generated_ids();
+                const bool initial_step = generated_ids.empty();
+                if (initial_step) {
+                    do_suppress_tokens(token_logits_tensor, 0, config.begin_suppress_tokens);
+                }
+                do_suppress_tokens(token_logits_tensor, 0, config.suppress_tokens);
+                if (config.return_timestamps) {
+                    process_whisper_timestamp_logits(token_logits_tensor, 0, config, generated_ids, initial_step);
+                }
+            }
+        }
+
+        currently_processed_tokens += std::max(actual_seq_len, batch_seq_len) * num_running_sequences;
+    }
+}
+
+void WhisperContinuousBatchingEngine::free_non_running_requests() {
+    auto requests_iterator = m_requests.begin();
+    while (requests_iterator != m_requests.end()) {
+        const auto& request = *requests_iterator;
+        if (request->has_finished() || request->out_of_memory() || request->handle_dropped()) {
+            for (const auto& sequence : request->get_sequences()) {
+                if (m_scheduler->has_block_table(sequence->get_id())) {
+                    m_scheduler->free_sequence(sequence->get_id());
+                }
+            }
+            m_sampler->clear_beam_search_info(request->get_request_id());
+            m_free_encoder_slots.push_back(m_request_data.at(request->get_request_id()).slot);
+            m_request_data.erase(request->get_request_id());
+            requests_iterator = m_requests.erase(requests_iterator);
+        } else {
+            requests_iterator++;
+        }
+    }
+}
+
+std::vector<WhisperGenerateResult> WhisperContinuousBatchingEngine::generate(
+    const std::vector<RawSpeechInput>& raw_speech_inputs,
+    const WhisperGenerationConfig& config) {
+    OPENVINO_ASSERT(!has_non_finished_requests(),
+                    "Generate cannot be called while requests added by add_request are not finished");
+
+    m_raw_metrics = RawPerfMetrics{};
+    m_raw_metrics.m_inference_durations = {{MicroSeconds(0.0f)}};
+
+    std::vector<GenerationHandle> generations;
+    for (size_t request_id = 0; request_id < raw_speech_inputs.size(); ++request_id) {
+        generations.push_back(add_request(request_id, raw_speech_inputs[request_id], config));
+    }
+
+    while (has_non_finished_requests()) {
+        try {
+            step();
+        } catch (...) {
+            for (auto& sequence_group : m_requests) {
+                for (const auto& sequence : sequence_group->get_sequences()) {
+                    if (m_scheduler->has_block_table(sequence->get_id())) {
+                        m_scheduler->free_sequence(sequence->get_id());
+                    }
+                }
+            }
+            for (const auto& [request_id, request_data] : m_request_data) {
+                m_free_encoder_slots.push_back(request_data.slot);
+            }
+            m_requests.clear();
+            m_request_data.clear();
+            throw;
+        }
+    }
+
+    // 0.02 by default
+    const float time_precision =
+        static_cast<float>(m_feature_extractor.chunk_length) / m_model_config.max_source_positions;
+
+    std::vector<WhisperGenerateResult> results(generations.size());
+    for (size_t i = 0; i < generations.size(); ++i) {
+        std::vector<GenerationOutput> outputs = generations[i]->read_all();
+        OPENVINO_ASSERT(!outputs.empty(), "Request ", i, " has no outputs, status: ", int(generations[i]->get_status()));
+        std::vector<int64_t> tokens = std::move(outputs.front().generated_ids);
+        if (!tokens.empty() && tokens.back() == config.eos_token_id) {
+            tokens.pop_back();
+        }
+
+        auto& result = results[i];
+        if (config.return_timestamps) {
+            auto extracted_segments =
+                extract_segments(tokens, config, m_feature_extractor.nb_max_frames, time_precision);
+            result.output_tokens = std::move(extracted_segments.non_timestamp_tokens);
+            result.segments = std::move(extracted_segments.segments);
+        } else {
+            result.output_tokens = std::move(tokens);
+        }
+        result.perf_metrics.num_input_tokens = 0;
+        result.perf_metrics.raw_metrics = m_raw_metrics;
+    }
+
+    return results;
+}
+
+}  // namespace genai
+}  // namespace ov
@@ -0,0 +1,107 @@
+// Copyright (C) 2023-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <openvino/openvino.hpp>
+
+#include "cache_manager.hpp"
+#include "model_runner.hpp"
+#include "openvino/genai/generation_handle.hpp"
+#include "openvino/genai/scheduler_config.hpp"
+#include "openvino/genai/tokenizer.hpp"
+#include "openvino/genai/whisper_generation_config.hpp"
+#include "sampler.hpp"
+#include "scheduler.hpp"
+#include "whisper.hpp"
+#include "whisper_config.hpp"
+#include "whisper_feature_extractor.hpp"
+#include "whisper_models.hpp"
+
+namespace ov {
+namespace genai {
+
+/**
+ * Decodes many Whisper requests together the same way ContinuousBatchingPipeline does for LLM requests:
+ * decoder_with_past is converted to paged attention, its self-attention cache is managed by Scheduler and decode
+ * steps of all running requests are inferred in one batch.
+ *
+ * Each request is encoded once in add_request() and its cross-attention cache is computed by a model cut from the
+ * decoder to the present.N.encoder.* outputs, so init_ids are prefilled only by the paged decoder_with_past.
+ * Encoder hidden states and cross-attention cache of each running request are copied once to a slot of stacked
+ * decoder_with_past inputs, the model gathers them for each scheduled token by the encoder_slots input. Inputs longer
+ * than 30 seconds are not supported, WhisperPipeline decodes them with whisper_generate.
+ */
+class WhisperContinuousBatchingEngine {
+public:
+    WhisperContinuousBatchingEngine(const std::filesystem::path& model_path,
+                                    const SchedulerConfig& scheduler_config,
+                                    const std::string& device,
+                                    const ov::AnyMap& compile_plugin_config,
+                                    ov::Core& core,
+                                    const Tokenizer& tokenizer,
+                                    const WhisperConfig& model_config,
+                                    WhisperInitializedModels& models,
+                                    WhisperFeatureExtractor& feature_extractor);
+
+    GenerationHandle add_request(uint64_t request_id,
+                                 const RawSpeechInput& raw_speech,
+                                 const WhisperGenerationConfig& config);
+
+    bool has_non_finished_requests();
+
+    void step();
+
+    std::vector<WhisperGenerateResult> generate(const std::vector<RawSpeechInput>& raw_speech_inputs,
+                                                const WhisperGenerationConfig& config);
+
+private:
+    struct RequestData {
+        WhisperGenerationConfig config;
+        // encoder dependent inputs of decoder_with_past with batch size 1, released when copied to the slot
+        std::map<std::string, ov::Tensor> decoder_with_past_inputs;
+        size_t slot = 0;
+    };
+
+    void allocate_encoder_slot(RequestData& request_data);
+    void set_encoder_inputs(const Scheduler::Output& scheduler_output);
+    void process_logits(ov::Tensor& logits);
+    void free_non_running_requests();
+
+    WhisperConfig m_model_config;
+    WhisperInitializedModels& m_models;
+    WhisperFeatureExtractor& m_feature_extractor;
+
+    std::shared_ptr<Scheduler> m_scheduler;
+    std::shared_ptr<CacheManager> m_cache_manager;
+    std::shared_ptr<ModelRunner> m_model_runner;
+    std::shared_ptr<Sampler> m_sampler;
+
+    // computes cross-attention cache of an encoded window, guarded by m_encoder_mutex
+    ov::InferRequest m_cross_attention_cache;
+
+    // inputs of decoder_with_past which are taken from RequestData::decoder_with_past_inputs
+    std::vector<std::string> m_encoder_input_names;
+    // Encoder dependent inputs stacked by slots. A slot holds encoder hidden states and cross-attention cache of all
+    // layers (several MB) of one running request for its lifetime, the tensors grow twice when all slots are taken.
+    std::map<std::string, ov::Tensor> m_encoder_inputs;
+    size_t m_num_encoder_slots = 0;
+    std::vector<size_t> m_free_encoder_slots;
+
+    std::vector<SequenceGroup::Ptr> m_requests;
+    std::map<uint64_t, RequestData> m_request_data;
+
+    // requests added to the engine that will be added to m_requests in the next step
+    std::vector<std::pair<SequenceGroup::Ptr, RequestData>> m_awaiting_requests;
+    std::mutex m_awaiting_requests_mutex;
+    // encoder and decoder infer requests are shared by add_request calls from different threads
+    std::mutex m_encoder_mutex;
+
+    RawPerfMetrics m_raw_metrics;
+};
+
+}  // namespace genai
+}  // namespace ov
@@ -0,0 +1,278 @@
+// Copyright (C) 2023-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#ifdef _WIN32
+#    define _USE_MATH_DEFINES
+#endif
+
+#include "fft.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <initializer_list>
+#include <openvino/core/except.hpp>
+
+namespace {
+using Complex = std::complex<float>;
+
+// Plain complex multiplication, std::complex operator* handles inf/nan corner cases and is much slower
+inline Complex mul(const Complex& a, const Complex& b) {
+    return {a.real() * b.real() - a.imag() * b.imag(), a.real() * b.imag() + a.imag() * b.real()};
+}
+
+// -i * a
+inline Complex mul_neg_i(const Complex& a) {
+    return {a.imag(), -a.real()};
+}
+
+Complex unit_root(const size_t numerator, const size_t denominator) {
+    const double theta = -2.0 * M_PI * double(numerator) / double(denominator);
+    return {float(std::cos(theta)), float(std::sin(theta))};
+}
+
+// Radices in the order of stages of the recursive decomposition, larger specialized radices go first
+std::vector<size_t> factorize(size_t n) {
+    std::vector<size_t> radices;
+    for (size_t radix : std::initializer_list<size_t>{4, 2, 5, 3}) {
+        while (n % radix == 0) {
+            radices.push_back(radix);
+            n /= radix;
+        }
+    }
+    for (size_t radix = 7; radix * radix <= n; radix += 2) {
+        while (n % radix == 0) {
+            radices.push_back(radix);
+            n /= radix;
+        }
+    }
+    if (n > 1) {
+        radices.push_back(n);
+    }
+    return radices;
+}
+
+// Decimation in time: sub-sequence q of every level is placed to a contiguous block q,
+// so each stage combines adjacent sub-transforms in place
+void build_permutation(const std::vector<size_t>& radices,
+                       const size_t level,
+                       const size_t input_offset,
+                       const size_t input_stride,
+                       const size_t output_offset,
+                       const size_t size,
+                       std::vector<size_t>& permutation) {
+    if (size == 1) {
+        permutation[output_offset] = input_offset;
+        return;
+    }
+    const size_t radix = radices[level];
+    const size_t sub_size = size / radix;
+    for (size_t q = 0; q < radix; q++) {
+        build_permutation(radices,
+                          level + 1,
+                          input_offset + q * input_stride,
+                          input_stride * radix,
+                          output_offset + q * sub_size,
+                          sub_size,
+                          permutation);
+    }
+}
+
+inline void butterfly2(Complex* x, const size_t m, const Complex* w) {
+    const Complex a0 = x[0];
+    const Complex a1 = mul(x[m], w[0]);
+    x[0] = a0 + a1;
+    x[m] = a0 - a1;
+}
+
+inline void butterfly3(Complex* x, const size_t m, const Complex* w) {
+    constexpr float s = 0.866025403784438647f;  // sin(2 * pi / 3)
+    const Complex a0 = x[0];
+    const Complex a1 = mul(x[m], w[0]);
+    const Complex a2 = mul(x[2 * m], w[1]);
+    const Complex b = a1 + a2;
+    const Complex d = mul_neg_i(s * (a1 - a2));
+    const Complex t = a0 - 0.5f * b;
+    x[0] = a0 + b;
+    x[m] = t + d;
+    x[2 * m] = t - d;
+}
+
+inline void butterfly4(Complex* x, const size_t m, const Complex* w) {
+    const Complex a0 = x[0];
+    const Complex a1 = mul(x[m], w[0]);
+    const Complex a2 = mul(x[2 * m], w[1]);
+    const Complex a3 = mul(x[3 * m], w[2]);
+    const Complex t0 = a0 + a2;
+    const Complex t1 = a0 - a2;
+    const Complex t2 = a1 + a3;
+    const Complex t3 = mul_neg_i(a1 - a3);
+    x[0] = t0 + t2;
+    x[m] = t1 + t3;
+    x[2 * m] = t0 - t2;
+    x[3 * m] = t1 - t3;
+}
+
+inline void butterfly5(Complex* x, const size_t m, const Complex* w) {
+    constexpr float c1 = 0.309016994374947424f;   // cos(2 * pi / 5)
+    constexpr float c2 = -0.809016994374947424f;  // cos(4 * pi / 5)
+    constexpr float s1 = 0.951056516295153572f;   // sin(2 * pi / 5)
+    constexpr float s2 = 0.587785252292473129f;   // sin(4 * pi / 5)
+    const Complex a0 = x[0];
+    const Complex a1 = mul(x[m], w[0]);
+    const Complex a2 = mul(x[2 * m], w[1]);
+    const Complex a3 = mul(x[3 * m], w[2]);
+    const Complex a4 = mul(x[4 * m], w[3]);
+    const Complex b1 = a1 + a4;
+    const Complex b2 = a2 + a3;
+    const Complex d1 = a1 - a4;
+    const Complex d2 = a2 - a3;
+    const Complex t1 = a0 + c1 * b1 + c2 * b2;
+    const Complex t2 = a0 + c2 * b1 + c1 * b2;
+    const Complex u1 = mul_neg_i(s1 * d1 + s2 * d2);
+    const Complex u2 = mul_neg_i(s2 * d1 - s1 * d2);
+    x[0] = a0 + b1 + b2;
+    x[m] = t1 + u1;
+    x[2 * m] = t2 + u2;
+    x[3 * m] = t2 - u2;
+    x[4 * m] = t1 - u1;
+}
+
+// Direct DFT of an arbitrary radix, `scratch` must hold `radix` values
+void butterfly_generic(Complex* x,
+                       const size_t m,
+                       const size_t radix,
+                       const Complex* w,
+                       const std::vector<Complex>& roots,
+                       Complex* scratch) {
+    scratch[0] = x[0];
+    for (size_t q = 1; q < radix; q++) {
+        scratch[q] = mul(x[q * m], w[q - 1]);
+    }
+    for (size_t s = 0; s < radix; s++) {
+        Complex sum = scratch[0];
+        for (size_t q = 1; q < radix; q++) {
+            sum += mul(scratch[q], roots[(q * s) % radix]);
+        }
+        x[s * m] = sum;
+    }
+}
+
+}  // namespace
+
+namespace ov {
+namespace genai {
+
+RealFFTPlan::RealFFTPlan(const size_t n_fft)
+    : m_n_fft(n_fft),
+      m_n_complex(n_fft % 2 == 0 ? n_fft / 2 : n_fft),
+      m_packed(n_fft % 2 == 0) {
+    OPENVINO_ASSERT(n_fft > 1, "FFT size should be greater than 1, got ", n_fft);
+
+    const std::vector<size_t> radices = factorize(m_n_complex);
+
+    m_permutation.resize(m_n_complex);
+    build_permutation(radices, 0, 0, 1, 0, m_n_complex, m_permutation);
+
+    // the deepest level of the decomposition is computed first
+    size_t span = 1;
+    for (auto radix = radices.rbegin(); radix != radices.rend(); ++radix) {
+        Stage stage;
+        stage.radix = *radix;
+        stage.span = span * stage.radix;
+        stage.twiddles.resize(span * (stage.radix - 1));
+        for (size_t k = 0; k < span; k++) {
+            for (size_t q = 1; q < stage.radix; q++) {
+                stage.twiddles[k * (stage.radix - 1) + q - 1] = unit_root(q * k, stage.span);
+            }
+        }
+        if (stage.radix > 5) {
+            stage.roots.resize(stage.radix);
+            for (size_t j = 0; j < stage.radix; j++) {
+                stage.roots[j] = unit_root(j, stage.radix);
+            }
+        }
+        span = stage.span;
+        m_stages.push_back(std::move(stage));
+    }
+
+    if (m_packed) {
+        m_split_twiddles.resize(get_n_bins());
+        for (size_t k = 0; k < m_split_twiddles.size(); k++) {
+            m_split_twiddles[k] = unit_root(k, m_n_fft);
+        }
+    }
+}
+
+void RealFFTPlan::complex_fft(Complex* data) const {
+    std::vector<Complex> scratch;
+    for (const auto& stage : m_stages) {
+        const size_t radix = stage.radix;
+        const size_t m = stage.span / radix;
+        if (!stage.roots.empty()) {
+            scratch.resize(radix);
+        }
+        for (size_t block = 0; block < m_n_complex; block += stage.span) {
+            Complex* x = data + block;
+            for (size_t k = 0; k < m; k++) {
+                const Complex* w = stage.twiddles.data() + k * (radix - 1);
+                switch (radix) {
+                case 2:
+                    butterfly2(x + k, m, w);
+                    break;
+                case 3:
+                    butterfly3(x + k, m, w);
+                    break;
+                case 4:
+                    butterfly4(x + k, m, w);
+                    break;
+                case 5:
+                    butterfly5(x + k, m, w);
+                    break;
+                default:
+                    butterfly_generic(x + k, m, radix, w, stage.roots, scratch.data());
+                }
+            }
+        }
+    }
+}
+
+void RealFFTPlan::power_spectrum(const float* input, float* output, std::vector<Complex>& work) const {
+    const size_t n_bins = get_n_bins();
+    work.resize(m_n_complex + n_bins);
+    Complex* data = work.data();
+    Complex* spectrum = work.data() + m_n_complex;
+
+    if (m_packed) {
+        // z[n] = x[2n] + i * x[2n + 1]
+        for (size_t i = 0; i < m_n_complex; i++) {
+            const size_t n = m_permutation[i];
+            data[i] = Complex(input[2 * n], input[2 * n + 1]);
+        }
+        complex_fft(data);
+
+        // X[k] = E[k] + exp(-2 * pi * i * k / N) * O[k], where E and O are spectra of even and odd samples:
+        // E[k] = (Z[k] + conj(Z[M - k])) / 2, O[k] = -i * (Z[k] - conj(Z[M - k])) / 2
+        for (size_t k = 0; k < n_bins; k++) {
+            const Complex z = data[k % m_n_complex];
+            const Complex z_conj = std::conj(data[(m_n_complex - k) % m_n_complex]);
+            const Complex even = 0.5f * (z + z_conj);
+            const Complex odd = mul_neg_i(0.5f * (z - z_conj));
+            spectrum[k] = even + mul(m_split_twiddles[k], odd);
+        }
+    } else {
+        for (size_t i = 0; i < m_n_complex; i++) {
+            data[i] = Complex(input[m_permutation[i]], 0.0f);
+        }
+        complex_fft(data);
+        std::copy(data, data + n_bins, spectrum);
+    }
+
+    // std::complex<float> is layout compatible with float[2], a flat loop is vectorized by the compiler
+    const float* values = reinterpret_cast<const float*>(spectrum);
+    for (size_t k = 0; k < n_bins; k++) {
+        output[k] = values[2 * k] * values[2 * k] + values[2 * k + 1] * values[2 * k + 1];
+    }
+}
+
+}  // namespace genai
+}  // namespace ov
@@ -0,0 +1,67 @@
+// Copyright (C) 2023-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <complex>
+#include <vector>
+
+namespace ov {
+namespace genai {
+
+/**
+ * @brief Precomputed plan of a forward FFT of a real-valued signal of a fixed size.
+ *
+ * A signal of even size N is packed into N/2 complex values and transformed by an iterative in-place
+ * mixed-radix (4, 2, 5, 3 and generic odd radices) Cooley-Tukey FFT, the spectrum of the real signal
+ * is recovered from the half-size result by a split step. Odd sizes use a full-size complex FFT.
+ * Permutation, twiddle factors and stage layout are computed once in the constructor.
+ */
+class RealFFTPlan {
+public:
+    explicit RealFFTPlan(const size_t n_fft);
+
+    size_t get_n_fft() const {
+        return m_n_fft;
+    }
+
+    // Number of non-redundant frequency bins: n_fft / 2 + 1
+    size_t get_n_bins() const {
+        return m_n_fft / 2 + 1;
+    }
+
+    /**
+     * @brief Compute power spectrum |X[k]|^2, k in [0, n_fft / 2], of a real-valued signal
+     *
+     * @param input signal of n_fft values
+     * @param output buffer for get_n_bins() values
+     * @param work scratch buffer, it is resized on the first call and can be reused between calls to avoid allocations
+     */
+    void power_spectrum(const float* input, float* output, std::vector<std::complex<float>>& work) const;
+
+private:
+    struct Stage {
+        size_t radix;
+        // size of the sub-transforms combined by this stage
+        size_t span;
+        // exp(-2 * pi * i * q * k / span) at [k * (radix - 1) + q - 1] for k in [0, span / radix), q in [1, radix)
+        std::vector<std::complex<float>> twiddles;
+        // exp(-2 * pi * i * j / radix), used by the generic butterfly only
+        std::vector<std::complex<float>> roots;
+    };
+
+    void complex_fft(std::complex<float>* data) const;
+
+    size_t m_n_fft;
+    // size of the complex FFT: n_fft / 2 for even n_fft, n_fft otherwise
+    size_t m_n_complex;
+    bool m_packed;
+    // input index for each position of the in-place transform
+    std::vector<size_t> m_permutation;
+    std::vector<Stage> m_stages;
+    // exp(-2 * pi * i * k / n_fft) for the split step, k in [0, n_fft / 2]
+    std::vector<std::complex<float>> m_split_twiddles;
+};
+
+}  // namespace genai
+}  // namespace ov
@@ -28,7 +28,7 @@ void process_whisper_timestamp_logits(ov::Tensor& logits,
                                       const std::vector<int64_t>& generated_tokens,
                                       bool initial_step = false) {
     const size_t batch_size = logits.get_shape().at(0);
-    OPENVINO_ASSERT(batch_size == 1, "Batch != 1 is not supported");
+    OPENVINO_ASSERT(batch_idx < batch_size, "logits batch size doesn't match the batch number");
 
     size_t vocab_size = logits.get_shape().back();
     size_t batch_offset = batch_idx * logits.get_shape()[1] * vocab_size;
@@ -95,7 +95,7 @@ void process_whisper_timestamp_logits(ov::Tensor& logits,
         }
     }
 
-    auto tokens = ov::genai::log_softmax(logits, 0);
+    auto tokens = ov::genai::log_softmax(logits, batch_idx);
     float timestamp_exp_prov_sum = 0;
 
     for (size_t i = timestamp_begin; i < vocab_size; i++) {
@@ -0,0 +1,143 @@
+// Copyright (C) 2023-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "streaming.hpp"
+
+#include <algorithm>
+
+namespace {
+
+size_t common_prefix_size(const std::vector<int64_t>& first, const std::vector<int64_t>& second) {
+    const size_t size = std::min(first.size(), second.size());
+    return std::mismatch(first.begin(), first.begin() + size, second.begin()).first - first.begin();
+}
+
+}  // namespace
+
+namespace ov {
+namespace genai {
+
+WhisperStreamingSession::WhisperStreamingSession(const WhisperGenerationConfig& config,
+                                                 const WhisperStreamingConfig& streaming_config,
+                                                 const WhisperConfig& model_config,
+                                                 WhisperInitializedModels& models,
+                                                 WhisperFeatureExtractor& feature_extractor)
+    : m_config{config},
+      m_streaming_config{streaming_config},
+      m_model_config{model_config},
+      m_models{models},
+      m_feature_extractor{feature_extractor} {
+    OPENVINO_ASSERT(m_streaming_config.min_chunk_seconds > 0.0f, "min_chunk_seconds should be positive");
+    OPENVINO_ASSERT(m_streaming_config.buffer_trimming_seconds + m_streaming_config.min_chunk_seconds <=
+                        m_feature_extractor.chunk_length,
+                    "buffer_trimming_seconds + min_chunk_seconds should not exceed ",
+                    m_feature_extractor.chunk_length,
+                    " seconds");
+    // segments are required to find positions where the buffer can be trimmed
+    m_config.return_timestamps = true;
+}
+
+std::vector<int64_t> WhisperStreamingSession::put_audio(const RawSpeechInput& audio_chunk) {
+    m_buffer.insert(m_buffer.end(), audio_chunk.begin(), audio_chunk.end());
+    m_new_samples += audio_chunk.size();
+
+    if (m_new_samples < m_streaming_config.min_chunk_seconds * m_feature_extractor.sampling_rate) {
+        return {};
+    }
+
+    return process(false);
+}
+
+std::vector<int64_t> WhisperStreamingSession::finish() {
+    std::vector<int64_t> committed_tokens;
+    if (m_new_samples > 0) {
+        committed_tokens = process(true);
+    } else {
+        committed_tokens = get_partial_tokens();
+    }
+
+    m_buffer.clear();
+    m_hypothesis.clear();
+    m_committed_in_buffer = 0;
+    return committed_tokens;
+}
+
+std::vector<int64_t> WhisperStreamingSession::get_partial_tokens() const {
+    return std::vector<int64_t>(m_hypothesis.begin() + m_committed_in_buffer, m_hypothesis.end());
+}
+
+std::vector<int64_t> WhisperStreamingSession::process(const bool flush) {
+    auto result = whisper_generate(m_config, m_model_config, m_buffer, m_models, m_feature_extractor, nullptr);
+    m_new_samples = 0;
+
+    const size_t agreed_size = flush ? result.output_tokens.size()
+                                     : common_prefix_size(result.output_tokens, m_hypothesis);
+    m_hypothesis = std::move(result.output_tokens);
+
+    // committed tokens are never retracted even if the new hypothesis doesn't agree with them anymore
+    m_committed_in_buffer = std::min(m_committed_in_buffer, m_hypothesis.size());
+    std::vector<int64_t> committed_tokens;
+    if (agreed_size > m_committed_in_buffer) {
+        committed_tokens.assign(m_hypothesis.begin() + m_committed_in_buffer, m_hypothesis.begin() + agreed_size);
+        m_committed_in_buffer = agreed_size;
+    }
+
+    // the language is fixed for the session once the first tokens are committed, so the following transcriptions of
+    // the buffer skip language detection
+    if (!m_config.language.has_value() && result.detected_language.has_value() && !committed_tokens.empty()) {
+        m_config.language = result.detected_language;
+    }
+
+    if (!flush && result.segments.has_value()) {
+        trim_buffer(*result.segments, committed_tokens);
+    }
+
+    return committed_tokens;
+}
+
+void WhisperStreamingSession::trim_buffer(const std::vector<Segment>& segments, std::vector<int64_t>& committed_tokens) {
+    const float buffer_seconds = static_cast<float>(m_buffer.size()) / m_feature_extractor.sampling_rate;
+    if (buffer_seconds <= m_streaming_config.buffer_trimming_seconds) {
+        return;
+    }
+
+    // the next chunk would not fit the encoder window, finished segments are committed without agreement
+    const bool force = buffer_seconds + m_streaming_config.min_chunk_seconds > m_feature_extractor.chunk_length;
+
+    size_t segments_tokens = 0;
+    size_t trim_tokens = 0;
+    float trim_seconds = 0.0f;
+    for (const auto& segment : segments) {
+        // segment without ending timestamp
+        if (segment.m_end < 0.0f) {
+            break;
+        }
+        segments_tokens += segment.m_tokens.size();
+        if (segments_tokens > m_committed_in_buffer && !force) {
+            break;
+        }
+        trim_tokens = segments_tokens;
+        trim_seconds = segment.m_end;
+    }
+
+    if (trim_seconds <= 0.0f) {
+        return;
+    }
+
+    trim_tokens = std::min(trim_tokens, m_hypothesis.size());
+    if (trim_tokens > m_committed_in_buffer) {
+        committed_tokens.insert(committed_tokens.end(),
+                                m_hypothesis.begin() + m_committed_in_buffer,
+                                m_hypothesis.begin() + trim_tokens);
+        m_committed_in_buffer = trim_tokens;
+    }
+
+    const size_t trim_samples =
+        std::min(m_buffer.size(), static_cast<size_t>(trim_seconds * m_feature_extractor.sampling_rate));
+    m_buffer.erase(m_buffer.begin(), m_buffer.begin() + trim_samples);
+    m_hypothesis.erase(m_hypothesis.begin(), m_hypothesis.begin() + trim_tokens);
+    m_committed_in_buffer -= trim_tokens;
+}
+
+}  // namespace genai
+}  // namespace ov
@@ -0,0 +1,63 @@
+// Copyright (C) 2023-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <openvino/openvino.hpp>
+
+#include "openvino/genai/whisper_generation_config.hpp"
+#include "openvino/genai/whisper_pipeline.hpp"
+#include "whisper.hpp"
+#include "whisper_config.hpp"
+#include "whisper_feature_extractor.hpp"
+#include "whisper_models.hpp"
+
+namespace ov {
+namespace genai {
+
+/**
+ * Incremental transcription of audio that arrives in chunks.
+ *
+ * Audio is accumulated in a buffer that is transcribed again when at least min_chunk_seconds of new audio is received.
+ * Tokens are committed with local agreement: a prefix of the hypothesis is committed once two consecutive
+ * transcriptions of the buffer agree on it. When the buffer grows longer than buffer_trimming_seconds it is trimmed
+ * at the end of the last committed segment, so each transcription processes a bounded window.
+ */
+class WhisperStreamingSession {
+public:
+    WhisperStreamingSession(const WhisperGenerationConfig& config,
+                            const WhisperStreamingConfig& streaming_config,
+                            const WhisperConfig& model_config,
+                            WhisperInitializedModels& models,
+                            WhisperFeatureExtractor& feature_extractor);
+
+    // Returns newly committed tokens
+    std::vector<int64_t> put_audio(const RawSpeechInput& audio_chunk);
+
+    // Transcribes the rest of the buffer and returns all not yet committed tokens
+    std::vector<int64_t> finish();
+
+    // Tokens of the current hypothesis that are not committed yet
+    std::vector<int64_t> get_partial_tokens() const;
+
+private:
+    std::vector<int64_t> process(const bool flush);
+    void trim_buffer(const std::vector<Segment>& segments, std::vector<int64_t>& committed_tokens);
+
+    WhisperGenerationConfig m_config;
+    WhisperStreamingConfig m_streaming_config;
+    const WhisperConfig& m_model_config;
+    WhisperInitializedModels& m_models;
+    WhisperFeatureExtractor& m_feature_extractor;
+
+    std::vector<float> m_buffer;
+    // samples received since the last transcription of the buffer
+    size_t m_new_samples = 0;
+    // non-timestamp tokens of the last transcription of the buffer
+    std::vector<int64_t> m_hypothesis;
+    // number of m_hypothesis tokens that are already committed
+    size_t m_committed_in_buffer = 0;
+};
+
+}  // namespace genai
+}  // namespace ov
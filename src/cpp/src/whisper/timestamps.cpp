@@ -9,7 +9,8 @@ namespace genai {
 ov::genai::ExtractedSegments extract_segments(const std::vector<int64_t>& tokens,
                                               const ov::genai::WhisperGenerationConfig& config,
                                               const size_t nb_max_frames,
-                                              const float time_precision) {
+                                              const float time_precision,
+                                              const float time_offset) {
     ov::genai::ExtractedSegments extracted_segments;
     std::optional<int64_t> token_start = std::nullopt;
     size_t idx_start = 0;
@@ -38,8 +39,8 @@ ov::genai::ExtractedSegments extract_segments(const std::vector<int64_t>& tokens
 
             ov::genai::Segment segment;
             segment.m_tokens = {tokens.begin() + idx_start + 1, tokens.begin() + i};
-            segment.m_start = (*token_start - config.begin_timestamps_token_id) * time_precision;
-            segment.m_end = (token - config.begin_timestamps_token_id) * time_precision;
+            segment.m_start = (*token_start - config.begin_timestamps_token_id) * time_precision + time_offset;
+            segment.m_end = (token - config.begin_timestamps_token_id) * time_precision + time_offset;
             extracted_segments.segments.push_back(segment);
 
             // each next timestamp token represents .02 time diff
@@ -61,7 +62,7 @@ ov::genai::ExtractedSegments extract_segments(const std::vector<int64_t>& tokens
     if (token_start.has_value() && has_tokens_to_add && !has_previous_segments) {
         ov::genai::Segment segment;
         segment.m_tokens = {tokens.begin() + idx_start + 1, tokens.end()};
-        segment.m_start = (*token_start - config.begin_timestamps_token_id) * time_precision;
+        segment.m_start = (*token_start - config.begin_timestamps_token_id) * time_precision + time_offset;
         segment.m_end = -1.0f;
         extracted_segments.segments.push_back(segment);
 
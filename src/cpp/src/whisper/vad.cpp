@@ -0,0 +1,123 @@
+// Copyright (C) 2023-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "vad.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// frames added around each speech region to keep word boundaries, 0.2s with default hop_length
+constexpr size_t SPEECH_PAD_FRAMES = 20;
+// speech regions separated by shorter pauses are merged, 1s with default hop_length
+constexpr size_t MIN_SILENCE_FRAMES = 100;
+
+// Normalized features are (log10(power) + 4) / 4, so a unit of features is 40 dB
+constexpr float DB_PER_FEATURE_UNIT = 40.0f;
+// Frames with mean log-mel power below -80 dB are silence regardless of the loudest frame,
+// digital silence is clamped to log10(1e-10) by the feature extractor which is -1.5 after normalization
+constexpr float SILENCE_FLOOR_FEATURE = -1.0f;
+
+size_t map_frame(const size_t selected_frame, const std::vector<ov::genai::SpeechRegion>& regions, const bool is_end) {
+    for (const auto& region : regions) {
+        const size_t selected_end = region.selected_begin + (region.end - region.begin);
+        // end of a segment at the region boundary belongs to the region, start belongs to the next one
+        if (selected_frame < selected_end || (is_end && selected_frame == selected_end)) {
+            return region.begin + (selected_frame - region.selected_begin);
+        }
+    }
+    const auto& last = regions.back();
+    return last.end + (selected_frame - (last.selected_begin + (last.end - last.begin)));
+}
+
+}  // namespace
+
+namespace ov {
+namespace genai {
+
+std::vector<SpeechRegion> detect_speech_regions(const WhisperFeatures& features, const float threshold_db) {
+    std::vector<float> energy(features.n_frames, 0.0f);
+    for (size_t i = 0; i < features.feature_size; i++) {
+        const float* row = features.data.data() + i * features.n_frames;
+        for (size_t frame = 0; frame < features.n_frames; frame++) {
+            energy[frame] += row[frame];
+        }
+    }
+
+    std::vector<SpeechRegion> regions;
+    if (energy.empty()) {
+        return regions;
+    }
+
+    const float max_energy = *std::max_element(energy.begin(), energy.end()) / features.feature_size;
+    // the threshold relative to the loudest frame would mark every frame of a silent input as speech
+    if (max_energy < SILENCE_FLOOR_FEATURE) {
+        return regions;
+    }
+    const float threshold = std::max(max_energy - threshold_db / DB_PER_FEATURE_UNIT, SILENCE_FLOOR_FEATURE);
+
+    for (size_t frame = 0; frame < features.n_frames; frame++) {
+        if (energy[frame] / features.feature_size < threshold) {
+            continue;
+        }
+
+        const size_t begin = frame > SPEECH_PAD_FRAMES ? frame - SPEECH_PAD_FRAMES : 0;
+        const size_t end = std::min(frame + 1 + SPEECH_PAD_FRAMES, features.n_frames);
+        if (!regions.empty() && begin <= regions.back().end + MIN_SILENCE_FRAMES) {
+            regions.back().end = std::max(regions.back().end, end);
+        } else {
+            regions.push_back({begin, end, 0});
+        }
+    }
+
+    size_t selected_begin = 0;
+    for (auto& region : regions) {
+        region.selected_begin = selected_begin;
+        selected_begin += region.end - region.begin;
+    }
+
+    return regions;
+}
+
+WhisperFeatures select_frames(const WhisperFeatures& features, const std::vector<SpeechRegion>& regions) {
+    WhisperFeatures selected;
+    selected.feature_size = features.feature_size;
+    selected.n_frames = 0;
+    for (const auto& region : regions) {
+        selected.n_frames += region.end - region.begin;
+    }
+
+    selected.data.resize(selected.feature_size * selected.n_frames);
+    for (size_t i = 0; i < features.feature_size; i++) {
+        const float* src = features.data.data() + i * features.n_frames;
+        float* dst = selected.data.data() + i * selected.n_frames;
+        for (const auto& region : regions) {
+            std::copy(src + region.begin, src + region.end, dst + region.selected_begin);
+        }
+    }
+
+    return selected;
+}
+
+void remap_segments(std::vector<Segment>& segments,
+                    const std::vector<SpeechRegion>& regions,
+                    const float frame_duration) {
+    if (regions.empty()) {
+        return;
+    }
+
+    for (auto& segment : segments) {
+        const size_t start_frame = static_cast<size_t>(std::round(segment.m_start / frame_duration));
+        segment.m_start = map_frame(start_frame, regions, false) * frame_duration;
+
+        // segment without ending timestamp
+        if (segment.m_end >= 0.0f) {
+            const size_t end_frame = static_cast<size_t>(std::round(segment.m_end / frame_duration));
+            segment.m_end = map_frame(end_frame, regions, true) * frame_duration;
+        }
+    }
+}
+
+}  // namespace genai
+}  // namespace ov
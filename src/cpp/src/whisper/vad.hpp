@@ -0,0 +1,38 @@
+// Copyright (C) 2023-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <vector>
+
+#include "whisper.hpp"
+#include "whisper_feature_extractor.hpp"
+
+namespace ov {
+namespace genai {
+
+// Range of frames [begin, end) of original features and its start position in features with selected frames only
+struct SpeechRegion {
+    size_t begin;
+    size_t end;
+    size_t selected_begin;
+};
+
+/**
+ * Energy based voice activity detection on log-mel features.
+ * A frame is considered as speech if its mean log-mel energy is not lower than energy of the loudest frame by more
+ * than threshold_db and its energy is above the absolute silence floor. Speech regions are padded and regions
+ * separated by short pauses are merged. Returns no regions for a fully silent input.
+ */
+std::vector<SpeechRegion> detect_speech_regions(const WhisperFeatures& features, const float threshold_db);
+
+// Concatenates frames of speech regions
+WhisperFeatures select_frames(const WhisperFeatures& features, const std::vector<SpeechRegion>& regions);
+
+// Maps segments timestamps in features with selected frames only to timestamps in the original features
+void remap_segments(std::vector<Segment>& segments,
+                    const std::vector<SpeechRegion>& regions,
+                    const float frame_duration);
+
+}  // namespace genai
+}  // namespace ov
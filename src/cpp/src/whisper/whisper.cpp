@@ -3,9 +3,16 @@
 
 #include "whisper.hpp"
 
+#include <cstring>
 #include <iostream>
+#include <numeric>
 #include <openvino/openvino.hpp>
-#include <regex>
+#include <openvino/op/assign.hpp>
+#include <openvino/op/constant.hpp>
+#include <openvino/op/read_value.hpp>
+#include <openvino/op/result.hpp>
+#include <openvino/op/slice.hpp>
+#include <openvino/op/util/variable.hpp>
 #include <thread>
 
 #include "utils.hpp"
@@ -15,6 +22,7 @@
 #include "openvino/genai/whisper_generation_config.hpp"
 #include "openvino/genai/whisper_pipeline.hpp"
 #include "timestamps.hpp"
+#include "vad.hpp"
 #include "whisper_config.hpp"
 #include "whisper_feature_extractor.hpp"
 #include "whisper_models.hpp"
@@ -27,9 +35,12 @@ ov::Tensor encode(ov::InferRequest& request,
                   std::vector<float>& mel_data,
                   const size_t feature_size,
                   const size_t nb_max_frames,
-                  ov::genai::RawPerfMetrics& raw_metrics) {
-    OPENVINO_ASSERT(mel_data.size() == feature_size * nb_max_frames,
+                  ov::genai::RawPerfMetrics& raw_metrics,
+                  const size_t batch_size = 1) {
+    OPENVINO_ASSERT(mel_data.size() == batch_size * feature_size * nb_max_frames,
                     "Mel spectrogram required size: ",
+                    batch_size,
+                    " * ",
                     feature_size,
                     " * ",
                     nb_max_frames,
@@ -37,7 +48,7 @@ ov::Tensor encode(ov::InferRequest& request,
                     mel_data.size(),
                     ".");
 
-    ov::Tensor input_tensor(ov::element::f32, {1, feature_size, nb_max_frames}, mel_data.data());
+    ov::Tensor input_tensor(ov::element::f32, {batch_size, feature_size, nb_max_frames}, mel_data.data());
 
     request.set_tensor("input_features", input_tensor);
 
@@ -52,34 +63,91 @@ ov::Tensor encode(ov::InferRequest& request,
     return request.get_tensor("last_hidden_state");
 }
 
-void set_past_key_value(ov::InferRequest& source, ov::InferRequest& dest) {
-    // source outputs:
+void start_encode_async(ov::InferRequest& request,
+                        std::vector<float>& mel_data,
+                        const size_t feature_size,
+                        const size_t nb_max_frames) {
+    request.set_tensor("input_features", ov::Tensor(ov::element::f32, {1, feature_size, nb_max_frames}, mel_data.data()));
+    request.start_async();
+}
+
+// past_key_values.0.decoder.key -> present.0.decoder.key
+std::string get_present_name(const std::string& past_key_value_name) {
+    static const std::string past_prefix = "past_key_values";
+    OPENVINO_ASSERT(past_key_value_name.compare(0, past_prefix.size(), past_prefix) == 0,
+                    "Unexpected past key value name: ",
+                    past_key_value_name);
+    return "present" + past_key_value_name.substr(past_prefix.size());
+}
+
+// Moves cache computed by decoder for init_ids to decoder_with_past once per chunk:
+// self-attention cache initializes variables of the stateful decoder_with_past,
+// cross-attention cache and encoder hidden states are set as inputs and stay unchanged during the chunk decoding.
+void set_past_key_value(ov::InferRequest& decoder,
+                        ov::InferRequest& decoder_with_past,
+                        const ov::Tensor& encoder_hidden_state) {
+    // decoder outputs:
     // present.0.decoder.key
     // present.0.decoder.value
     // present.0.encoder.key
     // present.0.encoder.value
 
-    // dest inputs:
+    // decoder_with_past variables:
     // past_key_values.0.decoder.key
     // past_key_values.0.decoder.value
+
+    // decoder_with_past inputs:
     // past_key_values.0.encoder.key
     // past_key_values.0.encoder.value
 
-    for (auto& source_output : source.get_compiled_model().outputs()) {
-        std::string source_output_name = source_output.get_any_name();
-        if (source_output_name.find("logits") != std::string::npos) {
+    for (auto& state : decoder_with_past.query_state()) {
+        state.set_state(decoder.get_tensor(get_present_name(state.get_name())));
+    }
+
+    for (auto& input : decoder_with_past.get_compiled_model().inputs()) {
+        const std::string& input_name = input.get_any_name();
+        if (input_name.find("past_key_values") == std::string::npos) {
             continue;
         }
+        decoder_with_past.set_tensor(input_name, ov::Tensor{decoder.get_tensor(get_present_name(input_name))});
+    }
+
+    decoder_with_past.set_tensor("encoder_hidden_states", ov::Tensor{encoder_hidden_state});
+}
 
-        std::string with_past_input_name =
-            std::regex_replace(source_output_name, std::regex("present"), "past_key_values");
+// Copies rows with `batch_indices` along the first dimension of `tensor` to a new tensor
+ov::Tensor select_batch(const ov::Tensor& tensor, const std::vector<size_t>& batch_indices) {
+    ov::Shape shape = tensor.get_shape();
+    const size_t row_byte_size = tensor.get_byte_size() / shape[0];
+    shape[0] = batch_indices.size();
+
+    ov::Tensor selected(tensor.get_element_type(), shape);
+    const uint8_t* src = static_cast<const uint8_t*>(tensor.data());
+    uint8_t* dst = static_cast<uint8_t*>(selected.data());
+    for (size_t i = 0; i < batch_indices.size(); i++) {
+        std::memcpy(dst + i * row_byte_size, src + batch_indices[i] * row_byte_size, row_byte_size);
+    }
+    return selected;
+}
 
-        auto kv_tensor = source.get_tensor(source_output_name);
-        dest.set_tensor(with_past_input_name, ov::Tensor{kv_tensor});
+// Keeps only `batch_indices` rows in all past key values variables and inputs and encoder hidden states input of
+// decoder_with_past
+void select_past_key_value_batch(ov::InferRequest& decoder_with_past, const std::vector<size_t>& batch_indices) {
+    for (auto& state : decoder_with_past.query_state()) {
+        state.set_state(select_batch(state.get_state(), batch_indices));
+    }
+    for (auto& input : decoder_with_past.get_compiled_model().inputs()) {
+        const std::string& input_name = input.get_any_name();
+        if (input_name.find("past_key_values") == std::string::npos && input_name != "encoder_hidden_states") {
+            continue;
+        }
+        decoder_with_past.set_tensor(input_name, select_batch(decoder_with_past.get_tensor(input_name), batch_indices));
     }
 }
 
-void infer_with_perf_metrics(ov::InferRequest& request, ov::genai::RawPerfMetrics& raw_metrics) {
+void infer_with_perf_metrics(ov::InferRequest& request,
+                             ov::genai::RawPerfMetrics& raw_metrics,
+                             const size_t batch_size = 1) {
     const auto infer_start = std::chrono::steady_clock::now();
     request.infer();
     const auto infer_end = std::chrono::steady_clock::now();
@@ -87,7 +155,7 @@ void infer_with_perf_metrics(ov::InferRequest& request, ov::genai::RawPerfMetric
     raw_metrics.m_inference_durations[0] += MicroSeconds(infer_ms);
     raw_metrics.m_token_infer_durations.emplace_back(infer_ms);
     raw_metrics.m_new_token_times.emplace_back(infer_end);
-    raw_metrics.m_batch_sizes.emplace_back(1);
+    raw_metrics.m_batch_sizes.emplace_back(batch_size);
 }
 
 int64_t decode(ov::Tensor& encoder_hidden_state,
@@ -120,16 +188,13 @@ int64_t decode(ov::Tensor& encoder_hidden_state,
     return output_token;
 }
 
-int64_t decode_with_past(ov::Tensor& encoder_hidden_state,
-                         ov::InferRequest& decoder_with_past,
+int64_t decode_with_past(ov::InferRequest& decoder_with_past,
                          int64_t input_id,
                          const size_t cache_position,
                          const ov::genai::WhisperGenerationConfig& config,
                          ov::genai::RawPerfMetrics& raw_metrics,
                          const bool return_timestamps,
                          const std::vector<int64_t>& generated_tokens) {
-    decoder_with_past.set_tensor("encoder_hidden_states", ov::Tensor{encoder_hidden_state});
-
     std::vector<int64_t> input_ids = {input_id};
     ov::Tensor input_ids_tensor(ov::element::i64, {1, 1}, input_ids.data());
     decoder_with_past.set_tensor("input_ids", input_ids_tensor);
@@ -153,58 +218,243 @@ int64_t decode_with_past(ov::Tensor& encoder_hidden_state,
     return output_token;
 }
 
-int64_t detect_language(ov::Tensor& encoder_hidden_state,
-                        ov::InferRequest decoder,
-                        const ov::genai::WhisperGenerationConfig& config) {
-    std::vector<int64_t> input_ids{config.decoder_start_token_id};
+// Returns detected language token for each batch of encoder_hidden_state
+std::vector<int64_t> detect_language(ov::Tensor& encoder_hidden_state,
+                                     ov::InferRequest decoder,
+                                     const ov::genai::WhisperGenerationConfig& config) {
+    const size_t batch_size = encoder_hidden_state.get_shape().at(0);
+    std::vector<int64_t> input_ids(batch_size, config.decoder_start_token_id);
 
     decoder.set_tensor("encoder_hidden_states", ov::Tensor{encoder_hidden_state});
 
-    ov::Tensor input_ids_tensor(ov::element::i64, {1, input_ids.size()}, input_ids.data());
+    ov::Tensor input_ids_tensor(ov::element::i64, {batch_size, 1}, input_ids.data());
     decoder.set_tensor("input_ids", input_ids_tensor);
 
     decoder.infer();
 
     auto output_tensor = decoder.get_tensor("logits");
 
-    int64_t output_token = ov::genai::utils::argmax(output_tensor, 0);
+    std::vector<int64_t> output_tokens(batch_size);
+    for (size_t batch = 0; batch < batch_size; batch++) {
+        output_tokens[batch] = ov::genai::utils::argmax(output_tensor, batch);
+    }
 
-    return output_token;
+    return output_tokens;
 }
 
-std::vector<int64_t> prepare_init_ids(ov::Tensor& encoder_hidden_state,
-                                      ov::InferRequest decoder,
-                                      const ov::genai::WhisperGenerationConfig& config,
-                                      const bool return_timestamps) {
+std::vector<int64_t> build_init_ids(const ov::genai::WhisperGenerationConfig& config,
+                                    const int64_t language_token_id,
+                                    const bool return_timestamps) {
+    int64_t task_token_id = config.transcribe_token_id;
+    if (config.task.has_value() && *config.task == "translate") {
+        task_token_id = config.translate_token_id;
+    }
+
+    if (return_timestamps) {
+        return std::vector<int64_t>{config.decoder_start_token_id, language_token_id, task_token_id};
+    }
+
+    return std::vector<int64_t>{config.decoder_start_token_id,
+                                language_token_id,
+                                task_token_id,
+                                config.no_timestamps_token_id};
+}
+
+bool requires_language_detection(const ov::genai::WhisperGenerationConfig& config) {
+    return config.is_multilingual && !config.language.has_value();
+}
+
+// Returns language token name, e.g. <|en|>, of init_ids built with detected language
+std::optional<std::string> get_detected_language(const ov::genai::WhisperGenerationConfig& config,
+                                                 const std::vector<int64_t>& init_ids) {
+    if (!requires_language_detection(config)) {
+        return std::nullopt;
+    }
+    // init_ids: decoder_start_token_id, language_token_id, task_token_id, ...
+    for (const auto& [language, language_token_id] : config.lang_to_id) {
+        if (language_token_id == init_ids.at(1)) {
+            return language;
+        }
+    }
+    return std::nullopt;
+}
+
+// Returns init_ids for each batch of encoder_hidden_state, language is detected per batch if not set in config
+std::vector<std::vector<int64_t>> prepare_init_ids(ov::Tensor& encoder_hidden_state,
+                                                   ov::InferRequest decoder,
+                                                   const ov::genai::WhisperGenerationConfig& config,
+                                                   const bool return_timestamps) {
+    const size_t batch_size = encoder_hidden_state.get_shape().at(0);
+
     if (!config.is_multilingual) {
-        return std::vector<int64_t>{config.decoder_start_token_id, config.no_timestamps_token_id};
+        return std::vector<std::vector<int64_t>>(
+            batch_size,
+            std::vector<int64_t>{config.decoder_start_token_id, config.no_timestamps_token_id});
     }
 
-    int64_t language_token_id;
     if (config.language.has_value()) {
+        int64_t language_token_id;
         std::string language = *config.language;
         if (config.lang_to_id.count(language)) {
             language_token_id = config.lang_to_id.at(language);
         }
-    } else {
-        language_token_id = detect_language(encoder_hidden_state, decoder, config);
+        return std::vector<std::vector<int64_t>>(batch_size,
+                                                 build_init_ids(config, language_token_id, return_timestamps));
     }
 
-    int64_t task_token_id = config.transcribe_token_id;
-    if (config.task.has_value() && *config.task == "translate") {
-        task_token_id = config.translate_token_id;
+    std::vector<std::vector<int64_t>> init_ids;
+    for (const int64_t language_token_id : detect_language(encoder_hidden_state, decoder, config)) {
+        init_ids.push_back(build_init_ids(config, language_token_id, return_timestamps));
     }
+    return init_ids;
+}
+
+// Sets input_ids of decoder_with_past and cache_position to [start_position, start_position + input_ids.size())
+void set_decoder_with_past_inputs(ov::InferRequest& decoder_with_past,
+                                  std::vector<int64_t>& input_ids,
+                                  const size_t start_position) {
+    decoder_with_past.set_tensor("input_ids", ov::Tensor(ov::element::i64, {1, input_ids.size()}, input_ids.data()));
+
+    ov::Tensor cache_position_tensor = decoder_with_past.get_tensor("cache_position");
+    cache_position_tensor.set_shape({input_ids.size()});
+    std::iota(cache_position_tensor.data<int64_t>(),
+              cache_position_tensor.data<int64_t>() + input_ids.size(),
+              static_cast<int64_t>(start_position));
+}
 
+// Applies logit processors to logits of `position` in the sequence and returns the greedy token
+int64_t process_logits_at(ov::Tensor& logits,
+                          const size_t position,
+                          const ov::genai::WhisperGenerationConfig& config,
+                          const bool return_timestamps,
+                          const std::vector<int64_t>& generated_tokens) {
+    const size_t vocab_size = logits.get_shape().back();
+    ov::Tensor position_logits(ov::element::f32, {1, 1, vocab_size}, logits.data<float>() + position * vocab_size);
+
+    ov::genai::do_suppress_tokens(position_logits, 0, config.suppress_tokens);
     if (return_timestamps) {
-        return std::vector<int64_t>{config.decoder_start_token_id, language_token_id, task_token_id};
+        ov::genai::process_whisper_timestamp_logits(position_logits, 0, config, generated_tokens);
     }
 
-    return std::vector<int64_t>{config.decoder_start_token_id,
-                                language_token_id,
-                                task_token_id,
-                                config.no_timestamps_token_id};
+    return ov::genai::utils::argmax(position_logits, 0);
+}
+
+// Continues decoding after the first token with draft decoder proposing up to num_assistant_tokens tokens
+// that are verified by one decoder_with_past inference. Each position of the verification is processed with the same
+// logit processors and generated tokens as in sequential decoding, so the result is the same as greedy decoding.
+bool speculative_decode(ov::Tensor& encoder_hidden_state,
+                        const ov::genai::WhisperGenerationConfig& config,
+                        ov::genai::WhisperInitializedModels& models,
+                        std::vector<int64_t>& init_ids,
+                        std::vector<int64_t>& output_tokens,
+                        const size_t max_new_tokens,
+                        const bool return_timestamps,
+                        ov::genai::RawPerfMetrics& raw_metrics,
+                        const std::shared_ptr<ov::genai::StreamerBase> streamer) {
+    // draft decoder has to process init_ids to fill its cache
+    models.draft_decoder.set_tensor("encoder_hidden_states", ov::Tensor{encoder_hidden_state});
+    models.draft_decoder.set_tensor("input_ids", ov::Tensor(ov::element::i64, {1, init_ids.size()}, init_ids.data()));
+    infer_with_perf_metrics(models.draft_decoder, raw_metrics);
+    set_past_key_value(models.draft_decoder, models.draft_decoder_with_past, encoder_hidden_state);
+
+    // number of sequence tokens in cache of decoder_with_past and draft_decoder_with_past,
+    // the sequence is init_ids followed by output_tokens
+    size_t cache_size = init_ids.size();
+    size_t draft_cache_size = init_ids.size();
+
+    while (output_tokens.size() < max_new_tokens) {
+        // draft proposes tokens
+        std::vector<int64_t> candidate_tokens = output_tokens;
+        const size_t num_draft_tokens = std::min(config.num_assistant_tokens, max_new_tokens - output_tokens.size());
+        for (size_t i = 0; i < num_draft_tokens; i++) {
+            std::vector<int64_t> input_ids(candidate_tokens.begin() + (draft_cache_size - init_ids.size()),
+                                           candidate_tokens.end());
+            set_decoder_with_past_inputs(models.draft_decoder_with_past, input_ids, draft_cache_size);
+            infer_with_perf_metrics(models.draft_decoder_with_past, raw_metrics);
+            draft_cache_size += input_ids.size();
+
+            auto logits = models.draft_decoder_with_past.get_tensor("logits");
+            const int64_t draft_token =
+                process_logits_at(logits, input_ids.size() - 1, config, return_timestamps, candidate_tokens);
+            candidate_tokens.push_back(draft_token);
+            if (draft_token == config.eos_token_id) {
+                break;
+            }
+        }
+        const size_t num_candidates = candidate_tokens.size() - output_tokens.size();
+
+        // main decoder verifies the last output token followed by draft tokens in one inference
+        std::vector<int64_t> input_ids(candidate_tokens.begin() + (cache_size - init_ids.size()), candidate_tokens.end());
+        set_decoder_with_past_inputs(models.decoder_with_past, input_ids, cache_size);
+        infer_with_perf_metrics(models.decoder_with_past, raw_metrics);
+
+        auto logits = models.decoder_with_past.get_tensor("logits");
+        // logits of position `first_position + i` predict a token that is verified against i-th draft token
+        const size_t first_position = input_ids.size() - 1 - num_candidates;
+        bool finished = false;
+        for (size_t i = 0; i <= num_candidates; i++) {
+            const int64_t output_token =
+                process_logits_at(logits, first_position + i, config, return_timestamps, output_tokens);
+            if (output_token == config.eos_token_id) {
+                finished = true;
+                break;
+            }
+
+            output_tokens.push_back(output_token);
+            bool is_timestamp = output_token >= config.begin_timestamps_token_id;
+            if (!is_timestamp && streamer && streamer->put(output_token)) {
+                return true;
+            }
+
+            if (output_tokens.size() >= max_new_tokens) {
+                finished = true;
+                break;
+            }
+
+            // mismatch with the draft, the main decoder token is used instead and the rest of candidates is dropped
+            if (i == num_candidates || output_token != candidate_tokens[output_tokens.size() - 1]) {
+                break;
+            }
+        }
+
+        if (finished) {
+            break;
+        }
+
+        // cache holds entries for all tokens except the last output token, entries for rejected candidates are
+        // dropped by the next inference of each decoder because it starts from an earlier cache_position
+        cache_size = init_ids.size() + output_tokens.size() - 1;
+        draft_cache_size = std::min(draft_cache_size, cache_size);
+    }
+
+    return false;
 }
 
+// Processes init_ids after decoder_start_token_id with decoder_with_past, its cache is initialized from the decoder
+// inferred on decoder_start_token_id by detect_language for the same encoder_hidden_state
+int64_t decode_init_ids_with_past(ov::Tensor& encoder_hidden_state,
+                                  ov::genai::WhisperInitializedModels& models,
+                                  const std::vector<int64_t>& init_ids,
+                                  const ov::genai::WhisperGenerationConfig& config,
+                                  ov::genai::RawPerfMetrics& raw_metrics,
+                                  const bool return_timestamps) {
+    set_past_key_value(models.decoder, models.decoder_with_past, encoder_hidden_state);
+
+    std::vector<int64_t> input_ids(init_ids.begin() + 1, init_ids.end());
+    set_decoder_with_past_inputs(models.decoder_with_past, input_ids, 1);
+    infer_with_perf_metrics(models.decoder_with_past, raw_metrics);
+
+    auto output_tensor = models.decoder_with_past.get_tensor("logits");
+    ov::genai::do_suppress_tokens(output_tensor, 0, config.begin_suppress_tokens);
+    ov::genai::do_suppress_tokens(output_tensor, 0, config.suppress_tokens);
+    if (return_timestamps) {
+        ov::genai::process_whisper_timestamp_logits(output_tensor, 0, config, {}, true);
+    }
+
+    return ov::genai::utils::argmax(output_tensor, 0);
+}
+
+// `start_token_decoded` means that the decoder was just inferred on decoder_start_token_id by language detection
 std::pair<bool, std::vector<int64_t>> full_decode(ov::Tensor& encoder_hidden_state,
                                                   const ov::genai::WhisperGenerationConfig& config,
                                                   ov::genai::WhisperInitializedModels& models,
@@ -212,9 +462,12 @@ std::pair<bool, std::vector<int64_t>> full_decode(ov::Tensor& encoder_hidden_sta
                                                   const size_t max_new_tokens,
                                                   const bool return_timestamps,
                                                   ov::genai::RawPerfMetrics& raw_metrics,
-                                                  const std::shared_ptr<ov::genai::StreamerBase> streamer) {
+                                                  const std::shared_ptr<ov::genai::StreamerBase> streamer,
+                                                  const bool start_token_decoded = false) {
     int64_t output_token =
-        decode(encoder_hidden_state, models.decoder, init_ids, config, raw_metrics, true, return_timestamps);
+        start_token_decoded
+            ? decode_init_ids_with_past(encoder_hidden_state, models, init_ids, config, raw_metrics, return_timestamps)
+            : decode(encoder_hidden_state, models.decoder, init_ids, config, raw_metrics, true, return_timestamps);
 
     std::vector<int64_t> output_tokens{output_token};
 
@@ -227,11 +480,25 @@ std::pair<bool, std::vector<int64_t>> full_decode(ov::Tensor& encoder_hidden_sta
         return {false, output_tokens};
     }
 
-    set_past_key_value(models.decoder, models.decoder_with_past);
+    if (!start_token_decoded) {
+        set_past_key_value(models.decoder, models.decoder_with_past, encoder_hidden_state);
+    }
+
+    if (models.draft_decoder_with_past) {
+        bool cancelled = speculative_decode(encoder_hidden_state,
+                                            config,
+                                            models,
+                                            init_ids,
+                                            output_tokens,
+                                            max_new_tokens,
+                                            return_timestamps,
+                                            raw_metrics,
+                                            streamer);
+        return {cancelled, output_tokens};
+    }
 
     for (size_t i = 0; i < max_new_tokens - 1; i++) {
-        auto output_token = decode_with_past(encoder_hidden_state,
-                                             models.decoder_with_past,
+        auto output_token = decode_with_past(models.decoder_with_past,
                                              output_tokens.back(),
                                              init_ids.size() + output_tokens.size() - 1,
                                              config,
@@ -239,10 +506,6 @@ std::pair<bool, std::vector<int64_t>> full_decode(ov::Tensor& encoder_hidden_sta
                                              return_timestamps,
                                              output_tokens);
 
-        if (i == 0) {
-            set_past_key_value(models.decoder_with_past, models.decoder_with_past);
-        }
-
         if (output_token == config.eos_token_id) {
             break;
         }
@@ -258,11 +521,147 @@ std::pair<bool, std::vector<int64_t>> full_decode(ov::Tensor& encoder_hidden_sta
     return {false, output_tokens};
 }
 
+// Greedy decoding of a batch of windows with the same init_ids length.
+// Each batch stops independently on eos or its max_new_tokens, finished batches are removed from the running batch
+// by selecting the remaining rows of the past key values similar to beam_idx in stateful LLM greedy decoding.
+std::vector<std::vector<int64_t>> full_decode_batch(ov::Tensor& encoder_hidden_state,
+                                                    const ov::genai::WhisperGenerationConfig& config,
+                                                    ov::genai::WhisperInitializedModels& models,
+                                                    const std::vector<std::vector<int64_t>>& init_ids,
+                                                    const std::vector<size_t>& max_new_tokens,
+                                                    const bool return_timestamps,
+                                                    ov::genai::RawPerfMetrics& raw_metrics) {
+    const size_t batch_size = init_ids.size();
+    const size_t init_ids_size = init_ids.front().size();
+
+    std::vector<int64_t> input_ids;
+    input_ids.reserve(batch_size * init_ids_size);
+    for (const auto& batch_init_ids : init_ids) {
+        OPENVINO_ASSERT(batch_init_ids.size() == init_ids_size, "init_ids should have the same size for all batches");
+        input_ids.insert(input_ids.end(), batch_init_ids.begin(), batch_init_ids.end());
+    }
+
+    models.decoder.set_tensor("encoder_hidden_states", ov::Tensor{encoder_hidden_state});
+    models.decoder.set_tensor("input_ids", ov::Tensor(ov::element::i64, {batch_size, init_ids_size}, input_ids.data()));
+
+    infer_with_perf_metrics(models.decoder, raw_metrics, batch_size);
+
+    auto logits = models.decoder.get_tensor("logits");
+
+    std::vector<std::vector<int64_t>> output_tokens(batch_size);
+    // indices of running batches in the original batch
+    std::vector<size_t> running_batches;
+    for (size_t batch = 0; batch < batch_size; batch++) {
+        ov::genai::do_suppress_tokens(logits, batch, config.begin_suppress_tokens);
+        ov::genai::do_suppress_tokens(logits, batch, config.suppress_tokens);
+        if (return_timestamps) {
+            ov::genai::process_whisper_timestamp_logits(logits, batch, config, {}, true);
+        }
+        output_tokens[batch].push_back(ov::genai::utils::argmax(logits, batch));
+
+        if (max_new_tokens[batch] > 1) {
+            running_batches.push_back(batch);
+        }
+    }
+
+    if (running_batches.empty()) {
+        return output_tokens;
+    }
+
+    set_past_key_value(models.decoder, models.decoder_with_past, encoder_hidden_state);
+    if (running_batches.size() < batch_size) {
+        select_past_key_value_batch(models.decoder_with_past, running_batches);
+    }
+
+    for (size_t cache_position = init_ids_size; !running_batches.empty(); cache_position++) {
+        const size_t running_batch_size = running_batches.size();
+
+        std::vector<int64_t> next_input_ids(running_batch_size);
+        for (size_t i = 0; i < running_batch_size; i++) {
+            next_input_ids[i] = output_tokens[running_batches[i]].back();
+        }
+        models.decoder_with_past.set_tensor("input_ids",
+                                            ov::Tensor(ov::element::i64, {running_batch_size, 1}, next_input_ids.data()));
+
+        ov::Tensor cache_position_tensor = models.decoder_with_past.get_tensor("cache_position");
+        cache_position_tensor.set_shape({1});
+        cache_position_tensor.data<int64_t>()[0] = cache_position;
+
+        infer_with_perf_metrics(models.decoder_with_past, raw_metrics, running_batch_size);
+
+        auto logits = models.decoder_with_past.get_tensor("logits");
+
+        // positions of batches that continue generation in the current running batch
+        std::vector<size_t> continued_positions;
+        std::vector<size_t> continued_batches;
+        for (size_t i = 0; i < running_batch_size; i++) {
+            const size_t batch = running_batches[i];
+            ov::genai::do_suppress_tokens(logits, i, config.suppress_tokens);
+            if (return_timestamps) {
+                ov::genai::process_whisper_timestamp_logits(logits, i, config, output_tokens[batch]);
+            }
+
+            int64_t output_token = ov::genai::utils::argmax(logits, i);
+            if (output_token == config.eos_token_id) {
+                continue;
+            }
+
+            output_tokens[batch].push_back(output_token);
+            if (output_tokens[batch].size() < max_new_tokens[batch]) {
+                continued_positions.push_back(i);
+                continued_batches.push_back(batch);
+            }
+        }
+
+        if (!continued_batches.empty() && continued_batches.size() < running_batch_size) {
+            select_past_key_value_batch(models.decoder_with_past, continued_positions);
+        }
+        running_batches = std::move(continued_batches);
+    }
+
+    return output_tokens;
+}
+
 }  // namespace
 
 namespace ov {
 namespace genai {
 
+void make_decoder_with_past_stateful(std::shared_ptr<ov::Model> model) {
+    // past length is the first cache position of the current input_ids, the cache read from a variable is sliced to it
+    // along the sequence dimension of [batch, num_heads, sequence_length, head_size]
+    auto axis = ov::op::v0::Constant::create(ov::element::i64, {1}, {2});
+    auto zero = ov::op::v0::Constant::create(ov::element::i64, {1}, {0});
+    auto one = ov::op::v0::Constant::create(ov::element::i64, {1}, {1});
+    auto past_length = std::make_shared<ov::op::v8::Slice>(model->input("cache_position"), zero, one, one, zero);
+
+    // parameters are removed in the loop, so iterate over a copy
+    const ov::ParameterVector parameters = model->get_parameters();
+    for (const auto& parameter : parameters) {
+        const std::string name = parameter->get_output_tensor(0).get_any_name();
+        // cross-attention cache depends on encoder hidden states only and is not updated by decoder_with_past
+        if (name.find("past_key_values") == std::string::npos || name.find(".decoder.") == std::string::npos) {
+            continue;
+        }
+
+        auto result = ov::as_type_ptr<ov::op::v0::Result>(model->output(get_present_name(name)).get_node_shared_ptr());
+        OPENVINO_ASSERT(result, "Output ", get_present_name(name), " is not found for input ", name);
+
+        auto variable = std::make_shared<ov::op::util::Variable>(
+            ov::op::util::VariableInfo{parameter->get_partial_shape(), parameter->get_element_type(), name});
+        model->add_variables({variable});
+
+        auto read_value = std::make_shared<ov::op::v6::ReadValue>(variable);
+        auto past = std::make_shared<ov::op::v8::Slice>(read_value, zero, past_length, one, axis);
+        parameter->output(0).replace(past->output(0));
+        model->remove_parameter(parameter);
+
+        model->add_sinks({std::make_shared<ov::op::v6::Assign>(result->input_value(0), variable)});
+        model->remove_result(result);
+    }
+    model->validate_nodes_and_infer_types();
+}
+
 WhisperGenerateResult whisper_generate(const ov::genai::WhisperGenerationConfig& config,
                                        const ov::genai::WhisperConfig& model_config,
                                        const RawSpeechInput& raw_speech,
@@ -271,6 +670,13 @@ WhisperGenerateResult whisper_generate(const ov::genai::WhisperGenerationConfig&
                                        const std::shared_ptr<StreamerBase> streamer) {
     auto input_features = feature_extractor.extract(raw_speech);
 
+    // silent frames are removed before decoding, segments timestamps are mapped back to the original audio
+    std::vector<SpeechRegion> speech_regions;
+    if (config.skip_silence) {
+        speech_regions = detect_speech_regions(input_features, config.silence_threshold_db);
+        input_features = select_frames(input_features, speech_regions);
+    }
+
     const bool is_shortform = input_features.n_frames <= feature_extractor.nb_max_frames;
     // long-form audio processing requires timestamps to be enabled
     const bool return_timestamps = config.return_timestamps || !is_shortform;
@@ -285,30 +691,82 @@ WhisperGenerateResult whisper_generate(const ov::genai::WhisperGenerationConfig&
     raw_metrics.m_token_infer_durations.reserve(max_new_tokens);
     raw_metrics.m_inference_durations = {{MicroSeconds(0.0f)}};
 
+    // nothing to encode and decode for inputs without speech
+    if (config.skip_silence && input_features.n_frames == 0) {
+        if (streamer) {
+            streamer->end();
+        }
+        return result;
+    }
+
     std::vector<int64_t> init_ids;
     std::vector<int64_t>& output_tokens = result.output_tokens;
     std::vector<Segment> segments;
 
     // 0.02 by default
     const float time_precision = static_cast<float>(feature_extractor.chunk_length) / model_config.max_source_positions;
+    // 0.01 by default, converts frame offset of a chunk to seconds
+    const float frame_duration = static_cast<float>(feature_extractor.hop_length) / feature_extractor.sampling_rate;
     size_t segment_offset = 0;
 
+    // Speculative encoding: the window that starts right after the current one is encoded by the second request
+    // while the current window is decoded. Requests swap roles when the speculative result is used.
+    const bool speculative_encoding = config.speculative_encoding && !is_shortform;
+    if (speculative_encoding && !models.encoder_speculative) {
+        models.encoder_speculative = models.encoder.get_compiled_model().create_infer_request();
+    }
+    ov::InferRequest* encoder = &models.encoder;
+    ov::InferRequest* speculative_encoder = &models.encoder_speculative;
+    std::vector<float> speculative_features_chunk;
+    std::optional<size_t> speculative_offset;
+
     for (size_t chunk_offset = 0; chunk_offset < input_features.n_frames; chunk_offset += segment_offset) {
         if (output_tokens.size() >= max_new_tokens) {
             break;
         }
 
-        auto input_features_chunk = input_features.get_data_with_offset(chunk_offset, feature_extractor.nb_max_frames);
+        ov::Tensor hidden_state_tensor;
+        if (speculative_offset.has_value()) {
+            const auto wait_start = std::chrono::steady_clock::now();
+            speculative_encoder->wait();
+            raw_metrics.m_inference_durations[0] +=
+                MicroSeconds(PerfMetrics::get_microsec(std::chrono::steady_clock::now() - wait_start));
+        }
 
-        ov::Tensor hidden_state_tensor = encode(models.encoder,
-                                                input_features_chunk,
-                                                feature_extractor.feature_size,
-                                                feature_extractor.nb_max_frames,
-                                                raw_metrics);
+        if (speculative_offset == chunk_offset) {
+            hidden_state_tensor = speculative_encoder->get_tensor("last_hidden_state");
+            std::swap(encoder, speculative_encoder);
+        } else {
+            // no speculation or the predicted offset is wrong, the speculative result is discarded
+            auto input_features_chunk =
+                input_features.get_data_with_offset(chunk_offset, feature_extractor.nb_max_frames);
+
+            hidden_state_tensor = encode(*encoder,
+                                         input_features_chunk,
+                                         feature_extractor.feature_size,
+                                         feature_extractor.nb_max_frames,
+                                         raw_metrics);
+        }
+        speculative_offset = std::nullopt;
+
+        const size_t next_chunk_offset = chunk_offset + feature_extractor.nb_max_frames;
+        if (speculative_encoding && next_chunk_offset < input_features.n_frames) {
+            speculative_features_chunk =
+                input_features.get_data_with_offset(next_chunk_offset, feature_extractor.nb_max_frames);
+            start_encode_async(*speculative_encoder,
+                               speculative_features_chunk,
+                               feature_extractor.feature_size,
+                               feature_extractor.nb_max_frames);
+            speculative_offset = next_chunk_offset;
+        }
 
         // prepare init_ids just once for whole input
+        bool start_token_decoded = false;
         if (init_ids.empty()) {
-            init_ids = prepare_init_ids(hidden_state_tensor, models.decoder, config, return_timestamps);
+            init_ids = prepare_init_ids(hidden_state_tensor, models.decoder, config, return_timestamps).front();
+            result.detected_language = get_detected_language(config, init_ids);
+            // language detection has computed the decoder cache for decoder_start_token_id of this window
+            start_token_decoded = requires_language_detection(config);
         }
 
         auto [cancelled, chunk_output_tokens] = full_decode(hidden_state_tensor,
@@ -318,13 +776,15 @@ WhisperGenerateResult whisper_generate(const ov::genai::WhisperGenerationConfig&
                                                             max_new_tokens - output_tokens.size(),
                                                             return_timestamps,
                                                             raw_metrics,
-                                                            streamer);
+                                                            streamer,
+                                                            start_token_decoded);
 
         if (return_timestamps) {
             auto extracted_segments = ov::genai::extract_segments(chunk_output_tokens,
                                                                   config,
                                                                   feature_extractor.nb_max_frames,
-                                                                  time_precision);
+                                                                  time_precision,
+                                                                  chunk_offset * frame_duration);
 
             segments.insert(segments.end(), extracted_segments.segments.begin(), extracted_segments.segments.end());
 
@@ -346,6 +806,11 @@ WhisperGenerateResult whisper_generate(const ov::genai::WhisperGenerationConfig&
         }
     }
 
+    // speculative_features_chunk has to outlive the request
+    if (speculative_offset.has_value()) {
+        speculative_encoder->wait();
+    }
+
     if (streamer) {
         streamer->end();
     }
@@ -355,9 +820,190 @@ WhisperGenerateResult whisper_generate(const ov::genai::WhisperGenerationConfig&
         return result;
     }
 
+    remap_segments(segments, speech_regions, frame_duration);
     result.segments = segments;
 
     return result;
 }
+
+std::vector<WhisperGenerateResult> whisper_generate(const ov::genai::WhisperGenerationConfig& config,
+                                                    const ov::genai::WhisperConfig& model_config,
+                                                    const std::vector<RawSpeechInput>& raw_speech_inputs,
+                                                    ov::genai::WhisperInitializedModels& models,
+                                                    WhisperFeatureExtractor& feature_extractor) {
+    struct StreamState {
+        WhisperFeatures input_features;
+        bool is_shortform;
+        size_t chunk_offset = 0;
+        std::vector<int64_t> init_ids;
+        std::vector<Segment> segments;
+        std::vector<SpeechRegion> speech_regions;
+        bool finished = false;
+    };
+
+    const size_t max_new_tokens = config.get_max_new_tokens();
+
+    std::vector<StreamState> streams(raw_speech_inputs.size());
+    bool has_longform = false;
+    for (size_t i = 0; i < streams.size(); i++) {
+        streams[i].input_features = feature_extractor.extract(raw_speech_inputs[i]);
+        if (config.skip_silence) {
+            streams[i].speech_regions = detect_speech_regions(streams[i].input_features, config.silence_threshold_db);
+            streams[i].input_features = select_frames(streams[i].input_features, streams[i].speech_regions);
+            // nothing to decode for inputs without speech
+            streams[i].finished = streams[i].input_features.n_frames == 0;
+        }
+        streams[i].is_shortform = streams[i].input_features.n_frames <= feature_extractor.nb_max_frames;
+        has_longform = has_longform || !streams[i].is_shortform;
+    }
+
+    // init_ids size has to be the same for all batches, so timestamps are enabled for all streams if at least one of
+    // them is long-form
+    const bool return_timestamps = config.return_timestamps || has_longform;
+
+    RawPerfMetrics raw_metrics;
+    raw_metrics.m_inference_durations = {{MicroSeconds(0.0f)}};
+
+    std::vector<WhisperGenerateResult> results(streams.size());
+
+    // 0.02 by default
+    const float time_precision = static_cast<float>(feature_extractor.chunk_length) / model_config.max_source_positions;
+    // 0.01 by default, converts frame offset of a chunk to seconds
+    const float frame_duration = static_cast<float>(feature_extractor.hop_length) / feature_extractor.sampling_rate;
+
+    // each iteration encodes the next window of all unfinished streams in one batch and decodes them together
+    while (true) {
+        std::vector<size_t> batch_streams;
+        for (size_t i = 0; i < streams.size(); i++) {
+            if (!streams[i].finished) {
+                batch_streams.push_back(i);
+            }
+        }
+        if (batch_streams.empty()) {
+            break;
+        }
+
+        std::vector<float> input_features_batch;
+        input_features_batch.reserve(batch_streams.size() * feature_extractor.feature_size *
+                                     feature_extractor.nb_max_frames);
+        for (const size_t stream_idx : batch_streams) {
+            auto& stream = streams[stream_idx];
+            auto input_features_chunk =
+                stream.input_features.get_data_with_offset(stream.chunk_offset, feature_extractor.nb_max_frames);
+            input_features_batch.insert(input_features_batch.end(),
+                                        input_features_chunk.begin(),
+                                        input_features_chunk.end());
+        }
+
+        ov::Tensor hidden_state_tensor = encode(models.encoder,
+                                                input_features_batch,
+                                                feature_extractor.feature_size,
+                                                feature_extractor.nb_max_frames,
+                                                raw_metrics,
+                                                batch_streams.size());
+
+        // all streams with speech are in the first batch, prepare init_ids just once for whole input of each stream
+        if (streams[batch_streams.front()].init_ids.empty()) {
+            auto init_ids = prepare_init_ids(hidden_state_tensor, models.decoder, config, return_timestamps);
+            for (size_t i = 0; i < batch_streams.size(); i++) {
+                results[batch_streams[i]].detected_language = get_detected_language(config, init_ids[i]);
+                streams[batch_streams[i]].init_ids = std::move(init_ids[i]);
+            }
+        }
+
+        std::vector<std::vector<int64_t>> init_ids;
+        std::vector<size_t> stream_max_new_tokens;
+        for (const size_t stream_idx : batch_streams) {
+            init_ids.push_back(streams[stream_idx].init_ids);
+            stream_max_new_tokens.push_back(max_new_tokens - results[stream_idx].output_tokens.size());
+        }
+
+        auto chunk_output_tokens = full_decode_batch(hidden_state_tensor,
+                                                     config,
+                                                     models,
+                                                     init_ids,
+                                                     stream_max_new_tokens,
+                                                     return_timestamps,
+                                                     raw_metrics);
+
+        for (size_t i = 0; i < batch_streams.size(); i++) {
+            auto& stream = streams[batch_streams[i]];
+            auto& output_tokens = results[batch_streams[i]].output_tokens;
+            size_t segment_offset = 0;
+
+            if (return_timestamps) {
+                auto extracted_segments = ov::genai::extract_segments(chunk_output_tokens[i],
+                                                                      config,
+                                                                      feature_extractor.nb_max_frames,
+                                                                      time_precision,
+                                                                      stream.chunk_offset * frame_duration);
+
+                stream.segments.insert(stream.segments.end(),
+                                       extracted_segments.segments.begin(),
+                                       extracted_segments.segments.end());
+
+                output_tokens.insert(output_tokens.end(),
+                                     extracted_segments.non_timestamp_tokens.begin(),
+                                     extracted_segments.non_timestamp_tokens.end());
+
+                segment_offset = extracted_segments.last_offset;
+            } else {
+                output_tokens.insert(output_tokens.end(), chunk_output_tokens[i].begin(), chunk_output_tokens[i].end());
+            }
+
+            if (stream.is_shortform) {
+                segment_offset = stream.input_features.n_frames;
+            }
+
+            stream.chunk_offset += segment_offset;
+            stream.finished = stream.chunk_offset >= stream.input_features.n_frames ||
+                              output_tokens.size() >= max_new_tokens;
+        }
+    }
+
+    for (size_t i = 0; i < streams.size(); i++) {
+        results[i].perf_metrics.num_input_tokens = 0;
+        results[i].perf_metrics.raw_metrics = raw_metrics;
+        // if return_timestamps wasn't enabled by user
+        if (config.return_timestamps) {
+            remap_segments(streams[i].segments, streams[i].speech_regions, frame_duration);
+            results[i].segments = std::move(streams[i].segments);
+        }
+    }
+
+    return results;
+}
+
+WhisperEncodedInput whisper_encode(const ov::genai::WhisperGenerationConfig& config,
+                                   const RawSpeechInput& raw_speech,
+                                   ov::genai::WhisperInitializedModels& models,
+                                   WhisperFeatureExtractor& feature_extractor) {
+    auto input_features = feature_extractor.extract(raw_speech);
+    OPENVINO_ASSERT(input_features.n_frames <= feature_extractor.nb_max_frames,
+                    "Only inputs up to ",
+                    feature_extractor.chunk_length,
+                    " seconds can be encoded at once");
+
+    RawPerfMetrics raw_metrics;
+    raw_metrics.m_inference_durations = {{MicroSeconds(0.0f)}};
+
+    auto input_features_chunk = input_features.get_data_with_offset(0, feature_extractor.nb_max_frames);
+    ov::Tensor hidden_state_tensor = encode(models.encoder,
+                                            input_features_chunk,
+                                            feature_extractor.feature_size,
+                                            feature_extractor.nb_max_frames,
+                                            raw_metrics);
+
+    WhisperEncodedInput encoded_input;
+    encoded_input.init_ids =
+        prepare_init_ids(hidden_state_tensor, models.decoder, config, config.return_timestamps).front();
+
+    // the encoder output is overwritten by the next inference of the encoder request
+    encoded_input.encoder_hidden_states =
+        ov::Tensor(hidden_state_tensor.get_element_type(), hidden_state_tensor.get_shape());
+    hidden_state_tensor.copy_to(encoded_input.encoder_hidden_states);
+
+    return encoded_input;
+}
 }  // namespace genai
 }  // namespace ov
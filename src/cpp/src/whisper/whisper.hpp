@@ -23,9 +23,27 @@ struct Segment {
 struct WhisperGenerateResult {
     std::vector<int64_t> output_tokens;
     std::optional<std::vector<Segment>> segments = std::nullopt;
+    // language token name, e.g. <|en|>, if it was detected
+    std::optional<std::string> detected_language = std::nullopt;
     PerfMetrics perf_metrics;
 };
 
+// Encoded window and the tokens its decoding starts with
+struct WhisperEncodedInput {
+    std::vector<int64_t> init_ids;
+    // batch size is 1
+    ov::Tensor encoder_hidden_states;
+};
+
+/**
+ * Makes self-attention cache of decoder_with_past model stateful: past_key_values.N.decoder.* inputs and
+ * present.N.decoder.* outputs are replaced by variables named as the inputs, so the cache is updated in place
+ * by the plugin and only input_ids and cache_position are set on each decoding step.
+ * The cache read from variables is cut to the first cache_position value, so entries after it are dropped by the
+ * next inference and the cache is rolled back by setting an earlier cache_position without touching the state.
+ */
+void make_decoder_with_past_stateful(std::shared_ptr<ov::Model> model);
+
 WhisperGenerateResult whisper_generate(const ov::genai::WhisperGenerationConfig& config,
                                        const ov::genai::WhisperConfig& model_config,
                                        const ov::genai::RawSpeechInput& raw_speech,
@@ -33,5 +51,26 @@ WhisperGenerateResult whisper_generate(const ov::genai::WhisperGenerationConfig&
                                        ov::genai::WhisperFeatureExtractor& feature_extractor,
                                        const std::shared_ptr<StreamerBase> streamer);
 
+/**
+ * Transcribes several raw speech inputs together: the current windows of all inputs are encoded in one batch and
+ * decoded in one batch, inputs that finish earlier leave the batch. Timestamps are enabled for all inputs if at
+ * least one of them is long-form. Perf metrics are shared by all results.
+ */
+std::vector<WhisperGenerateResult> whisper_generate(const ov::genai::WhisperGenerationConfig& config,
+                                                    const ov::genai::WhisperConfig& model_config,
+                                                    const std::vector<ov::genai::RawSpeechInput>& raw_speech_inputs,
+                                                    ov::genai::WhisperInitializedModels& models,
+                                                    ov::genai::WhisperFeatureExtractor& feature_extractor);
+
+/**
+ * Encodes short-form raw speech and prepares init_ids for decoding of the window by an external decoder, e.g.
+ * scheduled by continuous batching. The decoder isn't inferred unless language detection is needed, so init_ids are
+ * prefilled only by the caller. Returned tensor is owned by the result.
+ */
+WhisperEncodedInput whisper_encode(const ov::genai::WhisperGenerationConfig& config,
+                                   const ov::genai::RawSpeechInput& raw_speech,
+                                   ov::genai::WhisperInitializedModels& models,
+                                   ov::genai::WhisperFeatureExtractor& feature_extractor);
+
 }  // namespace genai
 }  // namespace ov
@@ -14,11 +14,12 @@
 #include <iostream>
 #include <nlohmann/json.hpp>
 #include <openvino/core/except.hpp>
+#include <openvino/core/parallel.hpp>
 #include <openvino/openvino.hpp>
 #include <string>
-#include <thread>
 #include <vector>
 
+#include "fft.hpp"
 #include "json_utils.hpp"
 #include "openvino/genai/visibility.hpp"
 
@@ -40,114 +41,29 @@ static bool hann_window(const size_t length, const bool periodic, std::vector<fl
     return true;
 }
 
-// naive Discrete Fourier Transform
-// input is real-valued
-// output is complex-valued
-static void dft(const std::vector<float>& in,
-                std::vector<float>& out,
-                const std::vector<float>& sin_vals,
-                const std::vector<float>& cos_vals,
-                const size_t n_fft) {
-    int N = in.size();
-
-    out.resize(N * 2);
-    const int sin_cos_step = n_fft / N;
-
-    for (int k = 0; k < N; k++) {
-        float re = 0;
-        float im = 0;
-
-        for (int n = 0; n < N; n++) {
-            int idx = (k * n * sin_cos_step) % (n_fft);  // t = 2*M_PI*k*n/N
-            re += in[n] * cos_vals[idx];                 // cos(t)
-            im -= in[n] * sin_vals[idx];                 // sin(t)
-        }
-
-        out[k * 2 + 0] = re;
-        out[k * 2 + 1] = im;
-    }
-}
-
-// Cooley-Tukey FFT
-// input is real-valued
-// output is complex-valued
-static void fft(const std::vector<float>& in,
-                std::vector<float>& out,
-                const std::vector<float>& sin_vals,
-                const std::vector<float>& cos_vals,
-                const size_t n_fft) {
-    out.resize(in.size() * 2);
-
-    int N = in.size();
-
-    if (N == 1) {
-        out[0] = in[0];
-        out[1] = 0;
-        return;
-    }
-
-    if (N % 2 == 1) {
-        dft(in, out, sin_vals, cos_vals, n_fft);
-        return;
-    }
-
-    std::vector<float> even;
-    std::vector<float> odd;
-
-    even.reserve(N / 2);
-    odd.reserve(N / 2);
-
-    for (int i = 0; i < N; i++) {
-        if (i % 2 == 0) {
-            even.push_back(in[i]);
-        } else {
-            odd.push_back(in[i]);
-        }
-    }
-
-    std::vector<float> even_fft;
-    std::vector<float> odd_fft;
-
-    fft(even, even_fft, sin_vals, cos_vals, n_fft);
-    fft(odd, odd_fft, sin_vals, cos_vals, n_fft);
-
-    const int sin_cos_step = n_fft / N;
-    for (int k = 0; k < N / 2; k++) {
-        int idx = k * sin_cos_step;  // t = 2*M_PI*k/N
-        float re = cos_vals[idx];    // cos(t)
-        float im = -sin_vals[idx];   // sin(t)
-
-        float re_odd = odd_fft[2 * k + 0];
-        float im_odd = odd_fft[2 * k + 1];
-
-        out[2 * k + 0] = even_fft[2 * k + 0] + re * re_odd - im * im_odd;
-        out[2 * k + 1] = even_fft[2 * k + 1] + re * im_odd + im * re_odd;
-
-        out[2 * (k + N / 2) + 0] = even_fft[2 * k + 0] - re * re_odd + im * im_odd;
-        out[2 * (k + N / 2) + 1] = even_fft[2 * k + 1] - re * im_odd - im * re_odd;
-    }
-}
-
-static void log_mel_spectrogram_worker_thread(int ith,
-                                              const std::vector<float>& hann,
-                                              const std::vector<float>& samples,
-                                              int n_samples,
-                                              int frame_size,
-                                              int frame_step,
-                                              int n_threads,
-                                              const std::vector<float>& mel_filter,
-                                              WhisperFeatures& features,
-                                              const std::vector<float>& sin_vals,
-                                              const std::vector<float>& cos_vals) {
+// Computes frames in [frame_begin, frame_end) range, `samples` is shared between all workers and only read
+static void log_mel_spectrogram_worker(int frame_begin,
+                                       int frame_end,
+                                       const std::vector<float>& hann,
+                                       const std::vector<float>& samples,
+                                       int n_samples,
+                                       int frame_size,
+                                       int frame_step,
+                                       const std::vector<float>& mel_filter,
+                                       const std::vector<std::pair<size_t, size_t>>& mel_filter_ranges,
+                                       const ov::genai::RealFFTPlan& fft_plan,
+                                       WhisperFeatures& features) {
     std::vector<float> fft_in(frame_size, 0.0);
-    std::vector<float> fft_out(2 * frame_size);
-    int n_fft = 1 + (frame_size / 2);
-    int i = ith;
+    std::vector<float> power(fft_plan.get_n_bins());
+    std::vector<std::complex<float>> fft_work;
+    int n_fft = fft_plan.get_n_bins();
+    int i = frame_begin;
 
     OPENVINO_ASSERT(mel_filter.size() == n_fft * features.feature_size);
+    OPENVINO_ASSERT(mel_filter_ranges.size() == features.feature_size);
 
     // calculate FFT only when fft_in are not all zero
-    for (; i < std::min(n_samples / frame_step + 1, int(features.n_frames)); i += n_threads) {
+    for (; i < std::min(n_samples / frame_step + 1, frame_end); i++) {
         const int offset = i * frame_step;
 
         // apply Hanning window (~10% faster)
@@ -159,29 +75,17 @@ static void log_mel_spectrogram_worker_thread(int ith,
             std::fill(fft_in.begin() + (n_samples - offset), fft_in.end(), 0.0);
         }
 
-        // FFT
-        fft(fft_in, fft_out, sin_vals, cos_vals, frame_size);
-
-        // Calculate modulus^2 of complex numbers
-        // Use pow(fft_out[2 * j + 0], 2) + pow(fft_out[2 * j + 1], 2) causes inference quality problem? Interesting.
-        for (int j = 0; j < n_fft; j++) {
-            fft_out[j] = (fft_out[2 * j + 0] * fft_out[2 * j + 0] + fft_out[2 * j + 1] * fft_out[2 * j + 1]);
-        }
+        // FFT and modulus^2 of complex numbers
+        fft_plan.power_spectrum(fft_in.data(), power.data(), fft_work);
 
         // mel spectrogram
+        // triangular filters are non-zero in a narrow range of frequency bins only, other bins are skipped
         for (int j = 0; j < features.feature_size; j++) {
             double sum = 0.0;
 
-            // unroll loop (suggested by GH user @lunixbochs)
-            int k = 0;
-            for (k = 0; k < n_fft - 3; k += 4) {
-                sum += fft_out[k + 0] * mel_filter[j * n_fft + k + 0] + fft_out[k + 1] * mel_filter[j * n_fft + k + 1] +
-                       fft_out[k + 2] * mel_filter[j * n_fft + k + 2] + fft_out[k + 3] * mel_filter[j * n_fft + k + 3];
-            }
-
-            // handle n_fft remainder
-            for (; k < n_fft; k++) {
-                sum += fft_out[k] * mel_filter[j * n_fft + k];
+            const float* filter = mel_filter.data() + j * n_fft;
+            for (size_t k = mel_filter_ranges[j].first; k < mel_filter_ranges[j].second; k++) {
+                sum += power[k] * filter[k];
             }
 
             sum = log10(std::max(sum, 1e-10));
@@ -192,7 +96,7 @@ static void log_mel_spectrogram_worker_thread(int ith,
 
     // Otherwise fft_out are all zero
     double sum = log10(1e-10);
-    for (; i < features.n_frames; i += n_threads) {
+    for (; i < frame_end; i++) {
         for (int j = 0; j < features.feature_size; j++) {
             features.data[j * features.n_frames + i] = sum;
         }
@@ -302,19 +206,6 @@ std::vector<std::vector<float>> mel_filter_bank(const int64_t num_frequency_bins
     return mel_filters;
 }
 
-// In FFT, we frequently use sine and cosine operations with the same values.
-// We can use precalculated values to speed up the process.
-void fill_sin_cos_table(std::vector<float>& sin_vals, std::vector<float>& cos_vals, const size_t n_fft) {
-    sin_vals.resize(n_fft);
-    cos_vals.resize(n_fft);
-
-    for (size_t i = 0; i < n_fft; i++) {
-        double theta = (2 * M_PI * i) / n_fft;
-        sin_vals[i] = sinf(theta);
-        cos_vals[i] = cosf(theta);
-    }
-}
-
 std::vector<float> pad(const std::vector<float>& raw_speech,
                        const size_t minimum_length,
                        const size_t reflect_pad_size) {
@@ -342,10 +233,9 @@ WhisperFeatures mel_spectrogram_convert_audio(const std::vector<float>& raw_spee
                                               const size_t feature_size,
                                               const size_t n_fft,
                                               const size_t hop_length,
-                                              const size_t n_threads,
                                               const std::vector<float>& mel_filter,
-                                              const std::vector<float>& sin_vals,
-                                              const std::vector<float>& cos_vals) {
+                                              const std::vector<std::pair<size_t, size_t>>& mel_filter_ranges,
+                                              const ov::genai::RealFFTPlan& fft_plan) {
     // Hanning window (Use cosf to eliminate difference)
     // ref: https://pytorch.org/docs/stable/generated/torch.hann_window.html
     // ref: https://github.com/openai/whisper/blob/main/whisper/audio.py#L147
@@ -362,40 +252,23 @@ WhisperFeatures mel_spectrogram_convert_audio(const std::vector<float>& raw_spee
     features.n_frames = (padded_raw_speech.size() - n_fft) / hop_length;
     features.data.resize(features.feature_size * features.n_frames);
 
-    {
-        std::vector<std::thread> workers(n_threads - 1);
-        for (int iw = 0; iw < n_threads - 1; ++iw) {
-            workers[iw] = std::thread(log_mel_spectrogram_worker_thread,
-                                      iw + 1,
-                                      std::cref(hann),
-                                      padded_raw_speech,
-                                      raw_speech.size() + reflect_pad_size,
-                                      n_fft,
-                                      hop_length,
-                                      n_threads,
-                                      std::cref(mel_filter),
-                                      std::ref(features),
-                                      std::cref(sin_vals),
-                                      std::cref(cos_vals));
-        }
-
-        // main thread
-        log_mel_spectrogram_worker_thread(0,
-                                          hann,
-                                          padded_raw_speech,
-                                          raw_speech.size() + reflect_pad_size,
-                                          n_fft,
-                                          hop_length,
-                                          n_threads,
-                                          mel_filter,
-                                          features,
-                                          sin_vals,
-                                          cos_vals);
-
-        for (int iw = 0; iw < n_threads - 1; ++iw) {
-            workers[iw].join();
-        }
-    }
+    // Frames are statically partitioned into contiguous ranges, one per worker of the OpenVINO thread pool.
+    // The pool is persistent and shared by all pipelines in the process, workers read the padded audio by reference.
+    ov::parallel_nt_static(0, [&](const int ithr, const int nthr) {
+        size_t frame_begin = 0, frame_end = 0;
+        ov::splitter(features.n_frames, size_t(nthr), size_t(ithr), frame_begin, frame_end);
+        log_mel_spectrogram_worker(int(frame_begin),
+                                   int(frame_end),
+                                   hann,
+                                   padded_raw_speech,
+                                   raw_speech.size() + reflect_pad_size,
+                                   n_fft,
+                                   hop_length,
+                                   mel_filter,
+                                   mel_filter_ranges,
+                                   fft_plan,
+                                   features);
+    });
 
     // clamping and normalization
     double mmax = -1e20;
@@ -442,7 +315,7 @@ std::vector<float> WhisperFeatures::get_data_with_offset(const size_t frame_offs
 
 WhisperFeatureExtractor::WhisperFeatureExtractor(const std::string& preprocessor_json_path) {
     init_parameters(preprocessor_json_path);
-    fill_sin_cos_table(sin_vals, cos_vals, n_fft);
+    fft_plan = std::make_shared<RealFFTPlan>(n_fft);
     init_mel_filter();
 }
 
@@ -477,19 +350,31 @@ void WhisperFeatureExtractor::init_mel_filter() {
             mel_filter[col * mel_data.size() + row] = mel_data[row][col];
         }
     }
+
+    // [begin, end) range of non-zero weights for each filter
+    mel_filter_ranges.assign(mel_data[0].size(), {0, 0});
+    for (size_t col = 0; col < mel_data[0].size(); col++) {
+        const float* filter = mel_filter.data() + col * mel_data.size();
+        size_t begin = 0, end = mel_data.size();
+        while (begin < end && filter[begin] == 0.0f) {
+            begin++;
+        }
+        while (end > begin && filter[end - 1] == 0.0f) {
+            end--;
+        }
+        mel_filter_ranges[col] = {begin, end};
+    }
 }
 
 WhisperFeatures WhisperFeatureExtractor::extract(const std::vector<float>& raw_speech) {
-    size_t n_threads = std::min(4, (int32_t)std::thread::hardware_concurrency());
     return mel_spectrogram_convert_audio(raw_speech,
                                          sampling_rate,
                                          feature_size,
                                          n_fft,
                                          hop_length,
-                                         n_threads,
                                          mel_filter,
-                                         sin_vals,
-                                         cos_vals);
+                                         mel_filter_ranges,
+                                         *fft_plan);
 }
 
 }  // namespace genai
@@ -3,7 +3,9 @@
 
 #pragma once
 
+#include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "openvino/genai/visibility.hpp"
@@ -11,6 +13,8 @@
 namespace ov {
 namespace genai {
 
+class RealFFTPlan;
+
 struct WhisperFeatures {
     size_t feature_size;
     size_t n_frames;
@@ -52,9 +56,11 @@ public:
     WhisperFeatures extract(const std::vector<float>& raw_speech);
 
 private:
-    std::vector<float> sin_vals;
-    std::vector<float> cos_vals;
+    std::shared_ptr<RealFFTPlan> fft_plan;
+    // flattened 2d array with shape [feature_size, n_fft / 2 + 1]
     std::vector<float> mel_filter;
+    // [begin, end) range of non-zero frequency bins of each mel filter
+    std::vector<std::pair<size_t, size_t>> mel_filter_ranges;
 
     void init_mel_filter();
     void init_parameters(const std::string& preprocessor_json_path);
@@ -10,8 +10,13 @@ namespace genai {
 
 struct WhisperInitializedModels {
     ov::InferRequest encoder;
+    // second encoder request for speculative encoding of the next window, created on demand
+    ov::InferRequest encoder_speculative;
     ov::InferRequest decoder;
     ov::InferRequest decoder_with_past;
+    // optional draft decoder for speculative decoding, it uses hidden states of the main encoder
+    ov::InferRequest draft_decoder;
+    ov::InferRequest draft_decoder_with_past;
 };
 }  // namespace genai
 }  // namespace ov
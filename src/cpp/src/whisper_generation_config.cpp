@@ -75,6 +75,11 @@ void WhisperGenerationConfig::update_generation_config(const ov::AnyMap& config_
     read_anymap_param(config_map, "lang_to_id", lang_to_id);
     read_anymap_param(config_map, "task", task);
     read_anymap_param(config_map, "return_timestamps", return_timestamps);
+    read_anymap_param(config_map, "speculative_encoding", speculative_encoding);
+    read_anymap_param(config_map, "num_assistant_tokens", num_assistant_tokens);
+    read_anymap_param(config_map, "reuse_detected_language", reuse_detected_language);
+    read_anymap_param(config_map, "skip_silence", skip_silence);
+    read_anymap_param(config_map, "silence_threshold_db", silence_threshold_db);
 }
 
 size_t WhisperGenerationConfig::get_max_new_tokens(size_t prompt_length) const {
@@ -88,6 +93,8 @@ size_t WhisperGenerationConfig::get_max_new_tokens(size_t prompt_length) const {
 
 void WhisperGenerationConfig::validate() const {
     OPENVINO_ASSERT(max_new_tokens > 0, "'max_new_tokens' must be greater than 0");
+    OPENVINO_ASSERT(num_assistant_tokens > 0, "'num_assistant_tokens' must be greater than 0");
+    OPENVINO_ASSERT(silence_threshold_db > 0.0f, "'silence_threshold_db' must be greater than 0");
 
     // max_new_tokens has priority over max_length
     // if max_new_tokens is defined no need to check max_length
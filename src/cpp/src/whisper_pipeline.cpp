@@ -10,6 +10,8 @@
 
 #include "text_callback_streamer.hpp"
 #include "utils.hpp"
+#include "whisper/continuous_batching.hpp"
+#include "whisper/streaming.hpp"
 #include "whisper/whisper.hpp"
 #include "whisper/whisper_config.hpp"
 #include "whisper/whisper_feature_extractor.hpp"
@@ -48,6 +50,12 @@ public:
     Tokenizer m_tokenizer;
     float m_load_time_ms = 0;
 
+    // language detected by a previous generate call, used if WhisperGenerationConfig::reuse_detected_language
+    std::optional<std::string> m_detected_language;
+
+    std::unique_ptr<WhisperStreamingSession> m_streaming_session;
+    std::unique_ptr<WhisperContinuousBatchingEngine> m_continuous_batching;
+
     Impl(const std::filesystem::path& model_path,
          const ov::genai::Tokenizer& tokenizer,
          const std::string& device,
@@ -60,13 +68,49 @@ public:
         auto [core_plugin_config, compile_plugin_config] = ov::genai::utils::split_core_complile_config(plugin_config);
         core.set_property(core_plugin_config);
 
+        std::optional<SchedulerConfig> continuous_batching_config;
+        if (auto it = compile_plugin_config.find(scheduler_config.name()); it != compile_plugin_config.end()) {
+            continuous_batching_config = it->second.as<SchedulerConfig>();
+            compile_plugin_config.erase(it);
+        }
+
+        std::optional<std::filesystem::path> draft_path;
+        if (auto it = compile_plugin_config.find(draft_decoder_path.name()); it != compile_plugin_config.end()) {
+            draft_path = it->second.as<std::string>();
+            compile_plugin_config.erase(it);
+        }
+
         m_models.encoder = core.compile_model(model_path / "openvino_encoder_model.xml", device, compile_plugin_config)
                                .create_infer_request();
         m_models.decoder = core.compile_model(model_path / "openvino_decoder_model.xml", device, compile_plugin_config)
                                .create_infer_request();
+        auto decoder_with_past_model = core.read_model((model_path / "openvino_decoder_with_past_model.xml").string());
+        make_decoder_with_past_stateful(decoder_with_past_model);
         m_models.decoder_with_past =
-            core.compile_model(model_path / "openvino_decoder_with_past_model.xml", device, compile_plugin_config)
-                .create_infer_request();
+            core.compile_model(decoder_with_past_model, device, compile_plugin_config).create_infer_request();
+
+        if (draft_path.has_value()) {
+            m_models.draft_decoder =
+                core.compile_model(*draft_path / "openvino_decoder_model.xml", device, compile_plugin_config)
+                    .create_infer_request();
+            auto draft_decoder_with_past_model =
+                core.read_model((*draft_path / "openvino_decoder_with_past_model.xml").string());
+            make_decoder_with_past_stateful(draft_decoder_with_past_model);
+            m_models.draft_decoder_with_past =
+                core.compile_model(draft_decoder_with_past_model, device, compile_plugin_config).create_infer_request();
+        }
+
+        if (continuous_batching_config.has_value()) {
+            m_continuous_batching = std::make_unique<WhisperContinuousBatchingEngine>(model_path,
+                                                                                      *continuous_batching_config,
+                                                                                      device,
+                                                                                      compile_plugin_config,
+                                                                                      core,
+                                                                                      m_tokenizer,
+                                                                                      m_model_config,
+                                                                                      m_models,
+                                                                                      m_feature_extractor);
+        }
 
         // If eos_token_id was not provided, take value
         if (m_generation_config.eos_token_id == -1) {
@@ -93,12 +137,149 @@ public:
             streamer_ptr = std::make_shared<TextCallbackStreamer>(m_tokenizer, *callback);
         }
 
+        apply_detected_language(config);
         auto generate_result = ov::genai::whisper_generate(config,
                                                            m_model_config,
                                                            raw_speech_input,
                                                            m_models,
                                                            m_feature_extractor,
                                                            streamer_ptr);
+        store_detected_language(config, generate_result);
+        return decode_result(generate_result, start_time);
+    }
+
+    std::vector<WhisperDecodedResults> generate(const std::vector<RawSpeechInput>& raw_speech_inputs,
+                                                OptionalWhisperGenerationConfig generation_config) {
+        auto start_time = std::chrono::steady_clock::now();
+        WhisperGenerationConfig config = (generation_config.has_value()) ? *generation_config : m_generation_config;
+        config.validate();
+
+        apply_detected_language(config);
+        auto generate_results =
+            m_continuous_batching
+                ? generate_with_continuous_batching(raw_speech_inputs, config)
+                : ov::genai::whisper_generate(config, m_model_config, raw_speech_inputs, m_models, m_feature_extractor);
+        std::vector<WhisperDecodedResults> results;
+        results.reserve(generate_results.size());
+        for (auto& generate_result : generate_results) {
+            store_detected_language(config, generate_result);
+            results.push_back(decode_result(generate_result, start_time));
+        }
+        return results;
+    }
+
+    GenerationHandle add_request(uint64_t request_id,
+                                 const RawSpeechInput& raw_speech_input,
+                                 OptionalWhisperGenerationConfig generation_config) {
+        OPENVINO_ASSERT(m_continuous_batching,
+                        "add_request requires continuous batching mode, pass ov::genai::scheduler_config to "
+                        "WhisperPipeline constructor");
+        WhisperGenerationConfig config = (generation_config.has_value()) ? *generation_config : m_generation_config;
+        config.validate();
+        return m_continuous_batching->add_request(request_id, raw_speech_input, config);
+    }
+
+    void step() {
+        OPENVINO_ASSERT(m_continuous_batching,
+                        "step requires continuous batching mode, pass ov::genai::scheduler_config to "
+                        "WhisperPipeline constructor");
+        m_continuous_batching->step();
+    }
+
+    bool has_non_finished_requests() {
+        return m_continuous_batching && m_continuous_batching->has_non_finished_requests();
+    }
+
+    void start_streaming(OptionalWhisperGenerationConfig generation_config,
+                         const WhisperStreamingConfig& streaming_config) {
+        WhisperGenerationConfig config = (generation_config.has_value()) ? *generation_config : m_generation_config;
+        config.validate();
+
+        m_streaming_session = std::make_unique<WhisperStreamingSession>(config,
+                                                                        streaming_config,
+                                                                        m_model_config,
+                                                                        m_models,
+                                                                        m_feature_extractor);
+    }
+
+    WhisperStreamingResult put_audio(const RawSpeechInput& audio_chunk) {
+        OPENVINO_ASSERT(m_streaming_session, "Streaming session is not started, call start_streaming() first");
+        auto committed_tokens = m_streaming_session->put_audio(audio_chunk);
+        return make_streaming_result(committed_tokens, m_streaming_session->get_partial_tokens());
+    }
+
+    WhisperStreamingResult finish_streaming() {
+        OPENVINO_ASSERT(m_streaming_session, "Streaming session is not started, call start_streaming() first");
+        auto committed_tokens = m_streaming_session->finish();
+        auto result = make_streaming_result(committed_tokens, {});
+        m_streaming_session.reset();
+        return result;
+    }
+
+private:
+    // Continuous batching engine decodes a single 30 seconds window per request,
+    // longer inputs are decoded one by one by the regular pipeline
+    std::vector<WhisperGenerateResult> generate_with_continuous_batching(
+        const std::vector<RawSpeechInput>& raw_speech_inputs,
+        const WhisperGenerationConfig& config) {
+        std::vector<size_t> shortform_indices;
+        std::vector<RawSpeechInput> shortform_inputs;
+        for (size_t i = 0; i < raw_speech_inputs.size(); i++) {
+            if (raw_speech_inputs[i].size() <= m_feature_extractor.n_samples) {
+                shortform_indices.push_back(i);
+                shortform_inputs.push_back(raw_speech_inputs[i]);
+            }
+        }
+
+        std::vector<WhisperGenerateResult> results(raw_speech_inputs.size());
+        if (!shortform_inputs.empty()) {
+            auto shortform_results = m_continuous_batching->generate(shortform_inputs, config);
+            for (size_t i = 0; i < shortform_indices.size(); i++) {
+                results[shortform_indices[i]] = std::move(shortform_results[i]);
+            }
+        }
+
+        for (size_t i = 0, next_shortform = 0; i < raw_speech_inputs.size(); i++) {
+            if (next_shortform < shortform_indices.size() && shortform_indices[next_shortform] == i) {
+                next_shortform++;
+                continue;
+            }
+            results[i] = ov::genai::whisper_generate(config,
+                                                     m_model_config,
+                                                     raw_speech_inputs[i],
+                                                     m_models,
+                                                     m_feature_extractor,
+                                                     nullptr);
+        }
+        return results;
+    }
+
+    void apply_detected_language(WhisperGenerationConfig& config) const {
+        if (config.reuse_detected_language && !config.language.has_value()) {
+            config.language = m_detected_language;
+        }
+    }
+
+    void store_detected_language(const WhisperGenerationConfig& config, const WhisperGenerateResult& result) {
+        if (config.reuse_detected_language && result.detected_language.has_value() && !m_detected_language) {
+            m_detected_language = result.detected_language;
+        }
+    }
+
+    WhisperStreamingResult make_streaming_result(const std::vector<int64_t>& committed_tokens,
+                                                 const std::vector<int64_t>& partial_tokens) {
+        WhisperStreamingResult result;
+        if (!committed_tokens.empty()) {
+            result.committed_text = m_tokenizer.decode(committed_tokens);
+        }
+        if (!partial_tokens.empty()) {
+            result.partial_text = m_tokenizer.decode(partial_tokens);
+        }
+        return result;
+    }
+
+    WhisperDecodedResults decode_result(WhisperGenerateResult& generate_result,
+                                        const std::chrono::steady_clock::time_point start_time) {
         auto decode_start_time = std::chrono::steady_clock::now();
         WhisperDecodedResults result{std::vector{m_tokenizer.decode(generate_result.output_tokens)}, std::vector{1.f}};
         generate_result.perf_metrics.raw_metrics.detokenization_durations.emplace_back(
@@ -170,6 +351,39 @@ ov::genai::WhisperDecodedResults ov::genai::WhisperPipeline::generate(const RawS
     return m_impl->generate(raw_speech_input, config, utils::get_streamer_from_map(config_map));
 }
 
+std::vector<ov::genai::WhisperDecodedResults> ov::genai::WhisperPipeline::generate(
+    const std::vector<RawSpeechInput>& raw_speech_inputs,
+    OptionalWhisperGenerationConfig generation_config) {
+    return m_impl->generate(raw_speech_inputs, generation_config);
+}
+
+ov::genai::GenerationHandle ov::genai::WhisperPipeline::add_request(uint64_t request_id,
+                                                                   const RawSpeechInput& raw_speech_input,
+                                                                   OptionalWhisperGenerationConfig generation_config) {
+    return m_impl->add_request(request_id, raw_speech_input, generation_config);
+}
+
+void ov::genai::WhisperPipeline::step() {
+    m_impl->step();
+}
+
+bool ov::genai::WhisperPipeline::has_non_finished_requests() {
+    return m_impl->has_non_finished_requests();
+}
+
+void ov::genai::WhisperPipeline::start_streaming(OptionalWhisperGenerationConfig generation_config,
+                                                 const WhisperStreamingConfig& streaming_config) {
+    m_impl->start_streaming(generation_config, streaming_config);
+}
+
+ov::genai::WhisperStreamingResult ov::genai::WhisperPipeline::put_audio(const RawSpeechInput& audio_chunk) {
+    return m_impl->put_audio(audio_chunk);
+}
+
+ov::genai::WhisperStreamingResult ov::genai::WhisperPipeline::finish_streaming() {
+    return m_impl->finish_streaming();
+}
+
 ov::genai::WhisperGenerationConfig ov::genai::WhisperPipeline::get_generation_config() const {
     return m_impl->m_generation_config;
 }
@@ -16,7 +16,12 @@ from .py_generate_pipeline import (
     DecodedResults,
     EncodedResults,
     GenerationConfig,
+    GenerationFinishReason,
+    GenerationHandle,
+    GenerationOutput,
     GenerationResult,
+    GenerationStatus,
+    ImageEmbeddingCacheStats,
     LLMPipeline, 
     VLMPipeline, 
     PerfMetrics,
@@ -28,6 +33,8 @@ from .py_generate_pipeline import (
     Tokenizer,
     WhisperGenerationConfig,
     WhisperPipeline,
+    WhisperStreamingConfig,
+    WhisperStreamingResult,
     CacheEvictionConfig,
     AggregationMode,
 )
@@ -173,6 +173,28 @@ auto generation_result_docstring = R"(
 
 )";
 
+auto generation_output_docstring = R"(
+    GenerationOutput stores tokens generated for a single sequence of a request.
+
+    Parameters:
+    generated_ids:       generated token ids.
+    generated_log_probs: log probabilities of generated tokens.
+    score:               cumulative score of the sequence.
+    finish_reason:       why generation of the sequence has stopped (NONE, STOP or LENGTH).
+)";
+
+auto generation_handle_docstring = R"(
+    GenerationHandle is returned by add_request and connects a request with its results.
+    Results become available as the pipeline's step() is called.
+
+    get_status: returns current GenerationStatus of the request.
+    can_read: returns True if new tokens are available.
+    drop: stops generation of the request.
+    back: returns the latest GenerationOutput of every sequence.
+    read: returns tokens generated since the previous read.
+    read_all: returns all generated sequences of the request.
+)";
+
 auto stop_criteria_docstring =  R"(
     StopCriteria controls the stopping condition for grouped beam search.
     
@@ -705,6 +727,32 @@ PYBIND11_MODULE(py_generate_pipeline, m) {
             return res;
         });
 
+    py::enum_<ov::genai::GenerationStatus>(m, "GenerationStatus")
+        .value("RUNNING", ov::genai::GenerationStatus::RUNNING)
+        .value("FINISHED", ov::genai::GenerationStatus::FINISHED)
+        .value("IGNORED", ov::genai::GenerationStatus::IGNORED)
+        .value("DROPPED_BY_PIPELINE", ov::genai::GenerationStatus::DROPPED_BY_PIPELINE)
+        .value("DROPPED_BY_HANDLE", ov::genai::GenerationStatus::DROPPED_BY_HANDLE);
+
+    py::enum_<ov::genai::GenerationFinishReason>(m, "GenerationFinishReason")
+        .value("NONE", ov::genai::GenerationFinishReason::NONE)
+        .value("STOP", ov::genai::GenerationFinishReason::STOP)
+        .value("LENGTH", ov::genai::GenerationFinishReason::LENGTH);
+
+    py::class_<ov::genai::GenerationOutput>(m, "GenerationOutput", generation_output_docstring)
+        .def_readonly("generated_ids", &ov::genai::GenerationOutput::generated_ids)
+        .def_readonly("generated_log_probs", &ov::genai::GenerationOutput::generated_log_probs)
+        .def_readonly("score", &ov::genai::GenerationOutput::score)
+        .def_readonly("finish_reason", &ov::genai::GenerationOutput::finish_reason);
+
+    py::class_<ov::genai::GenerationHandleImpl, ov::genai::GenerationHandle>(m, "GenerationHandle", generation_handle_docstring)
+        .def("get_status", &ov::genai::GenerationHandleImpl::get_status)
+        .def("can_read", &ov::genai::GenerationHandleImpl::can_read)
+        .def("drop", &ov::genai::GenerationHandleImpl::drop)
+        .def("back", &ov::genai::GenerationHandleImpl::back)
+        .def("read", &ov::genai::GenerationHandleImpl::read)
+        .def("read_all", &ov::genai::GenerationHandleImpl::read_all);
+
     py::class_<SchedulerConfig>(m, "SchedulerConfig", scheduler_config_docstring)
         .def(py::init<>())
         .def_readwrite("max_num_batched_tokens", &SchedulerConfig::max_num_batched_tokens)
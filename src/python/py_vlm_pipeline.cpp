@@ -100,6 +100,16 @@ py::object call_vlm_generate(
 }
 
 void init_vlm_pipeline(py::module_& m) {
+    py::class_<ov::genai::ImageEmbeddingCacheStats>(m, "ImageEmbeddingCacheStats", "Usage statistics of VLMPipeline's image embedding cache")
+        .def(py::init<>())
+        .def_readonly("hits", &ov::genai::ImageEmbeddingCacheStats::hits)
+        .def_readonly("misses", &ov::genai::ImageEmbeddingCacheStats::misses)
+        .def_readonly("evictions", &ov::genai::ImageEmbeddingCacheStats::evictions)
+        .def_readonly("entries", &ov::genai::ImageEmbeddingCacheStats::entries)
+        .def_readonly("bytes", &ov::genai::ImageEmbeddingCacheStats::bytes)
+        .def_readonly("capacity_bytes", &ov::genai::ImageEmbeddingCacheStats::capacity_bytes)
+        .def("get_hit_rate", &ov::genai::ImageEmbeddingCacheStats::get_hit_rate);
+
     py::class_<ov::genai::VLMPipeline>(m, "VLMPipeline", "This class is used for generation with VLMs")
         .def(py::init([](
             const std::string& model_path, 
@@ -107,7 +117,13 @@ void init_vlm_pipeline(py::module_& m) {
             const std::map<std::string, py::object>& config
         ) {
             ScopedVar env_manager(utils::ov_tokenizers_module_path());
-            return std::make_unique<ov::genai::VLMPipeline>(model_path, device, utils::properties_to_any_map(config));
+            ov::AnyMap device_config = utils::properties_to_any_map(config);
+            auto cache_size = config.find(ov::genai::image_embedding_cache_size.name());
+            if (config.end() != cache_size) {
+                // Python int is converted to int64_t by properties_to_any_map().
+                device_config[ov::genai::image_embedding_cache_size.name()] = py::cast<size_t>(cache_size->second);
+            }
+            return std::make_unique<ov::genai::VLMPipeline>(model_path, device, device_config);
         }),
         py::arg("model_path"), "folder with exported model files", 
         py::arg("device") = "CPU", "device on which inference will be done",
@@ -116,6 +132,10 @@ void init_vlm_pipeline(py::module_& m) {
             VLMPipeline class constructor.
             model_path (str): Path to the folder with exported model files.
             device (str): Device to run the model on (e.g., CPU, GPU). Default is 'CPU'.
+            config (dict): openvino.properties map. image_embedding_cache_size sets a memory budget in bytes for
+                embeddings of previously seen images, 0 (default) disables the cache. image_resize_in_model resizes
+                images with an OpenVINO model on the pipeline's device. scheduler_config (SchedulerConfig) decodes
+                with the paged attention continuous batching engine.
         )")
 
         .def("start_chat", &ov::genai::VLMPipeline::start_chat, py::arg("system_message") = "")
@@ -123,6 +143,8 @@ void init_vlm_pipeline(py::module_& m) {
         .def("get_tokenizer", &ov::genai::VLMPipeline::get_tokenizer)
         .def("get_generation_config", &ov::genai::VLMPipeline::get_generation_config)
         .def("set_generation_config", &ov::genai::VLMPipeline::set_generation_config)
+        .def("get_image_embedding_cache_stats", &ov::genai::VLMPipeline::get_image_embedding_cache_stats)
+        .def("clear_image_embedding_cache", &ov::genai::VLMPipeline::clear_image_embedding_cache)
         .def(
             "generate", 
             [](ov::genai::VLMPipeline& pipe, 
@@ -150,5 +172,21 @@ void init_vlm_pipeline(py::module_& m) {
             },
             py::arg("prompt"), "Input string",
             (vlm_generate_kwargs_docstring + std::string(" \n ")).c_str()
-        );
+        )
+        .def(
+            "add_request",
+            &ov::genai::VLMPipeline::add_request,
+            py::arg("request_id"), "A unique id of the request",
+            py::arg("prompt"), "Input string",
+            py::arg("images"), "Input images, they are copied",
+            py::arg("generation_config"), "generation_config",
+            R"(
+            Adds a request to be decoded together with other requests by step(). The prompt and images are embedded
+            on a background thread. Requires scheduler_config in the constructor config. Chat mode isn't supported.
+            :return: GenerationHandle to read generated tokens as they are produced.
+        )")
+        .def("step", &ov::genai::VLMPipeline::step,
+            "Runs one decoding step for all requests added by add_request() whose prompts are embedded.")
+        .def("has_non_finished_requests", &ov::genai::VLMPipeline::has_non_finished_requests,
+            "Checks if any request added by add_request() is running or still being embedded.");
 }
@@ -21,6 +21,8 @@ using ov::genai::WhisperDecodedResultChunk;
 using ov::genai::WhisperDecodedResults;
 using ov::genai::WhisperGenerationConfig;
 using ov::genai::WhisperPipeline;
+using ov::genai::WhisperStreamingConfig;
+using ov::genai::WhisperStreamingResult;
 
 namespace utils = ov::genai::pybind::utils;
 
@@ -45,6 +47,43 @@ auto whisper_generate_docstring = R"(
     :rtype: DecodedResults
 )";
 
+auto whisper_batched_generate_docstring = R"(
+    Batched generate that transcribes several raw speech inputs together. Windows of all inputs are encoded
+    and decoded in one batch, inputs that are finished earlier leave the batch. If at least one input is longer
+    than 30 seconds, timestamps are predicted for all inputs.
+
+    :param raw_speech_inputs: list of inputs, each in the form of list of floats. Required to be normalized to near [-1, 1] range and have 16k Hz sampling rate.
+    :type raw_speech_inputs: List[List[float]]
+
+    :param generation_config: generation_config
+    :type generation_config: WhisperGenerationConfig or a Dict
+
+    :param kwargs: arbitrary keyword arguments with keys corresponding to WhisperGenerationConfig fields.
+    :type : Dict
+
+    :return: decoded results for each input
+    :rtype: List[WhisperDecodedResults]
+)";
+
+auto whisper_streaming_config_docstring = R"(
+    Parameters of streaming transcription that control the latency/accuracy trade-off.
+
+    min_chunk_seconds: amount of new audio accumulated before the buffered audio is transcribed again,
+                       smaller values decrease latency and increase compute.
+    type: float
+
+    buffer_trimming_seconds: buffered audio is trimmed at the end of the last committed segment when it gets
+                             longer than this value, larger values give more context to the model.
+    type: float
+)";
+
+auto whisper_streaming_result_docstring = R"(
+    Result of a streaming transcription step.
+
+    committed_text: text committed since the previous call, it is final and is not changed by later audio.
+    partial_text:   current hypothesis for the rest of buffered audio, it may change with later audio.
+)";
+
 auto whisper_decoded_results_docstring = R"(
     Structure to store resulting batched text outputs and scores for each batch.
     The first num_return_sequences elements correspond to the first batch element.
@@ -114,6 +153,24 @@ auto whisper_generation_config_docstring = R"(
     
     task: Task to use for generation, either “translate” or “transcribe”
     type: int
+
+    speculative_encoding: In long-form mode encode the next 30 seconds window asynchronously while the current
+                          window is decoded. The result is discarded if timestamps predict a different offset.
+    type: bool
+
+    num_assistant_tokens: Number of tokens proposed by the draft decoder on each step of speculative decoding.
+                          Used only if the pipeline is created with a draft decoder.
+    type: int
+
+    reuse_detected_language: If language is not set, reuse the language detected by the first generate call of
+                             the pipeline in the following calls.
+    type: bool
+
+    skip_silence: Remove silent parts of the input before encoding. Timestamps refer to the original audio.
+    type: bool
+
+    silence_threshold_db: Frames quieter than the loudest frame by more than this value (in dB) are silence.
+    type: float
 )";
 
 OptionalWhisperGenerationConfig update_whisper_config_from_kwargs(const OptionalWhisperGenerationConfig& config,
@@ -170,6 +227,16 @@ OptionalWhisperGenerationConfig update_whisper_config_from_kwargs(const Optional
             res_config.task = py::cast<std::string>(item.second);
         } else if (key == "return_timestamps") {
             res_config.return_timestamps = py::cast<bool>(item.second);
+        } else if (key == "speculative_encoding") {
+            res_config.speculative_encoding = py::cast<bool>(item.second);
+        } else if (key == "num_assistant_tokens") {
+            res_config.num_assistant_tokens = py::cast<size_t>(item.second);
+        } else if (key == "reuse_detected_language") {
+            res_config.reuse_detected_language = py::cast<bool>(item.second);
+        } else if (key == "skip_silence") {
+            res_config.skip_silence = py::cast<bool>(item.second);
+        } else if (key == "silence_threshold_db") {
+            res_config.silence_threshold_db = py::cast<float>(item.second);
         } else if (key == "eos_token_id") {
             res_config.set_eos_token_id(py::cast<int>(item.second));
         } else {
@@ -200,6 +267,17 @@ py::object call_whisper_common_generate(WhisperPipeline& pipe,
     return py::cast(pipe.generate(raw_speech_input, updated_config, streamer));
 }
 
+py::object call_whisper_batched_generate(WhisperPipeline& pipe,
+                                         const std::vector<RawSpeechInput>& raw_speech_inputs,
+                                         const OptionalWhisperGenerationConfig& config,
+                                         const py::kwargs& kwargs) {
+    OptionalWhisperGenerationConfig base_config = config.has_value() ? config : pipe.get_generation_config();
+
+    auto updated_config = update_whisper_config_from_kwargs(base_config, kwargs);
+
+    return py::cast(pipe.generate(raw_speech_inputs, updated_config));
+}
+
 py::str handle_utf8_text(const std::string& text) {
     // pybind11 decodes strings similar to Pythons's
     // bytes.decode('utf-8'). It raises if the decoding fails.
@@ -236,6 +314,11 @@ void init_whisper_pipeline(py::module_& m) {
         .def_readwrite("lang_to_id", &WhisperGenerationConfig::lang_to_id)
         .def_readwrite("task", &WhisperGenerationConfig::task)
         .def_readwrite("return_timestamps", &WhisperGenerationConfig::return_timestamps)
+        .def_readwrite("speculative_encoding", &WhisperGenerationConfig::speculative_encoding)
+        .def_readwrite("num_assistant_tokens", &WhisperGenerationConfig::num_assistant_tokens)
+        .def_readwrite("reuse_detected_language", &WhisperGenerationConfig::reuse_detected_language)
+        .def_readwrite("skip_silence", &WhisperGenerationConfig::skip_silence)
+        .def_readwrite("silence_threshold_db", &WhisperGenerationConfig::silence_threshold_db)
         .def("set_eos_token_id", &WhisperGenerationConfig::set_eos_token_id);
 
     py::class_<WhisperDecodedResultChunk>(m, "WhisperDecodedResultChunk", whisper_decoded_result_chunk)
@@ -249,6 +332,25 @@ void init_whisper_pipeline(py::module_& m) {
     py::class_<WhisperDecodedResults, DecodedResults>(m, "WhisperDecodedResults", whisper_decoded_results_docstring)
         .def_readonly("chunks", &WhisperDecodedResults::chunks);
 
+    py::class_<WhisperStreamingConfig>(m, "WhisperStreamingConfig", whisper_streaming_config_docstring)
+        .def(py::init<>())
+        .def(py::init([](float min_chunk_seconds, float buffer_trimming_seconds) {
+                 return WhisperStreamingConfig{min_chunk_seconds, buffer_trimming_seconds};
+             }),
+             py::arg("min_chunk_seconds"),
+             py::arg("buffer_trimming_seconds") = WhisperStreamingConfig{}.buffer_trimming_seconds)
+        .def_readwrite("min_chunk_seconds", &WhisperStreamingConfig::min_chunk_seconds)
+        .def_readwrite("buffer_trimming_seconds", &WhisperStreamingConfig::buffer_trimming_seconds);
+
+    py::class_<WhisperStreamingResult>(m, "WhisperStreamingResult", whisper_streaming_result_docstring)
+        .def(py::init<>())
+        .def_property_readonly("committed_text", [](WhisperStreamingResult& result) {
+            return handle_utf8_text(result.committed_text);
+        })
+        .def_property_readonly("partial_text", [](WhisperStreamingResult& result) {
+            return handle_utf8_text(result.partial_text);
+        });
+
     py::class_<WhisperPipeline>(m, "WhisperPipeline")
         .def(py::init([](const std::string& model_path,
                          const std::string& device,
@@ -307,6 +409,75 @@ void init_whisper_pipeline(py::module_& m) {
             "streamer",
             (whisper_generate_docstring + std::string(" \n ") + whisper_generation_config_docstring).c_str())
 
+        .def(
+            "generate",
+            [](WhisperPipeline& pipe,
+               const std::vector<RawSpeechInput>& raw_speech_inputs,
+               const OptionalWhisperGenerationConfig& generation_config,
+               const py::kwargs& kwargs) {
+                return call_whisper_batched_generate(pipe, raw_speech_inputs, generation_config, kwargs);
+            },
+            py::arg("raw_speech_inputs"),
+            "List of raw speech inputs, each is a list of floats. "
+            "Required to be normalized to near [-1, 1] range and have 16k Hz sampling rate.",
+            py::arg("generation_config") = std::nullopt,
+            "generation_config",
+            (whisper_batched_generate_docstring + std::string(" \n ") + whisper_generation_config_docstring).c_str())
+
+        .def(
+            "add_request",
+            [](WhisperPipeline& pipe,
+               uint64_t request_id,
+               const RawSpeechInput& raw_speech_input,
+               const OptionalWhisperGenerationConfig& generation_config,
+               const py::kwargs& kwargs) {
+                OptionalWhisperGenerationConfig base_config =
+                    generation_config.has_value() ? generation_config : pipe.get_generation_config();
+                return pipe.add_request(request_id,
+                                        raw_speech_input,
+                                        update_whisper_config_from_kwargs(base_config, kwargs));
+            },
+            py::arg("request_id"),
+            py::arg("raw_speech_input"),
+            py::arg("generation_config") = std::nullopt,
+            R"(
+            Adds a request to the continuous batching engine, its decoding is scheduled together with other
+            requests by step(). Requires scheduler_config in the constructor config. Inputs longer than 30 seconds
+            are not supported.
+            kwargs: arbitrary keyword arguments with keys corresponding to WhisperGenerationConfig fields.
+            :return: GenerationHandle to read generated tokens as they are produced.
+        )")
+        .def("step", &WhisperPipeline::step, "Runs one decoding step for all requests added by add_request().")
+        .def("has_non_finished_requests", &WhisperPipeline::has_non_finished_requests)
+
+        .def(
+            "start_streaming",
+            [](WhisperPipeline& pipe,
+               const OptionalWhisperGenerationConfig& generation_config,
+               const WhisperStreamingConfig& streaming_config,
+               const py::kwargs& kwargs) {
+                OptionalWhisperGenerationConfig base_config =
+                    generation_config.has_value() ? generation_config : pipe.get_generation_config();
+                pipe.start_streaming(update_whisper_config_from_kwargs(base_config, kwargs), streaming_config);
+            },
+            py::arg("generation_config") = std::nullopt,
+            "generation_config",
+            py::arg("streaming_config") = WhisperStreamingConfig{},
+            "streaming_config",
+            R"(
+            Starts streaming transcription session. Audio is passed with put_audio() as it arrives,
+            text is committed when consecutive transcriptions of buffered audio agree on it.
+            kwargs: arbitrary keyword arguments with keys corresponding to WhisperGenerationConfig fields.
+        )")
+        .def("put_audio",
+             &WhisperPipeline::put_audio,
+             py::arg("audio_chunk"),
+             "Appends audio chunk (list of floats with 16k Hz sampling rate) to the streaming session and returns "
+             "newly committed text and current partial text.")
+        .def("finish_streaming",
+             &WhisperPipeline::finish_streaming,
+             "Transcribes the rest of buffered audio, finishes streaming session and returns all not yet committed text.")
+
         .def("get_tokenizer", &WhisperPipeline::get_tokenizer)
         .def("get_generation_config", &WhisperPipeline::get_generation_config, py::return_value_policy::copy)
         .def("set_generation_config", &WhisperPipeline::set_generation_config);
@@ -0,0 +1,419 @@
+// Copyright (C) 2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include "openvino/genai/lora_adapter.hpp"
+#include "openvino/openvino.hpp"
+#include "openvino/op/convert.hpp"
+#include "openvino/op/matmul.hpp"
+#include "openvino/op/multiply.hpp"
+#include "openvino/op/parameter.hpp"
+#include "lora_helper.hpp"
+
+namespace {
+
+constexpr size_t IN_FEATURES = 4;
+constexpr size_t OUT_FEATURES = 3;
+constexpr char LAYER_NAME[] = "linear";
+
+using Matrix = std::vector<float>;  // row-major
+
+// Writes f32 tensors in safetensors format: 8-byte header size, JSON header, raw data
+void write_safetensors(const std::string& path, const std::map<std::string, std::pair<ov::Shape, Matrix>>& tensors) {
+    std::string header = "{";
+    size_t offset = 0;
+    for (const auto& [name, tensor] : tensors) {
+        std::string shape;
+        for (size_t dim : tensor.first) {
+            shape += (shape.empty() ? "" : ",") + std::to_string(dim);
+        }
+        size_t size = tensor.second.size() * sizeof(float);
+        header += (header.size() > 1 ? "," : "") + std::string("\"") + name + "\":{\"dtype\":\"F32\",\"shape\":[" + shape +
+            "],\"data_offsets\":[" + std::to_string(offset) + "," + std::to_string(offset + size) + "]}";
+        offset += size;
+    }
+    header += "}";
+    std::ofstream file(path, std::ios::binary);
+    uint64_t header_size = header.size();
+    file.write(reinterpret_cast<const char*>(&header_size), sizeof(header_size));
+    file.write(header.data(), header.size());
+    for (const auto& [name, tensor] : tensors) {
+        file.write(reinterpret_cast<const char*>(tensor.second.data()), tensor.second.size() * sizeof(float));
+    }
+}
+
+struct LoRAWeights {
+    size_t rank;
+    Matrix A;  // [rank, IN_FEATURES]
+    Matrix B;  // [OUT_FEATURES, rank]
+};
+
+std::string write_adapter(const std::string& file_name, const LoRAWeights& weights) {
+    auto path = (std::filesystem::temp_directory_path() / file_name).string();
+    write_safetensors(path, {
+        {std::string(LAYER_NAME) + ".lora_A.weight", {{weights.rank, IN_FEATURES}, weights.A}},
+        {std::string(LAYER_NAME) + ".lora_B.weight", {{OUT_FEATURES, weights.rank}, weights.B}},
+    });
+    return path;
+}
+
+// y = x * W^T
+std::shared_ptr<ov::Model> make_linear_model(const Matrix& W) {
+    auto input = std::make_shared<ov::op::v0::Parameter>(ov::element::f32, ov::PartialShape{-1, IN_FEATURES});
+    input->get_output_tensor(0).set_names({"input"});
+    auto weights = ov::op::v0::Constant::create(ov::element::f32, ov::Shape{OUT_FEATURES, IN_FEATURES}, W);
+    auto matmul = std::make_shared<ov::op::v0::MatMul>(input, weights, false, true);
+    matmul->set_friendly_name(LAYER_NAME);
+    return std::make_shared<ov::Model>(ov::OutputVector{matmul}, ov::ParameterVector{input});
+}
+
+// y = x * W^T + sum_i alpha_i * (x * A_i^T) * B_i^T for a single row x
+std::vector<float> reference(const Matrix& x, const Matrix& W, const std::vector<LoRAWeights>& adapters, const std::vector<float>& alphas) {
+    std::vector<float> y(OUT_FEATURES, 0.0f);
+    for (size_t o = 0; o < OUT_FEATURES; ++o) {
+        for (size_t i = 0; i < IN_FEATURES; ++i) {
+            y[o] += x[i] * W[o * IN_FEATURES + i];
+        }
+    }
+    for (size_t a = 0; a < adapters.size(); ++a) {
+        const auto& lora = adapters[a];
+        std::vector<float> hidden(lora.rank, 0.0f);
+        for (size_t r = 0; r < lora.rank; ++r) {
+            for (size_t i = 0; i < IN_FEATURES; ++i) {
+                hidden[r] += x[i] * lora.A[r * IN_FEATURES + i];
+            }
+        }
+        for (size_t o = 0; o < OUT_FEATURES; ++o) {
+            for (size_t r = 0; r < lora.rank; ++r) {
+                y[o] += alphas[a] * hidden[r] * lora.B[o * lora.rank + r];
+            }
+        }
+    }
+    return y;
+}
+
+// y = x * W^T where W = Convert(quantized) * scale with one scale per output row,
+// if `with_shared_consumer` is set, the second output is produced by another MatMul that shares the same decompressed weights
+std::shared_ptr<ov::Model> make_compressed_linear_model(ov::element::Type type, const std::vector<int>& quantized, const std::vector<float>& scales, bool with_shared_consumer = false) {
+    auto input = std::make_shared<ov::op::v0::Parameter>(ov::element::f32, ov::PartialShape{-1, IN_FEATURES});
+    input->get_output_tensor(0).set_names({"input"});
+    auto weights = ov::op::v0::Constant::create(type, ov::Shape{OUT_FEATURES, IN_FEATURES}, quantized);
+    auto convert = std::make_shared<ov::op::v0::Convert>(weights, ov::element::f32);
+    auto scale = ov::op::v0::Constant::create(ov::element::f32, ov::Shape{OUT_FEATURES, 1}, scales);
+    auto decompressed = std::make_shared<ov::op::v1::Multiply>(convert, scale);
+    auto matmul = std::make_shared<ov::op::v0::MatMul>(input, decompressed, false, true);
+    matmul->set_friendly_name(LAYER_NAME);
+    ov::OutputVector outputs{matmul};
+    if (with_shared_consumer) {
+        auto other = std::make_shared<ov::op::v0::MatMul>(input, decompressed, false, true);
+        other->set_friendly_name("other");
+        outputs.push_back(other);
+    }
+    return std::make_shared<ov::Model>(outputs, ov::ParameterVector{input});
+}
+
+Matrix dequantize(const std::vector<int>& quantized, const std::vector<float>& scales) {
+    Matrix result(quantized.size());
+    for (size_t i = 0; i < quantized.size(); ++i) {
+        result[i] = quantized[i] * scales[i / IN_FEATURES];
+    }
+    return result;
+}
+
+std::vector<ov::Tensor> infer_fused(std::shared_ptr<ov::Model> model, const ov::genai::Adapter& adapter, const ov::Tensor& input) {
+    ov::genai::AdapterController controller(model, ov::genai::AdapterConfig(adapter, ov::genai::AdapterConfig::MODE_FUSE), "");
+    auto request = ov::Core().compile_model(model, "CPU").create_infer_request();
+    controller.apply(request);
+    request.set_tensor("input", input);
+    request.infer();
+    std::vector<ov::Tensor> outputs;
+    for (size_t i = 0; i < model->outputs().size(); ++i) {
+        ov::Tensor output(request.get_output_tensor(i).get_element_type(), request.get_output_tensor(i).get_shape());
+        request.get_output_tensor(i).copy_to(output);
+        outputs.push_back(output);
+    }
+    return outputs;
+}
+
+ov::Tensor make_input() {
+    ov::Tensor input(ov::element::f32, {2, IN_FEATURES});
+    Matrix values = {1.0f, -0.5f, 0.25f, 2.0f, -1.5f, 0.75f, 1.0f, -0.25f};
+    std::copy(values.begin(), values.end(), input.data<float>());
+    return input;
+}
+
+void expect_near(const ov::Tensor& actual, const ov::Tensor& expected, float tolerance) {
+    ASSERT_EQ(actual.get_shape(), expected.get_shape());
+    for (size_t i = 0; i < actual.get_size(); ++i) {
+        EXPECT_NEAR(actual.data<float>()[i], expected.data<float>()[i], tolerance) << "element " << i;
+    }
+}
+
+const Matrix BASE_WEIGHTS = {
+    0.1f, 0.2f, 0.3f, 0.4f,
+    -0.5f, 0.6f, -0.7f, 0.8f,
+    0.9f, -1.0f, 1.1f, -1.2f
+};
+
+const LoRAWeights FIRST_LORA = {1, {1.0f, 0.0f, -1.0f, 0.5f}, {0.5f, -0.25f, 1.0f}};
+const LoRAWeights SECOND_LORA = {2, {0.0f, 1.0f, 0.0f, -1.0f, 0.5f, 0.5f, 0.5f, 0.5f}, {1.0f, 0.0f, 0.0f, 1.0f, -1.0f, 2.0f}};
+
+}  // namespace
+
+TEST(TestAdapterController, ReturnsNumberOfAdaptersInMultiMode) {
+    ov::genai::Adapter first(write_adapter("lora_multi_count_first.safetensors", FIRST_LORA));
+    ov::genai::Adapter second(write_adapter("lora_multi_count_second.safetensors", SECOND_LORA));
+    auto model = make_linear_model(BASE_WEIGHTS);
+    ov::genai::AdapterController controller(model, ov::genai::AdapterConfig({first, second}, ov::genai::AdapterConfig::MODE_MULTI), "");
+
+    EXPECT_EQ(controller.get_num_adapters(), 2);
+    // A request without adapters still gets a full-size vector of zero alphas
+    EXPECT_EQ(controller.get_alphas(ov::genai::AdapterConfig()), std::vector<float>({0.0f, 0.0f}));
+    EXPECT_EQ(controller.get_alphas(ov::genai::AdapterConfig(second, 0.5f)), std::vector<float>({0.0f, 0.5f}));
+}
+
+TEST(TestAdapterController, AppliesDifferentAdaptersToTokensInOneBatch) {
+    ov::genai::Adapter first(write_adapter("lora_multi_batch_first.safetensors", FIRST_LORA));
+    ov::genai::Adapter second(write_adapter("lora_multi_batch_second.safetensors", SECOND_LORA));
+    auto model = make_linear_model(BASE_WEIGHTS);
+    ov::genai::AdapterController controller(model, ov::genai::AdapterConfig({first, second}, ov::genai::AdapterConfig::MODE_MULTI), "");
+    auto request = ov::Core().compile_model(model, "CPU").create_infer_request();
+    controller.apply(request);
+
+    // Each row is a token of a different request: first adapter, no adapter, second adapter, both adapters with custom alphas
+    std::vector<ov::genai::AdapterConfig> request_configs = {
+        ov::genai::AdapterConfig(first),
+        ov::genai::AdapterConfig(),
+        ov::genai::AdapterConfig(second, 0.5f),
+        ov::genai::AdapterConfig({{first, 2.0f}, {second, -1.0f}}),
+    };
+    const size_t num_tokens = request_configs.size(), num_adapters = controller.get_num_adapters();
+
+    ov::Tensor input(ov::element::f32, {num_tokens, IN_FEATURES});
+    ov::Tensor per_token_alphas(ov::element::f32, {num_tokens, num_adapters});
+    std::vector<std::vector<float>> expected;
+    for (size_t t = 0; t < num_tokens; ++t) {
+        Matrix x = {1.0f + t, -0.5f * t, 0.25f, 2.0f - t};
+        std::copy(x.begin(), x.end(), input.data<float>() + t * IN_FEATURES);
+        auto alphas = controller.get_alphas(request_configs[t]);
+        ASSERT_EQ(alphas.size(), num_adapters);
+        std::copy(alphas.begin(), alphas.end(), per_token_alphas.data<float>() + t * num_adapters);
+        expected.push_back(reference(x, BASE_WEIGHTS, {FIRST_LORA, SECOND_LORA}, alphas));
+    }
+    ov::Tensor active_adapters(ov::element::i64, {num_adapters});
+    std::iota(active_adapters.data<int64_t>(), active_adapters.data<int64_t>() + num_adapters, 0);
+    request.set_tensor("input", input);
+    request.set_tensor(ov::genai::LORA_ACTIVE_ADAPTERS_INPUT_NAME, active_adapters);
+    request.set_tensor(ov::genai::LORA_PER_TOKEN_ALPHAS_INPUT_NAME, per_token_alphas);
+    request.infer();
+
+    auto output = request.get_output_tensor();
+    ASSERT_EQ(output.get_shape(), ov::Shape({num_tokens, OUT_FEATURES}));
+    for (size_t t = 0; t < num_tokens; ++t) {
+        for (size_t o = 0; o < OUT_FEATURES; ++o) {
+            EXPECT_NEAR(output.data<float>()[t * OUT_FEATURES + o], expected[t][o], 1e-4) << "token " << t << ", output " << o;
+        }
+    }
+}
+
+TEST(TestAdapterController, ComputesOnlyActiveAdapters) {
+    ov::genai::Adapter first(write_adapter("lora_multi_active_first.safetensors", FIRST_LORA));
+    ov::genai::Adapter second(write_adapter("lora_multi_active_second.safetensors", SECOND_LORA));
+    auto model = make_linear_model(BASE_WEIGHTS);
+    ov::genai::AdapterController controller(model, ov::genai::AdapterConfig({first, second}, ov::genai::AdapterConfig::MODE_MULTI), "");
+    auto request = ov::Core().compile_model(model, "CPU").create_infer_request();
+    controller.apply(request);
+
+    // Only the second adapter is used in the batch, so per-token alphas have a single column for it
+    std::vector<ov::genai::AdapterConfig> request_configs = {
+        ov::genai::AdapterConfig(second, 0.5f),
+        ov::genai::AdapterConfig(),
+    };
+    const size_t num_tokens = request_configs.size();
+
+    ov::Tensor input(ov::element::f32, {num_tokens, IN_FEATURES});
+    ov::Tensor per_token_alphas(ov::element::f32, {num_tokens, 1});
+    std::vector<std::vector<float>> expected;
+    for (size_t t = 0; t < num_tokens; ++t) {
+        Matrix x = {0.5f - t, 1.0f, -0.25f * t, 1.5f};
+        std::copy(x.begin(), x.end(), input.data<float>() + t * IN_FEATURES);
+        auto alphas = controller.get_alphas(request_configs[t]);
+        per_token_alphas.data<float>()[t] = alphas[1];
+        expected.push_back(reference(x, BASE_WEIGHTS, {FIRST_LORA, SECOND_LORA}, alphas));
+    }
+    ov::Tensor active_adapters(ov::element::i64, {1});
+    active_adapters.data<int64_t>()[0] = 1;
+    request.set_tensor("input", input);
+    request.set_tensor(ov::genai::LORA_ACTIVE_ADAPTERS_INPUT_NAME, active_adapters);
+    request.set_tensor(ov::genai::LORA_PER_TOKEN_ALPHAS_INPUT_NAME, per_token_alphas);
+    request.infer();
+
+    auto output = request.get_output_tensor();
+    ASSERT_EQ(output.get_shape(), ov::Shape({num_tokens, OUT_FEATURES}));
+    for (size_t t = 0; t < num_tokens; ++t) {
+        for (size_t o = 0; o < OUT_FEATURES; ++o) {
+            EXPECT_NEAR(output.data<float>()[t * OUT_FEATURES + o], expected[t][o], 1e-4) << "token " << t << ", output " << o;
+        }
+    }
+}
+
+TEST(TestAdapterController, AppliesAdaptersPreparedInBackground) {
+    ov::genai::Adapter first(write_adapter("lora_prepare_first.safetensors", FIRST_LORA));
+    ov::genai::Adapter second(write_adapter("lora_prepare_second.safetensors", SECOND_LORA));
+    auto model = make_linear_model(BASE_WEIGHTS);
+    ov::genai::AdapterController controller(model, ov::genai::AdapterConfig(first), "");
+    auto request = ov::Core().compile_model(model, "CPU").create_infer_request();
+    controller.apply(request);
+
+    // The second preparation waits for the first one, both results are cached by the controller
+    ov::genai::AdapterConfig both({{first, 0.5f}, {second, 2.0f}});
+    controller.prepare(ov::genai::AdapterConfig(second, 1.5f));
+    controller.prepare(both);
+    controller.apply(request, both);
+
+    Matrix x = {1.0f, -0.5f, 0.25f, 2.0f};
+    ov::Tensor input(ov::element::f32, {1, IN_FEATURES});
+    std::copy(x.begin(), x.end(), input.data<float>());
+    request.set_tensor("input", input);
+    request.infer();
+
+    auto expected = reference(x, BASE_WEIGHTS, {FIRST_LORA, SECOND_LORA}, {0.5f, 2.0f});
+    for (size_t o = 0; o < OUT_FEATURES; ++o) {
+        EXPECT_NEAR(request.get_output_tensor().data<float>()[o], expected[o], 1e-4) << "output " << o;
+    }
+}
+
+TEST(TestLoRAFuse, RequantizedWeightsMatchFloatFuse) {
+    ov::genai::Adapter adapter(write_adapter("lora_fuse_int8.safetensors", FIRST_LORA));
+    std::vector<int> quantized = {10, -20, 30, -40, 127, -128, 0, 64, -5, 5, -100, 100};
+    std::vector<float> scales = {0.01f, 0.02f, 0.015f};
+    auto input = make_input();
+
+    auto expected = infer_fused(make_linear_model(dequantize(quantized, scales)), adapter, input);
+    auto actual = infer_fused(make_compressed_linear_model(ov::element::i8, quantized, scales), adapter, input);
+
+    // int8 requantization of the fused weights introduces an error of at most half of a quantization step per weight
+    expect_near(actual[0], expected[0], 0.05f);
+}
+
+TEST(TestLoRAFuse, UnsignedWeightsWithoutZeroPointKeepNegativeFusedValues) {
+    ov::genai::Adapter adapter(write_adapter("lora_fuse_uint8.safetensors", FIRST_LORA));
+    // Small positive weights become negative after the LoRA delta is added, u8 without zero point cannot hold them
+    std::vector<int> quantized = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12};
+    std::vector<float> scales = {0.01f, 0.01f, 0.01f};
+    auto input = make_input();
+
+    auto expected = infer_fused(make_linear_model(dequantize(quantized, scales)), adapter, input);
+    auto actual = infer_fused(make_compressed_linear_model(ov::element::u8, quantized, scales), adapter, input);
+
+    expect_near(actual[0], expected[0], 1e-4f);
+}
+
+TEST(TestLoRAFuse, DoesNotModifyOtherConsumersOfSharedWeights) {
+    ov::genai::Adapter adapter(write_adapter("lora_fuse_shared.safetensors", FIRST_LORA));
+    std::vector<int> quantized = {10, -20, 30, -40, 127, -128, 0, 64, -5, 5, -100, 100};
+    std::vector<float> scales = {0.01f, 0.02f, 0.015f};
+    auto input = make_input();
+
+    auto base_request = ov::Core().compile_model(make_compressed_linear_model(ov::element::i8, quantized, scales), "CPU").create_infer_request();
+    base_request.set_tensor("input", input);
+    base_request.infer();
+
+    auto fused = infer_fused(make_compressed_linear_model(ov::element::i8, quantized, scales, true), adapter, input);
+
+    // The adapter targets only LAYER_NAME, the other MatMul that reads the same weights keeps the base output
+    expect_near(fused[1], base_request.get_output_tensor(), 1e-5f);
+    auto expected = infer_fused(make_linear_model(dequantize(quantized, scales)), adapter, input);
+    expect_near(fused[0], expected[0], 0.05f);
+}
+
+TEST(TestAdapterRegistry, AdapterFromPathIsPrivateCopy) {
+    auto path = write_adapter("lora_registry_private.safetensors", FIRST_LORA);
+    ov::genai::Adapter first(path), second(path);
+    EXPECT_FALSE(first == second);
+    // Private copies can be registered in one config without being treated as duplicates
+    EXPECT_NO_THROW(ov::genai::AdapterConfig().add(first).add(second));
+
+    auto shared = ov::genai::AdapterRegistry::get(path);
+    EXPECT_FALSE(shared == first);
+}
+
+TEST(TestAdapterRegistry, SharesAdapterLoadedFromTheSameFile) {
+    auto path = write_adapter("lora_registry_shared.safetensors", SECOND_LORA);
+    auto first = ov::genai::AdapterRegistry::get(path);
+    auto second = ov::genai::AdapterRegistry::get((std::filesystem::path(path).parent_path() / "." / "lora_registry_shared.safetensors").string());
+    EXPECT_TRUE(first == second);
+
+    auto preloaded = ov::genai::AdapterRegistry::preload(path);
+    EXPECT_TRUE(preloaded.get() == first);
+
+    auto other = ov::genai::AdapterRegistry::preload(write_adapter("lora_registry_other.safetensors", FIRST_LORA)).get();
+    EXPECT_FALSE(other == first);
+}
+
+TEST(TestAdapterRegistry, PreloadsAdaptersInOneBackgroundThread) {
+#ifndef __linux__
+    GTEST_SKIP() << "Threads of the process are counted with /proc/self/task";
+#else
+    auto count_threads = []() {
+        auto tasks = std::filesystem::directory_iterator("/proc/self/task");
+        return static_cast<size_t>(std::distance(std::filesystem::begin(tasks), std::filesystem::end(tasks)));
+    };
+    std::vector<std::string> paths;
+    for (size_t i = 0; i < 32; ++i) {
+        paths.push_back(write_adapter("lora_registry_preload_" + std::to_string(i) + ".safetensors", i % 2 ? FIRST_LORA : SECOND_LORA));
+    }
+
+    const size_t threads_before = count_threads();
+    size_t max_threads = threads_before;
+    std::vector<std::shared_future<ov::genai::Adapter>> preloaded;
+    for (const auto& path : paths) {
+        preloaded.push_back(ov::genai::AdapterRegistry::preload(path));
+        max_threads = std::max(max_threads, count_threads());
+    }
+    // A repeated preload of a queued file shares its future
+    auto repeated = ov::genai::AdapterRegistry::preload(paths.back());
+    for (size_t i = 0; i < paths.size(); ++i) {
+        EXPECT_TRUE(preloaded[i].get() == ov::genai::AdapterRegistry::get(paths[i]));
+    }
+    EXPECT_TRUE(repeated.get() == preloaded.back().get());
+    EXPECT_LE(max_threads, threads_before + 1);
+#endif
+}
+
+TEST(TestAdapterRegistry, ReportsMemoryInfo) {
+    auto path = write_adapter("lora_registry_memory.safetensors", SECOND_LORA);
+    const size_t expected_bytes = (SECOND_LORA.A.size() + SECOND_LORA.B.size()) * sizeof(float);
+    auto expected_path = std::filesystem::absolute(path).lexically_normal().string();
+
+    ov::genai::Adapter unregistered(path);
+    auto info = ov::genai::AdapterRegistry::get_memory_info(unregistered);
+    EXPECT_EQ(info.path, expected_path);
+    EXPECT_EQ(info.num_tensors, 2);
+    EXPECT_EQ(info.mapped_bytes, expected_bytes);
+
+    auto is_listed = [&expected_path]() {
+        auto infos = ov::genai::AdapterRegistry::get_memory_info();
+        return std::any_of(infos.begin(), infos.end(), [&expected_path](const ov::genai::AdapterMemoryInfo& info) {
+            return info.path == expected_path;
+        });
+    };
+    // Only adapters obtained from the registry are listed, and only while they are alive
+    EXPECT_FALSE(is_listed());
+    {
+        auto registered = ov::genai::AdapterRegistry::get(path);
+        EXPECT_TRUE(is_listed());
+        EXPECT_EQ(ov::genai::AdapterRegistry::get_memory_info(registered).mapped_bytes, expected_bytes);
+    }
+    EXPECT_FALSE(is_listed());
+}
@@ -300,3 +300,39 @@ TEST(SamplerValidationMode, prompt_phase) {
              expected{0, 1, 2, 3};
     ASSERT_EQ(sequence_groups.front()->get_sequences().front()->get_generated_ids(), expected);
 }
+
+namespace {
+// Greedily samples the first token of a prompt of prompt_len tokens whose last logits are last_logits.
+TokenIds sample_after_prompt(const SequenceGroup::Ptr& sequence_group, size_t prompt_len, const std::vector<float>& last_logits) {
+    sequence_group->schedule_tokens(prompt_len);
+    std::vector<float> logits(prompt_len * last_logits.size(), 0.0f);
+    std::copy(last_logits.begin(), last_logits.end(), logits.end() - last_logits.size());
+    ov::Tensor logits_tensor(ov::element::f32, ov::Shape{1, prompt_len, last_logits.size()}, logits.data());
+    std::vector<SequenceGroup::Ptr> sequence_groups{sequence_group};
+    Sampler sampler;
+    sampler.sample(sequence_groups, logits_tensor);
+    return sequence_group->get_sequences().front()->get_generated_ids();
+}
+}  // namespace
+
+TEST(SamplerPromptEmbeds, repetition_penalty_matches_prompt_ids) {
+    auto sampling_config = ov::genai::greedy();
+    sampling_config.repetition_penalty = 2.0f;
+    // Token 2 is the most probable one until it's penalized as a prompt token.
+    std::vector<float> last_logits{1.0f, 0.0f, 1.5f, 0.0f};
+
+    std::vector<int64_t> text_ids{2, 3};
+    ov::Tensor text_tensor(ov::element::i64, ov::Shape{1, text_ids.size()}, text_ids.data());
+    auto text_group = std::make_shared<SequenceGroup>(0, text_tensor, sampling_config, 32, false);
+    TokenIds reference = sample_after_prompt(text_group, text_ids.size(), last_logits);
+    ASSERT_EQ(reference, TokenIds{0});
+
+    // The same text tokens interleaved with rows of image features.
+    std::vector<int64_t> prompt_ids{-1, 2, -1, 3};
+    ov::Tensor prompt_ids_tensor(ov::element::i64, ov::Shape{1, prompt_ids.size()}, prompt_ids.data());
+    ov::Tensor prompt_embeds(ov::element::f32, ov::Shape{1, prompt_ids.size(), 8});
+    auto embeds_group = std::make_shared<SequenceGroup>(1, ov::Tensor{ov::element::i64, {1, 0}}, sampling_config, 32, false);
+    embeds_group->set_prompt_embeds(prompt_embeds, prompt_ids_tensor);
+    EXPECT_EQ(embeds_group->get_prompt_ids(), prompt_ids);
+    EXPECT_EQ(sample_after_prompt(embeds_group, prompt_ids.size(), last_logits), reference);
+}
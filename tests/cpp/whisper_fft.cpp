@@ -0,0 +1,72 @@
+// Copyright (C) 2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <vector>
+
+#include "whisper/fft.hpp"
+
+namespace {
+
+constexpr double PI = 3.14159265358979323846;
+
+// O(n^2) reference computed in double precision
+std::vector<double> naive_power_spectrum(const std::vector<float>& input) {
+    const size_t n = input.size();
+    std::vector<double> result(n / 2 + 1);
+    for (size_t k = 0; k < result.size(); ++k) {
+        std::complex<double> sum = 0;
+        for (size_t t = 0; t < n; ++t) {
+            double angle = -2.0 * PI * static_cast<double>(k * t % n) / n;
+            sum += static_cast<double>(input[t]) * std::complex<double>(std::cos(angle), std::sin(angle));
+        }
+        result[k] = std::norm(sum);
+    }
+    return result;
+}
+
+std::vector<float> make_signal(size_t n) {
+    std::vector<float> signal(n);
+    for (size_t i = 0; i < n; ++i) {
+        // a few tones plus a deterministic pseudo-random component
+        signal[i] = 0.5f * std::sin(0.3f * i) + 0.25f * std::cos(1.7f * i + 0.2f) + static_cast<float>((i * 7919) % 101) / 101.0f - 0.5f;
+    }
+    return signal;
+}
+
+}  // namespace
+
+class RealFFTPlanTest : public testing::TestWithParam<size_t> {};
+
+TEST_P(RealFFTPlanTest, MatchesNaiveDFT) {
+    const size_t n_fft = GetParam();
+    ov::genai::RealFFTPlan plan(n_fft);
+    ASSERT_EQ(plan.get_n_fft(), n_fft);
+    ASSERT_EQ(plan.get_n_bins(), n_fft / 2 + 1);
+
+    auto signal = make_signal(n_fft);
+    auto expected = naive_power_spectrum(signal);
+    std::vector<float> actual(plan.get_n_bins());
+    std::vector<std::complex<float>> work;
+    // the second call reuses the work buffer and should give the same result
+    for (size_t call = 0; call < 2; ++call) {
+        plan.power_spectrum(signal.data(), actual.data(), work);
+        double max_power = *std::max_element(expected.begin(), expected.end());
+        for (size_t k = 0; k < expected.size(); ++k) {
+            EXPECT_NEAR(actual[k], expected[k], 1e-4 * max_power) << "n_fft " << n_fft << ", bin " << k << ", call " << call;
+        }
+    }
+}
+
+// 400 is the Whisper window (packed complex FFT of 200 = 2^3 * 5^2), the rest cover other radix mixes,
+// odd sizes without packing and sizes with generic odd radices
+INSTANTIATE_TEST_SUITE_P(RadixMixes, RealFFTPlanTest,
+                         testing::Values(2, 3, 4, 8, 12, 30, 50, 64, 90, 98, 256, 400, 441, 512, 882, 1024));
+
+TEST(TestRealFFTPlan, ThrowsForTooSmallSize) {
+    EXPECT_THROW(ov::genai::RealFFTPlan(1), ov::Exception);
+}
@@ -11,7 +11,7 @@ from multiprocessing import Process
 
 from openvino_genai import VLMPipeline
 from openvino import Tensor
-from common import get_greedy, get_image_by_link, get_beam_search, get_greedy, get_multinomial_all_parameters
+from common import get_greedy, get_image_by_link, get_beam_search, get_greedy, get_multinomial_all_parameters, get_multinomial_temperature_and_top_p
 
 def get_ov_model(model_dir):
     import sys
@@ -111,3 +111,149 @@ def test_vlm_pipeline(tmp_path):
     gc.collect()
 
 
+
+
+@pytest.mark.precommit
+def test_vlm_image_embedding_cache(tmp_path):
+    model_path = get_ov_model(os.path.join(tmp_path, "miniCPM"))
+    image = get_image_by_link(image_links[0])
+    generation_config = get_greedy()
+
+    reference = VLMPipeline(model_path, "CPU").generate(prompts[0], images=[image], generation_config=generation_config)
+
+    pipe = VLMPipeline(model_path, "CPU", {"image_embedding_cache_size": 1 << 30})
+    first = pipe.generate(prompts[0], images=[image], generation_config=generation_config)
+    second = pipe.generate(prompts[0], images=[image], generation_config=generation_config)
+    assert reference.texts == first.texts == second.texts
+
+    stats = pipe.get_image_embedding_cache_stats()
+    assert stats.misses == 1
+    assert stats.hits == 1
+    assert stats.entries == 1
+    assert 0 < stats.bytes <= stats.capacity_bytes
+
+    pipe.clear_image_embedding_cache()
+    assert pipe.get_image_embedding_cache_stats().bytes == 0
+    del pipe
+    gc.collect()
+
+
+@pytest.mark.precommit
+def test_vlm_image_resize_in_model(tmp_path):
+    model_path = get_ov_model(os.path.join(tmp_path, "miniCPM"))
+    images = [get_image_by_link(image_links[0]), get_image_by_link(image_links[1])]
+
+    pipe = VLMPipeline(model_path, "CPU", {"image_resize_in_model": True})
+    result = pipe.generate(prompts[0], images=images, generation_config=get_greedy())
+    assert result.texts[0]
+    del pipe
+    gc.collect()
+
+
+@pytest.mark.precommit
+def test_vlm_continuous_batching(tmp_path):
+    model_path = get_ov_model(os.path.join(tmp_path, "miniCPM"))
+    generation_config = get_greedy()
+    scheduler_config = openvino_genai.SchedulerConfig()
+    scheduler_config.cache_size = 1
+
+    pipe = VLMPipeline(model_path, "CPU", {"scheduler_config": scheduler_config})
+    for links in image_links_for_testing:
+        images = [get_image_by_link(link) for link in links]
+        result = pipe.generate(prompts[0], images=images, generation_config=generation_config)
+        assert result.texts[0]
+
+    # Two interleaved requests match standalone generate() calls. Expected texts are generated in reverse order, image
+    # ids of a prompt must not depend on images of earlier requests.
+    requests = [
+        (prompts[0], [get_image_by_link(image_links[0]), get_image_by_link(image_links[2])]),
+        (prompts[1], [get_image_by_link(image_links[1])]),
+    ]
+    expected = [
+        pipe.generate(prompt, images=images, generation_config=generation_config).texts[0]
+        for prompt, images in reversed(requests)
+    ][::-1]
+    handles = [pipe.add_request(0, requests[0][0], requests[0][1], generation_config)]
+    for _ in range(3):
+        pipe.step()
+    handles.append(pipe.add_request(1, requests[1][0], requests[1][1], generation_config))
+    while pipe.has_non_finished_requests():
+        pipe.step()
+    tokenizer = pipe.get_tokenizer()
+    for handle, expected_text in zip(handles, expected):
+        assert handle.get_status() == openvino_genai.GenerationStatus.FINISHED
+        outputs = handle.read_all()
+        assert len(outputs) == 1
+        assert tokenizer.decode(outputs[0].generated_ids) == expected_text
+    del pipe
+    gc.collect()
+
+
+def generate_with_separate_embedding(model_path, prompt, max_new_tokens, repetition_penalty):
+    # Greedy decoding with the token embedding model inferred separately and the repetition penalty applied to prompt
+    # and generated tokens, a reference for text only prompts.
+    import json
+    import openvino as ov
+
+    with open(os.path.join(model_path, "config.json")) as config_file:
+        scale_emb = json.load(config_file).get("scale_emb", 1.0)
+    core = ov.Core()
+    embedding = core.compile_model(os.path.join(model_path, "embed_tokens.xml"), "CPU").create_infer_request()
+    language = core.compile_model(os.path.join(model_path, "language_model.xml"), "CPU").create_infer_request()
+    tokenizer = openvino_genai.Tokenizer(model_path)
+    eos_token_id = tokenizer.get_eos_token_id()
+
+    tokens = tokenizer.encode(prompt).input_ids.data[0].tolist()
+    prompt_len = len(tokens)
+    new_ids = list(tokens)
+    generated = []
+    while len(generated) < max_new_tokens:
+        inputs_embeds = embedding.infer([np.array([new_ids], dtype=np.int64)])[0] * scale_emb
+        language.infer({
+            "inputs_embeds": inputs_embeds,
+            "attention_mask": np.ones([1, len(tokens)], dtype=np.int64),
+            "position_ids": np.arange(len(tokens) - len(new_ids), len(tokens), dtype=np.int64)[None],
+            "beam_idx": np.zeros([1], dtype=np.int32),
+        })
+        logits = language.get_tensor("logits").data[0, -1].copy()
+        for token in set(tokens):
+            logits[token] = logits[token] / repetition_penalty if logits[token] >= 0 else logits[token] * repetition_penalty
+        next_token = int(np.argmax(logits))
+        if next_token == eos_token_id:
+            break
+        generated.append(next_token)
+        tokens.append(next_token)
+        new_ids = [next_token]
+    assert len(tokens) == prompt_len + len(generated)
+    return tokenizer.decode(generated)
+
+
+@pytest.mark.precommit
+def test_vlm_repetition_penalty(tmp_path):
+    model_path = get_ov_model(os.path.join(tmp_path, "miniCPM"))
+    generation_config = get_greedy()
+    generation_config.max_new_tokens = 20
+    generation_config.repetition_penalty = 2.0
+    prompt = "Repeat the word apple five times: apple apple"
+
+    expected = generate_with_separate_embedding(model_path, prompt, generation_config.max_new_tokens, generation_config.repetition_penalty)
+
+    pipe = VLMPipeline(model_path, "CPU")
+    assert pipe.generate(prompt, generation_config=generation_config).texts[0] == expected
+    del pipe
+    gc.collect()
+
+
+@pytest.mark.precommit
+def test_vlm_sampling_reproducible(tmp_path):
+    model_path = get_ov_model(os.path.join(tmp_path, "miniCPM"))
+    image = get_image_by_link(image_links[0])
+    generation_config = get_multinomial_temperature_and_top_p()
+    generation_config.rng_seed = 42
+
+    pipe = VLMPipeline(model_path, "CPU")
+    first = pipe.generate(prompts[0], images=[image], generation_config=generation_config)
+    second = pipe.generate(prompts[0], images=[image], generation_config=generation_config)
+    assert first.texts == second.texts
+    del pipe
+    gc.collect()
@@ -11,6 +11,7 @@ import datasets
 from transformers import WhisperProcessor, pipeline, AutoTokenizer
 from optimum.intel.openvino import OVModelForSpeechSeq2Seq
 import json
+import difflib
 import time
 import typing
 
@@ -553,3 +554,160 @@ def test_perf_metrics(model_descr, test_sample):
     assert perf_metrics.get_generate_duration().mean > 0
     assert perf_metrics.get_tokenization_duration().mean == 0
     assert perf_metrics.get_detokenization_duration().mean > 0
+
+
+@pytest.mark.parametrize("model_descr", get_whisper_models_list(tiny_only=True))
+@pytest.mark.parametrize("return_timestamps", [False, True])
+@pytest.mark.precommit
+def test_skip_silence_all_silence(model_descr, return_timestamps):
+    model_id, path, opt_pipe, pipe = read_whisper_model(model_descr)
+
+    silence = [0.0] * 16000 * 5
+
+    genai_result = pipe.generate(
+        silence, skip_silence=True, return_timestamps=return_timestamps
+    )
+
+    assert genai_result.texts[0] == ""
+    assert genai_result.perf_metrics.get_num_generated_tokens() == 0
+    if return_timestamps:
+        assert genai_result.chunks == []
+
+
+@pytest.mark.parametrize("model_descr", get_whisper_models_list(tiny_only=True))
+@pytest.mark.precommit
+def test_batched_generate(model_descr):
+    model_id, path, opt_pipe, pipe = read_whisper_model(model_descr)
+
+    samples = get_samples_from_dataset(language="en", length=3)
+
+    expected = [pipe.generate(sample).texts[0] for sample in samples]
+
+    genai_results = pipe.generate(samples)
+
+    assert len(genai_results) == len(samples)
+    assert [result.texts[0] for result in genai_results] == expected
+
+
+@pytest.mark.parametrize("model_descr", get_whisper_models_list(tiny_only=True))
+@pytest.mark.precommit
+def test_batched_generate_with_longform(model_descr):
+    model_id, path, opt_pipe, pipe = read_whisper_model(model_descr)
+
+    short_sample = get_samples_from_dataset(language="en", length=1)[0]
+    long_sample = get_samples_from_dataset(language="en", length=1, long_form=True)[0]
+
+    # timestamps are enabled for the whole batch when at least one input is long-form
+    expected = [
+        pipe.generate(sample, return_timestamps=True).texts[0]
+        for sample in [short_sample, long_sample]
+    ]
+
+    genai_results = pipe.generate([short_sample, long_sample])
+
+    assert [result.texts[0] for result in genai_results] == expected
+
+
+@pytest.mark.parametrize("model_descr", get_whisper_models_list(tiny_only=True))
+@pytest.mark.precommit
+def test_batched_generate_skip_silence(model_descr):
+    model_id, path, opt_pipe, pipe = read_whisper_model(model_descr)
+
+    sample = get_samples_from_dataset(language="en", length=1)[0]
+    silence = [0.0] * 16000 * 5
+
+    expected = pipe.generate(sample, skip_silence=True).texts[0]
+
+    genai_results = pipe.generate([silence, sample], skip_silence=True)
+
+    assert genai_results[0].texts[0] == ""
+    assert genai_results[1].texts[0] == expected
+
+
+def read_continuous_batching_whisper_model(model_descr):
+    model_id, path, opt_pipe, pipe = read_whisper_model(model_descr)
+    cb_pipe = ov_genai.WhisperPipeline(
+        str(path),
+        device="CPU",
+        config={"ENABLE_MMAP": False, "scheduler_config": ov_genai.SchedulerConfig()},
+    )
+    return pipe, cb_pipe
+
+
+@pytest.mark.parametrize("model_descr", get_whisper_models_list(tiny_only=True))
+@pytest.mark.precommit
+def test_continuous_batching_generate(model_descr):
+    pipe, cb_pipe = read_continuous_batching_whisper_model(model_descr)
+
+    samples = get_samples_from_dataset(language="en", length=2)
+    long_sample = get_samples_from_dataset(language="en", length=1, long_form=True)[0]
+    # long-form input does not fit the continuous batching engine and is transcribed separately
+    inputs = [samples[0], long_sample, samples[1]]
+
+    expected = [pipe.generate(sample).texts[0] for sample in inputs]
+
+    genai_results = cb_pipe.generate(inputs)
+
+    assert [result.texts[0] for result in genai_results] == expected
+
+
+@pytest.mark.parametrize("model_descr", get_whisper_models_list(tiny_only=True))
+@pytest.mark.precommit
+def test_continuous_batching_add_request(model_descr):
+    pipe, cb_pipe = read_continuous_batching_whisper_model(model_descr)
+
+    samples = get_samples_from_dataset(language="en", length=2)
+    expected = [pipe.generate(sample).texts[0] for sample in samples]
+
+    # regular pipeline does not accept requests
+    with pytest.raises(RuntimeError):
+        pipe.add_request(0, samples[0])
+    assert not pipe.has_non_finished_requests()
+
+    handles = [cb_pipe.add_request(request_id, sample) for request_id, sample in enumerate(samples)]
+    while cb_pipe.has_non_finished_requests():
+        cb_pipe.step()
+
+    tokenizer = cb_pipe.get_tokenizer()
+    for handle, expected_text in zip(handles, expected):
+        assert handle.get_status() == ov_genai.GenerationStatus.FINISHED
+        outputs = handle.read_all()
+        assert len(outputs) == 1
+        assert tokenizer.decode(outputs[0].generated_ids).strip() == expected_text.strip()
+
+
+def normalize_text(text: str):
+    return "".join(c for c in text.lower() if c.isalnum() or c.isspace()).split()
+
+
+@pytest.mark.parametrize("model_descr", get_whisper_models_list(tiny_only=True))
+@pytest.mark.parametrize("test_sample", get_samples_from_dataset(language="en", length=1))
+@pytest.mark.precommit
+def test_streaming(model_descr, test_sample):
+    model_id, path, opt_pipe, pipe = read_whisper_model(model_descr)
+
+    expected = pipe.generate(test_sample).texts[0]
+
+    with pytest.raises(RuntimeError):
+        pipe.put_audio(test_sample[:16000])
+
+    pipe.start_streaming(
+        streaming_config=ov_genai.WhisperStreamingConfig(min_chunk_seconds=1.0)
+    )
+    committed = []
+    chunk_size = 16000 // 2
+    for start in range(0, len(test_sample), chunk_size):
+        result = pipe.put_audio(test_sample[start : start + chunk_size])
+        assert isinstance(result, ov_genai.WhisperStreamingResult)
+        committed.append(result.committed_text)
+    committed.append(pipe.finish_streaming().committed_text)
+
+    # the session is closed by finish_streaming
+    with pytest.raises(RuntimeError):
+        pipe.finish_streaming()
+
+    # streaming transcribes growing prefixes of the audio, so words at chunk boundaries may differ
+    streamed_words = normalize_text("".join(committed))
+    expected_words = normalize_text(expected)
+    matcher = difflib.SequenceMatcher(None, streamed_words, expected_words)
+    assert matcher.ratio() > 0.8, f"streamed: {streamed_words}, expected: {expected_words}"